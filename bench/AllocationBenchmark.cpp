@@ -0,0 +1,216 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Allocation benchmark of the per-request memory
+ *
+ * Counts the heap allocations (malloc, calloc, realloc) and measures the time per request of
+ * - serializing responses into a new buffer (GetResponseText) and into the reused output buffer of a connection (SerializeTo),
+ * - parsing the URI of a request with containers on the heap and in a General::Arena that is reset after every request.
+ *
+ * Build and run: make bench && bin/AllocationBenchmark [rounds]
+ */
+
+// Local includes
+#include "Peoplez/General/Arena.hpp"
+#include "Peoplez/Services/Http/HttpRequest.hpp"
+#include "Peoplez/Services/Http/HttpResponse.hpp"
+#include "Peoplez/String/PeoplezString.hpp"
+
+// Extern includes
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+
+using namespace Peoplez;
+using namespace Peoplez::Services::Http;
+using namespace Peoplez::String;
+
+namespace
+{
+	/**
+	 * @brief Number of heap allocations so far (the benchmark is single threaded)
+	 */
+	size_t allocations = 0;
+} // namespace
+
+// Count the allocations of the whole program (glibc; aligned ones are used by operator new of std::pmr::new_delete_resource)
+extern "C"
+{
+	void * __libc_malloc(size_t size);
+	void * __libc_calloc(size_t count, size_t size);
+	void * __libc_realloc(void * ptr, size_t size);
+	void * __libc_memalign(size_t alignment, size_t size);
+
+	void * malloc(size_t const size) noexcept
+	{
+		++allocations;
+		return __libc_malloc(size);
+	}
+
+	void * calloc(size_t const count, size_t const size) noexcept
+	{
+		++allocations;
+		return __libc_calloc(count, size);
+	}
+
+	void * realloc(void * const ptr, size_t const size) noexcept
+	{
+		++allocations;
+		return __libc_realloc(ptr, size);
+	}
+
+	void * aligned_alloc(size_t const alignment, size_t const size) noexcept
+	{
+		++allocations;
+		return __libc_memalign(alignment, size);
+	}
+
+	int posix_memalign(void ** const ptr, size_t const alignment, size_t const size) noexcept
+	{
+		++allocations;
+		*ptr = __libc_memalign(alignment, size);
+
+		return *ptr ? 0 : ENOMEM;
+	}
+}
+
+namespace
+{
+	/**
+	 * Runs one request after the other and prints the allocations and the time per request
+	 *
+	 * @return Sum of the results (keeps the work from being optimized away)
+	 */
+	template<typename F>
+	size_t Measure(char const * const name, unsigned int const rounds, F && request)
+	{
+		size_t result = 0;
+
+		// Warm up (reused buffers reach their size)
+		for(unsigned int i = 0; i < 10; ++i) result += request();
+
+		size_t const before = allocations;
+		std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+		for(unsigned int i = 0; i < rounds; ++i) result += request();
+
+		double const ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+		printf("%-48s %6.2f allocations/request %8.1f ns/request\n", name, (double)(allocations - before) / rounds, ns / rounds);
+
+		return result;
+	}
+
+	/**
+	 * Fills a response like a handler does
+	 *
+	 * @param headers Number of additional header fields
+	 */
+	void FillResponse(HttpResponse & response, PeoplezString const & body, unsigned int const headers)
+	{
+		static PeoplezString const contentType("text/plain", 10), name("Cache-Control", 13), value("no-cache", 8);
+
+		response.Clean();
+		response.SetWithBody(HttpStatusCode::OK, contentType, body, 0x1234ABCDull, HTTP_COMPRESSION_NONE);
+		response.SetLastModified(1600000000);
+
+		for(unsigned int i = 0; i < headers; ++i) response.Headers.Add(name, value);
+	}
+} // namespace
+
+int main(int argc, char ** argv)
+{
+	unsigned int const rounds = argc > 1 ? std::max(atoi(argv[1]), 1) : 100000;
+	size_t result = 0;
+
+	// Responses
+	{
+		PeoplezString small(160);
+		for(unsigned int i = 0; i < 16; ++i) small.Append("0123456789", 10);
+
+		PeoplezString large(100000);
+		for(unsigned int i = 0; i < 10000; ++i) large.Append("0123456789", 10);
+
+		HttpResponse response;
+		PeoplezString output;
+
+		struct Scenario {char const * fresh; char const * reused; PeoplezString const & body; unsigned int headers;};
+		Scenario const scenarios[] = {
+			{"response, small body, new buffer", "response, small body, reused buffer", small, 0},
+			{"response, small body + 3 headers, new buffer", "response, small body + 3 headers, reused buffer", small, 3},
+			{"response, 100 kB body, new buffer", "response, 100 kB body, reused buffer", large, 0}};
+
+		for(Scenario const & scenario : scenarios)
+		{
+			FillResponse(response, scenario.body, scenario.headers);
+
+			result += Measure(scenario.fresh, rounds, [&]() {return response.GetResponseText().Length();});
+			result += Measure(scenario.reused, rounds, [&]()
+			{
+				// Large bodies are sent from the response itself (see HttpResponse::HasSeparateBody)
+				response.SerializeTo(output);
+				return output.Length() + (response.HasSeparateBody() ? response.GetBody().Length() : 0);
+			});
+		}
+	}
+
+	// Request URIs
+	{
+		PeoplezString const uri("/api/v1/users/42/posts?page=2&sort=date&filter=a%20b&limit=20", 61);
+		General::Arena arena;
+
+		auto const parse = [&](std::pmr::memory_resource * const resource)
+		{
+			HttpRequestUri const parsed(uri, HttpMethods::GET, resource);
+
+			return parsed.PathSegments().size() + parsed.QueryParams().size();
+		};
+
+		result += Measure("request URI, containers on the heap", rounds, [&]() {return parse(std::pmr::new_delete_resource());});
+		result += Measure("request URI, containers in the arena", rounds, [&]()
+		{
+			size_t const count = parse(&arena);
+			arena.Reset();
+
+			return count;
+		});
+	}
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
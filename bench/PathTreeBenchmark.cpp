@@ -0,0 +1,140 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Route matching benchmark of General::PathTree
+ *
+ * Builds a tree with 10000 routes (half static, half with a parameter) and measures lookups of
+ * random existing paths, of paths filled into the parameters and of unknown paths.
+ *
+ * Build and run: make bench && bin/PathTreeBenchmark [rounds]
+ */
+
+// Local includes
+#include "Peoplez/General/PathTree.hpp"
+#include "Peoplez/String/PeoplezString.hpp"
+
+// Extern includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Peoplez;
+using namespace Peoplez::String;
+
+/**
+ * @def ROUTE_COUNT
+ * @brief Number of routes in the tree
+ */
+#define ROUTE_COUNT 10000
+
+namespace
+{
+	typedef std::vector<PeoplezString> Path;
+
+	Path Split(std::string const & path)
+	{
+		Path segments;
+		PeoplezString(path.data(), path.length()).Split<true>(segments, '/');
+
+		return segments;
+	}
+
+	/**
+	 * Looks up all paths for several rounds and prints the time per lookup
+	 *
+	 * @return Number of found targets (keeps the lookups from being optimized away)
+	 */
+	template<typename F>
+	size_t Measure(char const * const name, std::vector<Path> const & paths, unsigned int const rounds, F && lookup)
+	{
+		size_t found = 0;
+		std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+		for(unsigned int r = 0; r < rounds; ++r)
+		{
+			for(Path const & path : paths) found += lookup(path);
+		}
+
+		double const ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+		printf("%-32s %8.1f ns/lookup (%zu of %zu found)\n", name, ns / ((double) rounds * paths.size()), found / rounds, paths.size());
+
+		return found;
+	}
+} // namespace
+
+int main(int argc, char ** argv)
+{
+	unsigned int const rounds = argc > 1 ? std::max(atoi(argv[1]), 1) : 50;
+
+	General::PathTree<int> tree;
+	std::vector<Path> statics, parameters, unknown;
+	std::mt19937 random(1);
+
+	// REST like API: 20 services x 5 versions x 100 resources, collections (static) and items (parameter)
+	for(int i = 0; i < ROUTE_COUNT; ++i)
+	{
+		std::string const base = "/api" + std::to_string(i % 20) + "/v" + std::to_string(i / 20 % 5) + "/resource" + std::to_string(i / 100);
+		std::string const field = std::to_string(i % 7);
+		Path const route = Split(i % 2 ? base + "/:id/field" + field : base + "/list" + field);
+
+		if(!tree.InsertTarget(route.begin(), route.end(), std::make_shared<int>(i))) continue;
+
+		if(i % 2) parameters.push_back(Split(base + "/" + std::to_string(random() % 100000) + "/field" + field));
+		else statics.push_back(route);
+
+		unknown.push_back(Split(base + "/missing" + field));
+	}
+
+	std::shuffle(statics.begin(), statics.end(), random);
+	std::shuffle(parameters.begin(), parameters.end(), random);
+	std::shuffle(unknown.begin(), unknown.end(), random);
+
+	General::PathTree<int>::Captures captures;
+	size_t found = 0;
+
+	found += Measure("static, GetTarget (locked)", statics, rounds, [&](Path const & path) {return (bool) tree.GetTarget(path.begin(), path.end());});
+	found += Measure("static, FindTarget", statics, rounds, [&](Path const & path) {return tree.FindTarget(path.begin(), path.end()) != nullptr;});
+	found += Measure("parameter, FindTarget + captures", parameters, rounds, [&](Path const & path) {return tree.FindTarget(path.begin(), path.end(), captures) != nullptr;});
+	found += Measure("unknown, FindTarget", unknown, rounds, [&](Path const & path) {return tree.FindTarget(path.begin(), path.end()) != nullptr;});
+
+	return found ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "Arena.hpp"
+
+// External includes
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace Peoplez
+{
+	namespace General
+	{
+		/**
+		 * Rounds a pointer up to the given alignment (power of two)
+		 */
+		static inline char * AlignUp(char * const ptr, size_t const alignment) noexcept
+		{
+			return reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(ptr) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+		}
+
+		Arena::Arena() noexcept : blocks(nullptr), current(nullptr), position(inlineBlock), end(inlineBlock + ARENA_INLINE_SIZE) {}
+
+		void Arena::Reset() noexcept
+		{
+			// Keep the first blocks for the next unit, free the rest
+			size_t retained = 0;
+
+			for(Block ** link = &blocks; *link;)
+			{
+				if(retained + (*link)->size > ARENA_RETAINED_SIZE)
+				{
+					Block * const block = *link;
+					*link = block->next;
+					::operator delete(block);
+				}
+				else
+				{
+					retained += (*link)->size;
+					link = &(*link)->next;
+				}
+			}
+
+			current = nullptr;
+			position = inlineBlock;
+			end = inlineBlock + ARENA_INLINE_SIZE;
+		}
+
+		Arena::~Arena()
+		{
+			while(blocks)
+			{
+				Block * const next = blocks->next;
+				::operator delete(blocks);
+				blocks = next;
+			}
+		}
+
+		void * Arena::do_allocate(size_t const bytes, size_t const alignment)
+		{
+			char * result = AlignUp(position, alignment);
+
+			if(result > end || bytes > (size_t)(end - result))
+			{
+				NextBlock(bytes, alignment);
+				result = AlignUp(position, alignment);
+			}
+
+			position = result + bytes;
+
+			return result;
+		}
+
+		void Arena::NextBlock(size_t const bytes, size_t const alignment)
+		{
+			size_t const needed = bytes + alignment;
+
+			// Reuse a retained block (blocks that are too small stay unused until Reset)
+			Block * block = current ? current->next : blocks;
+			while(block && block->size < needed) block = block->next;
+
+			if(!block)
+			{
+				// Blocks grow geometrically, so large units need only a few of them
+				size_t const size = std::max(needed, (current ? current->size : (size_t)ARENA_INLINE_SIZE) * 2);
+
+				block = static_cast<Block *>(::operator new(sizeof(Block) + size));
+				block->size = size;
+
+				// Insert behind the current block (the following blocks stay available)
+				Block ** const link = current ? &current->next : &blocks;
+				block->next = *link;
+				*link = block;
+			}
+
+			current = block;
+			position = reinterpret_cast<char *>(block + 1);
+			end = position + block->size;
+		}
+	} // namespace General
+} // namespace Peoplez
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_GENERAL_ARENA_HPP_
+#define PEOPLEZ_GENERAL_ARENA_HPP_
+
+// External includes
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @def ARENA_INLINE_SIZE
+ * @brief Size of the block inside every arena in bytes (used without any heap allocation)
+ */
+#ifndef ARENA_INLINE_SIZE
+#define ARENA_INLINE_SIZE 4096
+#endif
+/**
+ * @def ARENA_RETAINED_SIZE
+ * @brief Number of heap allocated bytes an arena keeps for reuse after Reset; larger blocks are freed
+ */
+#ifndef ARENA_RETAINED_SIZE
+#define ARENA_RETAINED_SIZE 65536
+#endif
+
+namespace Peoplez
+{
+	namespace General
+	{
+		/**
+		 * @brief Monotonic memory resource whose memory is released all at once
+		 *
+		 * @details
+		 * Allocations only move a pointer forward; deallocations are ignored. Reset makes the whole memory available
+		 * again, so containers (std::pmr) that are rebuilt for every unit of work (e.g. a request) do not touch the heap
+		 * once the arena has grown to their size. Blocks beyond ARENA_RETAINED_SIZE are freed by Reset, so a single large
+		 * unit does not keep its memory.
+		 *
+		 * Not thread safe. Everything allocated from the arena has to be destroyed (or no longer used) before Reset.
+		 */
+		class Arena final : public std::pmr::memory_resource
+		{
+		public:
+			/**
+			 * Constructor
+			 */
+			Arena() noexcept;
+			/**
+			 * Releases everything that was allocated since the last Reset
+			 */
+			void Reset() noexcept;
+			/**
+			 * Destructor
+			 */
+			~Arena();
+
+		private:
+			/**
+			 * @brief Heap allocated block (followed by its memory)
+			 */
+			struct Block
+			{
+				Block * next;
+				size_t size;
+			};
+
+			Arena(Arena const & other) = delete;
+			Arena & operator=(Arena const & other) = delete;
+
+			void * do_allocate(size_t bytes, size_t alignment) override;
+			void do_deallocate(void *, size_t, size_t) noexcept override {}
+			bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override {return this == &other;}
+
+			/**
+			 * Moves on to the next block that can hold the allocation (allocates a block if none is left)
+			 */
+			void NextBlock(size_t bytes, size_t alignment);
+
+			/**
+			 * @brief Heap allocated blocks (in use order)
+			 */
+			Block * blocks;
+			/**
+			 * @brief Block that is used at the moment; nullptr while the inline block is used
+			 */
+			Block * current;
+			char * position;
+			char * end;
+			alignas(std::max_align_t) char inlineBlock[ARENA_INLINE_SIZE];
+		};
+	} // namespace General
+} // namespace Peoplez
+
+#endif // PEOPLEZ_GENERAL_ARENA_HPP_
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_GENERAL_ASYNCRESULT_HPP_
+#define PEOPLEZ_GENERAL_ASYNCRESULT_HPP_
+
+// Local includes
+#include "Scheduler.hpp"
+
+// External includes
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace Peoplez
+{
+	namespace General
+	{
+		/**
+		 * @brief Result that is provided later by another thread (e.g. by the client of a backend) and awaited by a coroutine
+		 *
+		 * @details
+		 * Copies share the result: the producer keeps a copy and calls Set once, the consumer awaits another one (once).
+		 * The awaiting coroutine is continued by the Scheduler it suspended in (in the thread that calls Set if there is none);
+		 * if the result is set already it continues immediately.
+		 */
+		template<typename T>
+		class AsyncResult final
+		{
+		private:
+			/**
+			 * @brief Shared state of the copies
+			 */
+			struct State final
+			{
+				std::mutex mut;
+				std::optional<T> value;
+				std::exception_ptr exception;
+				std::coroutine_handle<> waiting;
+				/**
+				 * @brief Scheduler that continues the waiting coroutine
+				 */
+				Scheduler * scheduler = nullptr;
+				bool ready = false;
+			};
+
+		public:
+			/**
+			 * Constructor (creates an empty result)
+			 */
+			AsyncResult() : state(std::make_shared<State>()) {}
+
+			/**
+			 * Provides the result and continues the awaiting coroutine
+			 *
+			 * Only the first call of Set or SetException has an effect
+			 *
+			 * @param value Result
+			 */
+			void Set(T value)
+			{
+				std::unique_lock<std::mutex> lock(state->mut);
+				if(state->ready) return;
+
+				state->value.emplace(std::move(value));
+				Finish(lock);
+			}
+			/**
+			 * Provides an error that is thrown to the awaiting coroutine
+			 *
+			 * @param exception Error
+			 */
+			void SetException(std::exception_ptr exception)
+			{
+				std::unique_lock<std::mutex> lock(state->mut);
+				if(state->ready) return;
+
+				state->exception = std::move(exception);
+				Finish(lock);
+			}
+
+			bool await_ready() const noexcept
+			{
+				std::unique_lock<std::mutex> const lock(state->mut);
+				return state->ready;
+			}
+			bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+			{
+				std::unique_lock<std::mutex> const lock(state->mut);
+
+				// If the result arrived meanwhile ... do not suspend
+				if(state->ready) return false;
+
+				state->waiting = awaiting;
+				state->scheduler = Scheduler::Current();
+				return true;
+			}
+			T await_resume()
+			{
+				if(state->exception) std::rethrow_exception(state->exception);
+				return std::move(*state->value);
+			}
+
+		private:
+			/**
+			 * Marks the result as ready and continues the waiting coroutine (outside of the lock)
+			 */
+			void Finish(std::unique_lock<std::mutex> & lock)
+			{
+				state->ready = true;
+				std::coroutine_handle<> const waiting = std::exchange(state->waiting, {});
+
+				lock.unlock();
+				if(waiting) Scheduler::Resume(state->scheduler, waiting);
+			}
+
+			std::shared_ptr<State> state;
+		};
+	} // namespace General
+} // namespace Peoplez
+
+#endif // PEOPLEZ_GENERAL_ASYNCRESULT_HPP_
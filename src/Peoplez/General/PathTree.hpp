@@ -40,113 +40,150 @@
 #include "../String/PeoplezString.hpp"
 
 // External includes
-#include <thread>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <shared_mutex>
 #include <mutex>
 #include <memory>
-#include <unordered_map>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace Peoplez
 {
 	namespace General
 	{
+		/**
+		 * @brief Tree assigning targets to paths given as sequences of segments (e.g. {"users", ":id", "posts"})
+		 * @details Compacted radix tree over segments: chains of static segments share one edge. Modifications work on
+		 * linked nodes, lookups on a compiled copy in breadth-first order, in which the children of a node are adjacent
+		 * and the tags (length and content) of their first segments lie in one array that is compared for several
+		 * children at once.
+		 *
+		 * Segments of inserted paths starting with ':' are parameters (match any one segment), a last segment starting
+		 * with '*' is a catch-all (matches the remaining zero or more segments). The text after ':' or '*' is the name
+		 * of the capture. Static segments win over parameters and parameters over catch-alls; on a dead end the
+		 * lookup falls back to the next alternative.
+		 */
 		template<typename T>
 		class PathTree final
 		{
-		private:
-			class Node final
-			{
-				friend class PathTree<T>;
-
-			public:
-				Node() {}
-				template<typename I>
-				std::shared_ptr<T> const & GetTarget(I & __restrict__ now, I & __restrict__ end)
-				{
-					if(now == end) return target;
-					else
-					{
-						typename std::unordered_map<String::PeoplezString, std::unique_ptr<Node> >::const_iterator const iter = childs.find(*now);
-
-						if(iter == childs.end()) return NOT_FOUND;
-						else
-						{
-							++now;
-							return iter->second->GetTarget(now, end);
-						}
-					}
-				}
-
-				template<typename I>
-				void InsertTarget(I & __restrict__ now, I & __restrict__ end, std::shared_ptr<T> & __restrict__ tar)
-				{
-					if(now == end)
-					{
-						if(target.get() == 0) target = tar;
-						// else throw exception
-					}
-					else
-					{
-						std::unique_ptr<Node> & child = childs[*now];
-
-						if(child.get() == 0) child.reset(new Node());
-
-						++now;
-
-						child->InsertTarget(now, end, tar);
-					}
-				}
+		public:
+			/**
+			 * @brief Maximum number of parameters and catch-alls per path
+			 */
+			static constexpr size_t MAX_CAPTURES = 8;
 
-				bool IsEmpty() noexcept
-				{
-					return target.get() == 0 && childs.empty();
-				}
+			/**
+			 * @brief Segments of a looked up path matched by a parameter or catch-all
+			 */
+			struct Capture final
+			{
+				/**
+				 * @brief Name of the parameter (without ':' or '*'); owned by the tree
+				 */
+				String::PeoplezString const * Name;
+				/**
+				 * @brief Index of the first matched segment
+				 */
+				size_t First;
+				/**
+				 * @brief Number of matched segments (1 for parameters)
+				 */
+				size_t Count;
+			};
 
-				template<typename I>
-				void RemoveTarget(I & __restrict__ now, I & __restrict__ end)
-				{
-					if(now == end) target = NOT_FOUND;
-					else
-					{
-						typename std::unordered_map<String::PeoplezString, std::unique_ptr<Node> >::const_iterator const iter = childs.find(*now);
+			/**
+			 * @brief Captures of a lookup (fixed capacity, so lookups don't allocate)
+			 */
+			struct Captures final
+			{
+				std::array<Capture, MAX_CAPTURES> Entries;
+				size_t Count = 0;
+			};
 
-						if(iter != childs.end())
-						{
-							iter->second->RemoveTarget(++now, end);
+		private:
+			/**
+			 * @brief Index of no node
+			 */
+			static constexpr uint32_t NONE = UINT32_MAX;
+			/**
+			 * @brief Maximum number of static children that are compared linearly (more are searched binary)
+			 */
+			static constexpr size_t LINEAR_CHILDREN = 16;
 
-							if(iter->second->IsEmpty()) childs.erase(iter);
-						}
-					}
-				}
-			private:
-				static std::shared_ptr<T> const NOT_FOUND;
+			/**
+			 * @brief Node for modifications
+			 */
+			struct Node final
+			{
+				/**
+				 * @brief Static segments of the edge to this node (empty for parameter and catch-all nodes)
+				 */
+				std::vector<String::PeoplezString> segments;
+				/**
+				 * @brief Tags of the first segments of the static children (sorted)
+				 */
+				std::vector<uint64_t> tags;
+				/**
+				 * @brief Indices of the static children (same order as tags)
+				 */
+				std::vector<uint32_t> children;
+				uint32_t parameter = NONE;
+				uint32_t catchAll = NONE;
+				/**
+				 * @brief Name of the capture for parameter and catch-all nodes
+				 */
+				String::PeoplezString name;
+				std::shared_ptr<T> target;
 
-				Node(Node const & other) : target(other.target)
+				bool IsEmpty() const noexcept
 				{
-					for(typename std::unordered_map<String::PeoplezString, std::unique_ptr<Node> >::const_iterator iter = childs.begin(); iter != childs.end(); ++iter)
-					{
-						childs.insert(std::pair<String::PeoplezString, std::unique_ptr<Node> >(iter->first->UniqueCopy(), std::unique_ptr<Node>(new Node(*(iter->second->get())))));
-					}
+					return !target && children.empty() && parameter == NONE && catchAll == NONE;
 				}
-				Node(Node const && other) = delete;
-				Node & operator= (Node const &) = delete;
-				Node & operator= (Node const &&) = delete;
+			};
 
-				std::unordered_map<String::PeoplezString, std::unique_ptr<Node> > childs;
-				std::shared_ptr<T> target = NOT_FOUND;
+			/**
+			 * @brief Node for lookups (see Compile)
+			 */
+			struct CompiledNode final
+			{
+				/**
+				 * @brief Index of the first static child (the others follow directly)
+				 */
+				uint32_t firstChild;
+				uint32_t childCount;
+				/**
+				 * @brief Index of the first edge segment in segmentTags and segments
+				 */
+				uint32_t firstSegment;
+				uint32_t segmentCount;
+				uint32_t parameter;
+				uint32_t catchAll;
+				/**
+				 * @brief Index of the node in nodes
+				 */
+				uint32_t source;
+				T * target;
 			};
+
 		public:
-			PathTree() {}
+			PathTree() : nodes(1)
+			{
+				Compile();
+			}
 			/**
 			 * Copy constructor
+			 *
+			 * Targets are shared with the original
 			 */
-			PathTree(PathTree const & other) : child(other.child) {}
-			/**
-			 * Move constructor
-			 */
-			PathTree(PathTree && other)
+			PathTree(PathTree const & other) : nodes(other.nodes), freeNodes(other.freeNodes)
 			{
-				std::swap(child, other.child);
+				Compile();
 			}
 
 			virtual ~PathTree() {}
@@ -160,38 +197,89 @@ namespace Peoplez
 			 */
 			PathTree & operator=(PathTree const & rhs)
 			{
-				child = rhs.child;
+				if(this != &rhs)
+				{
+					std::unique_lock<std::shared_timed_mutex> lock(mut);
+
+					nodes = rhs.nodes;
+					freeNodes = rhs.freeNodes;
+					Compile();
+				}
 
 				return *this;
 			}
+
 			/**
-			 * Move assignment operator
+			 * Getter for target object of an url
 			 *
-			 * @param rhs Right hand side of assignment
+			 * @param iter Iterator to the first path object (like container.begin())
+			 * @param end Iterator to the end of the path (like container.end())
 			 *
-			 * @return Reference to *this
+			 * @return Shared pointer to searched target; empty if no such target exists
 			 */
-			PathTree & operator=(PathTree const && rhs)
+			template<typename I>
+			std::shared_ptr<T> GetTarget(I iter, I end)
 			{
-				std::swap(child, rhs.child);
+				std::shared_lock<std::shared_timed_mutex> lock(mut);
 
-				return *this;
+				uint32_t const index = Find(0, iter, end, 0, nullptr);
+
+				return index == NONE ? std::shared_ptr<T>() : nodes[compiled[index].source].target;
+			}
+			/**
+			 * Getter for target object of an url without locking
+			 *
+			 * Only for trees that are not modified concurrently (e.g. immutable snapshots, see RcuPointer). Never allocates.
+			 *
+			 * @param iter Iterator to the first path object (like container.begin())
+			 * @param end Iterator to the end of the path (like container.end())
+			 *
+			 * @return Pointer to the searched target; nullptr if no such target exists
+			 */
+			template<typename I>
+			T * FindTarget(I iter, I end) const
+			{
+				uint32_t const index = Find(0, iter, end, 0, nullptr);
+
+				return index == NONE ? nullptr : compiled[index].target;
 			}
+			/**
+			 * Getter for target object of an url and the segments matched by parameters without locking
+			 *
+			 * Same as FindTarget(iter, end)
+			 *
+			 * @param iter Iterator to the first path object (like container.begin())
+			 * @param end Iterator to the end of the path (like container.end())
+			 * @param captures Receives the captures in path order (valid until the tree is modified)
+			 *
+			 * @return Pointer to the searched target; nullptr if no such target exists
+			 */
+			template<typename I>
+			T * FindTarget(I iter, I end, Captures & captures) const
+			{
+				captures.Count = 0;
+
+				uint32_t const index = Find(0, iter, end, 0, &captures);
 
+				return index == NONE ? nullptr : compiled[index].target;
+			}
 			/**
-			 * Getter for target object of an url
+			 * Getter for the target that was inserted with a path
+			 *
+			 * Unlike GetTarget the path is given like for InsertTarget (parameters are compared by position, not by name).
 			 *
 			 * @param iter Iterator to the first path object (like container.begin())
 			 * @param end Iterator to the end of the path (like container.end())
 			 *
-			 * @return Shared pointer to searched target or Node::NOT_FOUND if no such target exists
+			 * @return Shared pointer to the target; empty if the path has none
 			 */
 			template<typename I>
-			std::shared_ptr<T> GetTarget(I iter, I end)
+			std::shared_ptr<T> GetInsertedTarget(I iter, I end)
 			{
 				std::shared_lock<std::shared_timed_mutex> lock(mut);
+				std::vector<uint32_t> path;
 
-				return child.GetTarget(iter, end);
+				return FindInserted(iter, end, path) ? nodes[path.back()].target : std::shared_ptr<T>();
 			}
 			/**
 			 * Adds a new target at a specific path in the path tree
@@ -199,13 +287,97 @@ namespace Peoplez
 			 * @param iter Iterator to the first path object (like container.begin())
 			 * @param end Iterator to the end of the path (like container.end())
 			 * @param target Target to add to the path tree
+			 * @param replace Indicates whether an existing target of the path is replaced
+			 *
+			 * @return False if the path already has a target (and replace is false), a catch-all is not the last segment, there are more than
+			 * MAX_CAPTURES captures or a parameter has another name than one at the same position (the tree is not changed then); true otherwise
 			 */
 			template<typename I>
-			void InsertTarget(I iter, I end, std::shared_ptr<T> target)
+			bool InsertTarget(I iter, I end, std::shared_ptr<T> target, bool replace = false)
 			{
 				std::unique_lock<std::shared_timed_mutex> lock(mut);
 
-				child.InsertTarget(iter, end, target);
+				// Check the patterns before anything is changed
+				size_t captures = 0;
+
+				for(I check = iter; check != end; ++check)
+				{
+					if(IsPattern(*check) && (++captures > MAX_CAPTURES || ((*check)[0] == '*' && std::next(check) != end))) return false;
+				}
+
+				uint32_t index = 0;
+
+				while(iter != end)
+				{
+					String::PeoplezString const & segment = *iter;
+
+					if(IsPattern(segment))
+					{
+						bool const isCatchAll = segment[0] == '*';
+						String::PeoplezString const name(segment.GetData() + 1, segment.Length() - 1);
+						uint32_t child = isCatchAll ? nodes[index].catchAll : nodes[index].parameter;
+
+						if(child == NONE)
+						{
+							child = NewNode();
+							nodes[child].name = name;
+							(isCatchAll ? nodes[index].catchAll : nodes[index].parameter) = child;
+						}
+						else if(nodes[child].name != name) return false;
+
+						index = child;
+						++iter;
+					}
+					else
+					{
+						size_t const pos = FindChild(nodes[index], segment);
+
+						if(pos == NONE)
+						{
+							// New edge with all static segments up to the next pattern
+							uint32_t const child = NewNode();
+
+							for(; iter != end && !IsPattern(*iter); ++iter) nodes[child].segments.push_back(*iter);
+
+							AddChild(index, child);
+							index = child;
+						}
+						else
+						{
+							uint32_t const child = nodes[index].children[pos];
+							size_t matched = 1;
+
+							for(++iter; iter != end && matched < nodes[child].segments.size() && nodes[child].segments[matched] == *iter; ++iter) ++matched;
+
+							// Diverges inside the edge ... split it
+							if(matched < nodes[child].segments.size())
+							{
+								uint32_t const middle = NewNode();
+								std::vector<String::PeoplezString> & segments = nodes[child].segments;
+
+								nodes[middle].segments.assign(segments.begin(), segments.begin() + matched);
+								segments.erase(segments.begin(), segments.begin() + matched);
+
+								nodes[index].children[pos] = middle;
+								AddChild(middle, child);
+								index = middle;
+							}
+							else index = child;
+						}
+					}
+				}
+
+				if(nodes[index].target && !replace)
+				{
+					// Splits are kept (they don't change the paths)
+					Compile();
+					return false;
+				}
+
+				nodes[index].target = target;
+				Compile();
+
+				return true;
 			}
 			/**
 			 * Indicates whether the path tree is empty
@@ -216,11 +388,13 @@ namespace Peoplez
 			{
 				std::shared_lock<std::shared_timed_mutex> lock(mut);
 
-				return child.IsEmpty();
+				return nodes[0].IsEmpty();
 			}
 			/**
 			 * Removes the target at a specific path in the path tree
 			 *
+			 * The path is given like for InsertTarget (parameters are compared by position, not by name).
+			 *
 			 * @param iter Iterator to the first path object (like container.begin())
 			 * @param end Iterator to the end of the path (like container.end())
 			 */
@@ -229,16 +403,401 @@ namespace Peoplez
 			{
 				std::unique_lock<std::shared_timed_mutex> lock(mut);
 
-				child.RemoveTarget(iter, end);
+				// Nodes on the path (for removing the ones that become empty)
+				std::vector<uint32_t> path;
+
+				if(!FindInserted(iter, end, path)) return;
+
+				nodes[path.back()].target.reset();
+
+				// Remove empty nodes
+				while(path.size() > 1 && nodes[path.back()].IsEmpty())
+				{
+					uint32_t const child = path.back();
+					path.pop_back();
+					Node & parent = nodes[path.back()];
+
+					if(parent.parameter == child) parent.parameter = NONE;
+					else if(parent.catchAll == child) parent.catchAll = NONE;
+					else
+					{
+						size_t const pos = std::find(parent.children.begin(), parent.children.end(), child) - parent.children.begin();
+
+						parent.tags.erase(parent.tags.begin() + pos);
+						parent.children.erase(parent.children.begin() + pos);
+					}
+
+					FreeNode(child);
+				}
+
+				// Keep edges compacted: a static node with nothing but one static child absorbs it
+				uint32_t const index = path.back();
+				Node & node = nodes[index];
+
+				if(index && !node.segments.empty() && !node.target && node.parameter == NONE && node.catchAll == NONE && node.children.size() == 1)
+				{
+					uint32_t const child = node.children[0];
+					Node & absorbed = nodes[child];
+
+					node.segments.insert(node.segments.end(), absorbed.segments.begin(), absorbed.segments.end());
+					node.tags.swap(absorbed.tags);
+					node.children.swap(absorbed.children);
+					node.parameter = absorbed.parameter;
+					node.catchAll = absorbed.catchAll;
+					node.target.swap(absorbed.target);
+
+					FreeNode(child);
+				}
+
+				Compile();
 			}
 
 		private:
+			/**
+			 * Indicates whether a segment of an inserted path is a parameter or catch-all
+			 */
+			static bool IsPattern(String::PeoplezString const & segment) noexcept
+			{
+				return !segment.IsEmpty() && (segment[0] == ':' || segment[0] == '*');
+			}
+			/**
+			 * Calculates the tag of a segment (length in the highest byte)
+			 *
+			 * Segments with at most 7 bytes are stored as they are below the length (equal if and only if their tags are equal).
+			 * Longer ones get a hash of their first and last 8 bytes (they often only differ at the end, e.g. numbered names).
+			 */
+			static uint64_t Tag(String::PeoplezString const & segment) noexcept
+			{
+				size_t const length = segment.Length();
+				char const * const data = segment.GetData();
+				uint64_t tag = 0;
+
+				if(length <= 7)
+				{
+					for(size_t i = 0; i < length; ++i) tag |= (uint64_t)(unsigned char) data[i] << (8 * i);
+				}
+				else
+				{
+					uint64_t first, last;
+					memcpy(&first, data, 8);
+					memcpy(&last, data + length - 8, 8);
+
+					tag = (first * 0x9E3779B97F4A7C15ULL) ^ (last * 0xC2B2AE3D27D4EB4FULL);
+					tag ^= tag >> 29;
+				}
+
+				return (tag & 0x00FFFFFFFFFFFFFFULL) | ((uint64_t) std::min<size_t>(length, 255) << 56);
+			}
+			/**
+			 * Searches the first occurrence of a tag in sorted tags
+			 *
+			 * @return Position of the tag; NONE if it is not contained
+			 */
+			static size_t SearchTag(uint64_t const * const tags, size_t const count, uint64_t const tag) noexcept
+			{
+				if(count > LINEAR_CHILDREN)
+				{
+					uint64_t const * const found = std::lower_bound(tags, tags + count, tag);
+
+					return found != tags + count && *found == tag ? found - tags : NONE;
+				}
+
+#ifdef __SSE2__
+				// Two tags per comparison; a tag matches if both of its 32 bit halves do
+				__m128i const key = _mm_set1_epi64x(tag);
+				size_t i = 0;
+
+				for(; i + 2 <= count; i += 2)
+				{
+					int const mask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((__m128i const *)(tags + i)), key));
+
+					if((mask & 0xFF) == 0xFF) return i;
+					if((mask & 0xFF00) == 0xFF00) return i + 1;
+				}
+
+				return i < count && tags[i] == tag ? i : NONE;
+#else
+				for(size_t i = 0; i < count; ++i)
+				{
+					if(tags[i] == tag) return i;
+				}
+
+				return NONE;
+#endif
+			}
+			/**
+			 * Searches the static child whose edge starts with a segment (for modifications)
+			 *
+			 * @return Position in children; NONE if there is no such child
+			 */
+			size_t FindChild(Node const & node, String::PeoplezString const & segment) const noexcept
+			{
+				uint64_t const tag = Tag(segment);
+				size_t pos = SearchTag(node.tags.data(), node.tags.size(), tag);
+
+				// Tags are only unique for short segments (equal ones are adjacent)
+				if(pos != NONE && segment.Length() > 7)
+				{
+					for(; pos < node.tags.size() && node.tags[pos] == tag; ++pos)
+					{
+						if(nodes[node.children[pos]].segments[0] == segment) return pos;
+					}
+
+					return NONE;
+				}
+
+				return pos;
+			}
+			/**
+			 * Searches the node of an inserted path (see InsertTarget)
+			 *
+			 * @param iter Iterator to the first path object
+			 * @param end Iterator to the end of the path
+			 * @param path Receives the indices of the nodes on the path (starting with the root)
+			 *
+			 * @return Indicates whether the node exists
+			 */
+			template<typename I>
+			bool FindInserted(I iter, I const end, std::vector<uint32_t> & path) const
+			{
+				path.assign(1, 0);
+
+				while(iter != end)
+				{
+					Node const & node = nodes[path.back()];
+					String::PeoplezString const & segment = *iter;
+					uint32_t child;
+
+					if(IsPattern(segment))
+					{
+						child = segment[0] == '*' ? node.catchAll : node.parameter;
+						++iter;
+					}
+					else
+					{
+						size_t const pos = FindChild(node, segment);
+
+						if(pos == NONE) return false;
+
+						child = node.children[pos];
+
+						for(size_t i = 0; i < nodes[child].segments.size(); ++i, ++iter)
+						{
+							if(iter == end || nodes[child].segments[i] != *iter) return false;
+						}
+					}
+
+					if(child == NONE) return false;
+
+					path.push_back(child);
+				}
+
+				return true;
+			}
+			/**
+			 * Searches the compiled node of a path (recursively with fallback to the next alternative)
+			 *
+			 * @param index Compiled node to start at
+			 * @param iter Iterator to the first remaining path object
+			 * @param end Iterator to the end of the path
+			 * @param pos Index of the first remaining path object (for the captures)
+			 * @param captures Captures to add to; nullptr if not needed
+			 *
+			 * @return Index of the compiled node with the target; NONE if there is none
+			 */
+			template<typename I>
+			uint32_t Find(uint32_t const index, I iter, I const end, size_t const pos, Captures * const captures) const
+			{
+				CompiledNode const & node = compiled[index];
+
+				if(iter == end)
+				{
+					if(node.target) return index;
+					if(node.catchAll == NONE || !compiled[node.catchAll].target) return NONE;
+
+					if(captures) captures->Entries[captures->Count++] = Capture{&nodes[compiled[node.catchAll].source].name, pos, 0};
+
+					return node.catchAll;
+				}
+
+				// Captures of failed alternatives are dropped
+				size_t const count = captures ? captures->Count : 0;
+
+				// Static child
+				if(node.childCount)
+				{
+					String::PeoplezString const & segment = *iter;
+					uint64_t const tag = Tag(segment);
+					uint64_t const * const tags = childTags.data() + node.firstChild;
+					size_t childPos = SearchTag(tags, node.childCount, tag);
+
+					// Tags are only unique for short segments (equal ones are adjacent)
+					if(childPos != NONE && segment.Length() > 7)
+					{
+						while(childPos < node.childCount && tags[childPos] == tag && segments[compiled[node.firstChild + childPos].firstSegment] != segment) ++childPos;
+						if(childPos == node.childCount || tags[childPos] != tag) childPos = NONE;
+					}
+
+					if(childPos != NONE)
+					{
+						uint32_t const child = node.firstChild + childPos;
+						CompiledNode const & edge = compiled[child];
+						I next = iter;
+						size_t i = 1;
+
+						for(++next; i < edge.segmentCount && next != end; ++i, ++next)
+						{
+							uint32_t const segmentIndex = edge.firstSegment + i;
+
+							if(segmentTags[segmentIndex] != Tag(*next) || (next->Length() > 7 && segments[segmentIndex] != *next)) break;
+						}
+
+						if(i == edge.segmentCount)
+						{
+							uint32_t const result = Find(child, next, end, pos + i, captures);
+
+							if(result != NONE) return result;
+							if(captures) captures->Count = count;
+						}
+					}
+				}
+
+				// Parameter
+				if(node.parameter != NONE)
+				{
+					if(captures) captures->Entries[captures->Count++] = Capture{&nodes[compiled[node.parameter].source].name, pos, 1};
+
+					I next = iter;
+					uint32_t const result = Find(node.parameter, ++next, end, pos + 1, captures);
+
+					if(result != NONE) return result;
+					if(captures) captures->Count = count;
+				}
+
+				// Catch-all
+				if(node.catchAll != NONE && compiled[node.catchAll].target)
+				{
+					if(captures) captures->Entries[captures->Count++] = Capture{&nodes[compiled[node.catchAll].source].name, pos, (size_t) std::distance(iter, end)};
+
+					return node.catchAll;
+				}
+
+				return NONE;
+			}
+			/**
+			 * Rebuilds the compiled nodes from the nodes (breadth-first, so the children of every node are adjacent)
+			 */
+			void Compile()
+			{
+				compiled.clear();
+				childTags.clear();
+				segmentTags.clear();
+				segments.clear();
+
+				compiled.push_back(CompiledNode{NONE, 0, 0, 0, NONE, NONE, 0, nodes[0].target.get()});
+				childTags.push_back(0);
+
+				// The compiled nodes are the queue
+				for(size_t i = 0; i < compiled.size(); ++i)
+				{
+					Node const & node = nodes[compiled[i].source];
+
+					compiled[i].firstChild = compiled.size();
+					compiled[i].childCount = node.children.size();
+
+					for(size_t c = 0; c < node.children.size(); ++c)
+					{
+						AddCompiled(node.children[c]);
+						childTags.push_back(node.tags[c]);
+					}
+
+					if(node.parameter != NONE)
+					{
+						compiled[i].parameter = compiled.size();
+						AddCompiled(node.parameter);
+						childTags.push_back(0);
+					}
+
+					if(node.catchAll != NONE)
+					{
+						compiled[i].catchAll = compiled.size();
+						AddCompiled(node.catchAll);
+						childTags.push_back(0);
+					}
+				}
+			}
+			/**
+			 * Appends the compiled node of a node (children are added by Compile)
+			 */
+			void AddCompiled(uint32_t const index)
+			{
+				Node const & node = nodes[index];
+
+				compiled.push_back(CompiledNode{NONE, 0, (uint32_t) segments.size(), (uint32_t) node.segments.size(), NONE, NONE, index, node.target.get()});
+
+				for(String::PeoplezString const & segment : node.segments)
+				{
+					segmentTags.push_back(Tag(segment));
+					segments.push_back(segment);
+				}
+			}
+			uint32_t NewNode()
+			{
+				if(freeNodes.empty())
+				{
+					nodes.emplace_back();
+					return nodes.size() - 1;
+				}
+
+				uint32_t const index = freeNodes.back();
+				freeNodes.pop_back();
+
+				return index;
+			}
+			void FreeNode(uint32_t const index)
+			{
+				nodes[index] = Node();
+				freeNodes.push_back(index);
+			}
+			/**
+			 * Adds a static child (sorted by the tag of its first segment)
+			 */
+			void AddChild(uint32_t const parent, uint32_t const child)
+			{
+				uint64_t const tag = Tag(nodes[child].segments[0]);
+				Node & node = nodes[parent];
+				size_t const pos = std::upper_bound(node.tags.begin(), node.tags.end(), tag) - node.tags.begin();
+
+				node.tags.insert(node.tags.begin() + pos, tag);
+				node.children.insert(node.children.begin() + pos, child);
+			}
+
 			std::shared_timed_mutex mut;
-			Node child;
+			/**
+			 * @brief Nodes for modifications (root at index 0)
+			 */
+			std::vector<Node> nodes;
+			/**
+			 * @brief Unused entries of nodes
+			 */
+			std::vector<uint32_t> freeNodes;
+			/**
+			 * @brief Nodes for lookups (root at index 0)
+			 */
+			std::vector<CompiledNode> compiled;
+			/**
+			 * @brief Tag of the first edge segment per compiled node (0 for the root, parameters and catch-alls)
+			 */
+			std::vector<uint64_t> childTags;
+			/**
+			 * @brief Tags of the edge segments of all compiled nodes
+			 */
+			std::vector<uint64_t> segmentTags;
+			/**
+			 * @brief Edge segments of all compiled nodes
+			 */
+			std::vector<String::PeoplezString> segments;
 		};
-
-		template<typename T>
-		std::shared_ptr<T> const PathTree<T>::Node::NOT_FOUND = std::shared_ptr<T>((T *) 0);
 	} // namespace General
 } // namespace Peoplez
 
@@ -0,0 +1,250 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_GENERAL_RCUPOINTER_HPP_
+#define PEOPLEZ_GENERAL_RCUPOINTER_HPP_
+
+// External includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Peoplez
+{
+	namespace General
+	{
+		/**
+		 * @brief Pointer to an immutable object that is replaced as a whole (read-copy-update)
+		 * @details Readers never lock: they register in a counter slot of their thread and load the pointer.
+		 * Writers copy the current object, modify the copy, publish it with an atomic exchange and delete
+		 * the old object as soon as all readers that might still see it have left.
+		 */
+		template<typename T>
+		class RcuPointer final
+		{
+		private:
+			/**
+			 * @brief Number of reader counter slots (threads are distributed over them)
+			 */
+			static constexpr size_t SLOT_COUNT = 32;
+
+			/**
+			 * @brief Reader counters of the two phases (own cache line)
+			 */
+			struct alignas(64) Slot final
+			{
+				std::atomic<int64_t> readers[2] = {0, 0};
+			};
+
+		public:
+			/**
+			 * @brief Read access to the current object
+			 * @details The object stays valid until the guard is destroyed. Keep the guard as short as possible; writers wait for it.
+			 */
+			class ReadGuard final
+			{
+			public:
+				/**
+				 * Constructor
+				 *
+				 * @param owner Pointer to read
+				 */
+				explicit ReadGuard(RcuPointer const & owner) noexcept : slot(owner.slots[ThreadSlot()]), phase(owner.epoch.load(std::memory_order_relaxed) & 1)
+				{
+					// Registering has to precede loading the pointer (see Synchronize)
+					slot.readers[phase].fetch_add(1, std::memory_order_seq_cst);
+					value = owner.current.load(std::memory_order_seq_cst);
+					++readDepth;
+				}
+				ReadGuard(ReadGuard const &) = delete;
+				ReadGuard & operator=(ReadGuard const &) = delete;
+				~ReadGuard()
+				{
+					--readDepth;
+					slot.readers[phase].fetch_sub(1, std::memory_order_release);
+				}
+
+				/**
+				 * Getter for the object
+				 *
+				 * @return Object that was current when the guard was created
+				 */
+				inline T const & operator*() const noexcept {return *value;}
+				inline T const * operator->() const noexcept {return value;}
+
+			private:
+				Slot & slot;
+				unsigned int const phase;
+				T const * value;
+			};
+
+			/**
+			 * Constructor
+			 *
+			 * @param initial First object (is taken over)
+			 */
+			explicit RcuPointer(T * initial = new T()) : current(initial), epoch(0) {}
+			RcuPointer(RcuPointer const &) = delete;
+			RcuPointer & operator=(RcuPointer const &) = delete;
+			/**
+			 * Destructor
+			 *
+			 * No reader may be active anymore
+			 */
+			~RcuPointer()
+			{
+				for(T * old : retired) delete old;
+				delete current.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * Starts read access to the current object
+			 *
+			 * Never locks. Nested reads of the same thread are allowed.
+			 *
+			 * @return Guard holding the current object
+			 */
+			inline ReadGuard Read() const noexcept {return ReadGuard(*this);}
+			/**
+			 * Replaces the object by a modified copy
+			 *
+			 * Updates are serialized. The old object is deleted after all readers that might use it have left.
+			 * Called while the thread reads any RcuPointer of this type, the deletion is postponed to a later update.
+			 *
+			 * @param modify Function modifying the copy (T & as parameter); returns false to discard the copy
+			 *
+			 * @return Indicates whether the copy was published
+			 */
+			template<typename F>
+			bool Update(F && modify)
+			{
+				std::unique_lock<std::mutex> lock(writerMutex);
+
+				T * const next = new T(*current.load(std::memory_order_relaxed));
+
+				try
+				{
+					// If the modification failed (maybe halfway) ... the current object stays
+					if(!modify(*next))
+					{
+						delete next;
+						return false;
+					}
+				}
+				catch(...)
+				{
+					delete next;
+					throw;
+				}
+
+				retired.push_back(current.exchange(next, std::memory_order_seq_cst));
+
+				// The readers of this thread would never leave while waiting
+				if(readDepth) return true;
+
+				Synchronize();
+
+				for(T * old : retired) delete old;
+				retired.clear();
+
+				return true;
+			}
+
+		private:
+			/**
+			 * Getter for the counter slot of the calling thread
+			 *
+			 * @return Index of the slot
+			 */
+			static unsigned int ThreadSlot() noexcept
+			{
+				static std::atomic<unsigned int> nextSlot(0);
+				static thread_local unsigned int const slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % SLOT_COUNT;
+
+				return slot;
+			}
+			/**
+			 * Waits until all readers that started before the call have left
+			 *
+			 * A reader registers in the phase it read before loading the pointer. Waiting for both phases
+			 * one after the other (switching the phase of new readers before each) covers every reader
+			 * that loaded a retired object, while new readers can't delay the end forever.
+			 */
+			void Synchronize() noexcept
+			{
+				for(unsigned int i = 0; i < 2; ++i)
+				{
+					unsigned int const phase = epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+
+					for(Slot & slot : slots)
+					{
+						while(slot.readers[phase].load(std::memory_order_seq_cst)) std::this_thread::yield();
+					}
+				}
+			}
+
+			/**
+			 * @brief Number of read guards of the calling thread
+			 */
+			static inline thread_local unsigned int readDepth = 0;
+
+			/**
+			 * @brief Current object
+			 */
+			std::atomic<T *> current;
+			/**
+			 * @brief Phase new readers register in (lowest bit)
+			 */
+			std::atomic<unsigned int> epoch;
+			/**
+			 * @brief Reader counters
+			 */
+			mutable std::array<Slot, SLOT_COUNT> slots;
+			/**
+			 * @brief Replaced objects that still have to be deleted
+			 */
+			std::vector<T *> retired;
+			/**
+			 * @brief Serializes updates
+			 */
+			std::mutex writerMutex;
+		};
+	} // namespace General
+} // namespace Peoplez
+
+#endif // PEOPLEZ_GENERAL_RCUPOINTER_HPP_
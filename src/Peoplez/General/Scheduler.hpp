@@ -0,0 +1,102 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PEOPLEZ_GENERAL_SCHEDULER_HPP_
+#define PEOPLEZ_GENERAL_SCHEDULER_HPP_
+
+// External includes
+#include <coroutine>
+#include <functional>
+
+namespace Peoplez
+{
+	namespace General
+	{
+		/**
+		 * @brief Thread pool that continues suspended coroutines
+		 *
+		 * @details
+		 * Worker threads register their pool as current one (e.g. System::IO::Network::ConnectionsManager). Awaitables
+		 * remember the current scheduler when they suspend and continue the coroutine through it, so the thread that
+		 * provides a result (a backend client, the delay queue, ...) never runs request code itself.
+		 */
+		class Scheduler
+		{
+		public:
+			/**
+			 * Calls a function in one of the threads of the pool (soon)
+			 *
+			 * Can be called from any thread.
+			 *
+			 * @param target Function to call
+			 */
+			virtual void Post(std::function<void()> target) noexcept = 0;
+
+			/**
+			 * Getter for the scheduler of the calling thread
+			 *
+			 * @return nullptr if the calling thread belongs to no pool
+			 */
+			static Scheduler * Current() noexcept {return current;}
+			/**
+			 * Continues a suspended coroutine through a scheduler
+			 *
+			 * @param scheduler Scheduler that was current when the coroutine suspended; nullptr to continue it in the calling thread
+			 * @param handle Coroutine to continue
+			 */
+			static void Resume(Scheduler * const scheduler, std::coroutine_handle<> const handle) noexcept
+			{
+				if(scheduler) scheduler->Post([handle]() {handle.resume();});
+				else handle.resume();
+			}
+
+			virtual ~Scheduler() {}
+
+		protected:
+			/**
+			 * Sets the scheduler of the calling thread (called by the threads of the pool)
+			 *
+			 * @param scheduler Pool of the thread; nullptr when the thread leaves it
+			 */
+			static void SetCurrent(Scheduler * const scheduler) noexcept {current = scheduler;}
+
+		private:
+			static inline thread_local Scheduler * current = nullptr;
+		};
+	} // namespace General
+} // namespace Peoplez
+
+#endif // PEOPLEZ_GENERAL_SCHEDULER_HPP_
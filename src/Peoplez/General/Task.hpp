@@ -0,0 +1,193 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_GENERAL_TASK_HPP_
+#define PEOPLEZ_GENERAL_TASK_HPP_
+
+// External includes
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace Peoplez
+{
+	namespace General
+	{
+		template<typename T>
+		class Task;
+
+		/**
+		 * @brief Parts of the promise of a Task that do not depend on the result type
+		 */
+		class TaskPromiseBase
+		{
+		public:
+			/**
+			 * @brief Continues the awaiting coroutine when the task ends
+			 */
+			struct FinalAwaiter final
+			{
+				bool await_ready() const noexcept {return false;}
+				template<typename P>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+				{
+					std::coroutine_handle<> const continuation = handle.promise().continuation;
+					return continuation ? continuation : std::noop_coroutine();
+				}
+				void await_resume() const noexcept {}
+			};
+
+			std::suspend_always initial_suspend() const noexcept {return {};}
+			FinalAwaiter final_suspend() const noexcept {return {};}
+			void unhandled_exception() noexcept {exception = std::current_exception();}
+
+			/**
+			 * @brief Coroutine that awaits the task
+			 */
+			std::coroutine_handle<> continuation;
+			/**
+			 * @brief Exception that left the task (rethrown to the awaiting coroutine)
+			 */
+			std::exception_ptr exception;
+		};
+
+		/**
+		 * @brief Promise of a Task with result
+		 */
+		template<typename T>
+		class TaskPromise final : public TaskPromiseBase
+		{
+		public:
+			Task<T> get_return_object() noexcept;
+			void return_value(T value) {result.emplace(std::move(value));}
+
+			/**
+			 * Gets the result (or rethrows the exception) of the task
+			 */
+			T Result()
+			{
+				if(exception) std::rethrow_exception(exception);
+				return std::move(*result);
+			}
+
+		private:
+			std::optional<T> result;
+		};
+
+		/**
+		 * @brief Promise of a Task without result
+		 */
+		template<>
+		class TaskPromise<void> final : public TaskPromiseBase
+		{
+		public:
+			Task<void> get_return_object() noexcept;
+			void return_void() const noexcept {}
+
+			/**
+			 * Rethrows the exception of the task (if any)
+			 */
+			void Result() const
+			{
+				if(exception) std::rethrow_exception(exception);
+			}
+		};
+
+		/**
+		 * @brief Coroutine that is started when it is awaited
+		 *
+		 * @details
+		 * The awaiting coroutine is continued in the thread that finishes the task (symmetric transfer, no stack growth).
+		 * Threads are never blocked: a task that waits for something (e.g. an AsyncResult) is suspended
+		 * and resumed through the Scheduler it suspended in as soon as that is provided.
+		 */
+		template<typename T = void>
+		class [[nodiscard]] Task final
+		{
+		public:
+			using promise_type = TaskPromise<T>;
+
+			Task(Task && other) noexcept : handle(std::exchange(other.handle, {})) {}
+			Task & operator=(Task && other) noexcept
+			{
+				if(this != &other)
+				{
+					if(handle) handle.destroy();
+					handle = std::exchange(other.handle, {});
+				}
+
+				return *this;
+			}
+			~Task()
+			{
+				if(handle) handle.destroy();
+			}
+
+			bool await_ready() const noexcept {return !handle || handle.done();}
+			/**
+			 * Starts the task; the awaiting coroutine is continued when it ends
+			 */
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+			{
+				handle.promise().continuation = awaiting;
+				return handle;
+			}
+			T await_resume() {return handle.promise().Result();}
+
+		private:
+			friend class TaskPromise<T>;
+
+			Task(Task const & other) = delete;
+			Task & operator=(Task const & other) = delete;
+			explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+
+			std::coroutine_handle<promise_type> handle;
+		};
+
+		template<typename T>
+		inline Task<T> TaskPromise<T>::get_return_object() noexcept
+		{
+			return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+		}
+
+		inline Task<void> TaskPromise<void>::get_return_object() noexcept
+		{
+			return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+		}
+	} // namespace General
+} // namespace Peoplez
+
+#endif // PEOPLEZ_GENERAL_TASK_HPP_
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "ChunkedDecoder.hpp"
+
+/**
+ * @def MAX_CHUNK_META_LENGTH
+ * @brief Maximum accepted length of chunk extensions and trailers in bytes
+ */
+#define MAX_CHUNK_META_LENGTH 4096
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			size_t ChunkedDecoder::Parse(char const * const data, size_t const len) noexcept
+			{
+				size_t pos = 0;
+
+				for(; pos < len && state != State::DATA && state != State::DONE && state != State::FAILED; ++pos)
+				{
+					char const c = data[pos];
+
+					switch(state)
+					{
+					case State::SIZE:
+						{
+							unsigned int digit;
+
+							if(c >= '0' && c <= '9') digit = c - '0';
+							else if(c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+							else if(c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+							else
+							{
+								// Size has to have at least one digit
+								if(!sizeDigits) state = State::FAILED;
+								else if(c == ';' || c == ' ' || c == '\t') state = State::EXTENSION;
+								else if(c == '\r') state = State::SIZE_LF;
+								else state = State::FAILED;
+								break;
+							}
+
+							// Prevent overflow
+							if(++sizeDigits > 16) state = State::FAILED;
+							else remaining = (remaining << 4) | digit;
+						}
+						break;
+					case State::EXTENSION:
+						// Extensions are ignored
+						if(c == '\r') state = State::SIZE_LF;
+						else if(++lineLength > MAX_CHUNK_META_LENGTH) state = State::FAILED;
+						break;
+					case State::SIZE_LF:
+						sizeDigits = 0;
+
+						if(c != '\n') state = State::FAILED;
+						else state = remaining ? State::DATA : State::TRAILER;
+						break;
+					case State::DATA_CR:
+						state = c == '\r' ? State::DATA_LF : State::FAILED;
+						break;
+					case State::DATA_LF:
+						state = c == '\n' ? State::SIZE : State::FAILED;
+						break;
+					case State::TRAILER:
+						// Empty line ends the body, trailer fields are ignored
+						if(c == '\r') state = State::TRAILER_LF;
+						else if(++lineLength > MAX_CHUNK_META_LENGTH) state = State::FAILED;
+						else state = State::TRAILER_LINE;
+						break;
+					case State::TRAILER_LINE:
+						if(c == '\r') state = State::TRAILER_LINE_LF;
+						else if(++lineLength > MAX_CHUNK_META_LENGTH) state = State::FAILED;
+						break;
+					case State::TRAILER_LINE_LF:
+						state = c == '\n' ? State::TRAILER : State::FAILED;
+						break;
+					case State::TRAILER_LF:
+						state = c == '\n' ? State::DONE : State::FAILED;
+						break;
+					default:
+						break;
+					}
+				}
+
+				return pos;
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
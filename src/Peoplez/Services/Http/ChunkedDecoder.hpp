@@ -0,0 +1,137 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_CHUNKEDDECODER_HPP_
+#define PEOPLEZ_SERVICES_HTTP_CHUNKEDDECODER_HPP_
+
+// Extern includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Incremental decoder for the chunked transfer coding (RFC 7230 Section 4.1)
+			 *
+			 * @details
+			 * The decoder does not copy any data. Parse consumes the chunk framing (sizes, extensions, trailers)
+			 * and stops in front of chunk data. The caller takes up to Available bytes of data from its input and reports them with Consume.
+			 */
+			class ChunkedDecoder final
+			{
+			public:
+				/**
+				 * Constructor
+				 */
+				ChunkedDecoder() noexcept : remaining(0), lineLength(0), state(State::SIZE), sizeDigits(0) {}
+				/**
+				 * Consumes chunk framing at the beginning of the input
+				 *
+				 * Stops in front of chunk data, at the end of the input or at the end of the body
+				 *
+				 * @param data Input
+				 * @param len Length of the input
+				 *
+				 * @return Number of consumed bytes
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				size_t Parse(char const * data, size_t len) noexcept;
+				/**
+				 * Number of data bytes at the beginning of the input (after Parse)
+				 *
+				 * @param len Length of the input
+				 *
+				 * @return Number of data bytes that can be consumed
+				 */
+				inline size_t Available(size_t const len) const noexcept {return state == State::DATA ? std::min<uint64_t>(remaining, len) : 0;}
+				/**
+				 * Marks data bytes as consumed
+				 *
+				 * @param len Number of consumed data bytes (at most Available)
+				 */
+				inline void Consume(size_t const len) noexcept {if(!(remaining -= len)) state = State::DATA_CR;}
+				/**
+				 * Checks whether the last chunk and the trailer are parsed
+				 */
+				inline bool IsComplete() const noexcept {return state == State::DONE;}
+				/**
+				 * Checks whether the input is not validly chunked
+				 */
+				inline bool HasFailed() const noexcept {return state == State::FAILED;}
+				/**
+				 * Resets the decoder for the next body
+				 */
+				inline void Reset() noexcept {remaining = 0; lineLength = 0; state = State::SIZE; sizeDigits = 0;}
+
+			private:
+				enum class State : unsigned char
+				{
+					SIZE,
+					EXTENSION,
+					SIZE_LF,
+					DATA,
+					DATA_CR,
+					DATA_LF,
+					TRAILER,
+					TRAILER_LINE,
+					TRAILER_LINE_LF,
+					TRAILER_LF,
+					DONE,
+					FAILED
+				};
+
+				/**
+				 * @brief Remaining size of the current chunk
+				 */
+				uint64_t remaining;
+				/**
+				 * @brief Length of chunk extensions and trailers (limited)
+				 */
+				size_t lineLength;
+				State state;
+				unsigned char sizeDigits;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_CHUNKEDDECODER_HPP_
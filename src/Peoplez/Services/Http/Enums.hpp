@@ -37,6 +37,7 @@
 #define PEOPLEZ_SERVICES_HTTP_ENUMS_H_
 
 #include <bitset>
+#include <cstddef>
 
 namespace Peoplez
 {
@@ -51,7 +52,10 @@ namespace Peoplez
 			{
 				HTTP_SOCKET_STATUS_RECEIVE_HEADER,
 				HTTP_SOCKET_STATUS_RECEIVE_BODY,
-				HTTP_SOCKET_STATUS_SEND
+				HTTP_SOCKET_STATUS_RECEIVE_BODY_STREAM,
+				HTTP_SOCKET_STATUS_SEND,
+				HTTP_SOCKET_STATUS_SEND_STREAM,
+				HTTP_SOCKET_STATUS_WAIT_RESPONSE
 			};
 
 			/**
@@ -103,8 +107,15 @@ namespace Peoplez
 			{
 				HTTP_COMPRESSION_GZIP,
 				HTTP_COMPRESSION_DEFLATE,
+				HTTP_COMPRESSION_BROTLI,
+				HTTP_COMPRESSION_ZSTD,
 				HTTP_COMPRESSION_NONE
 			};
+
+			/**
+			 * @brief Number of compression variants including HTTP_COMPRESSION_NONE (e.g. for arrays indexed by HttpCompression)
+			 */
+			constexpr size_t HTTP_COMPRESSION_COUNT = HTTP_COMPRESSION_NONE + 1;
 		} // namespace Http
 	} // namespace Services
 } // namespace Peoplez
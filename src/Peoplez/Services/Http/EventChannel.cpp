@@ -0,0 +1,127 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "EventChannel.hpp"
+
+// Extern includes
+#include <algorithm>
+#include <unordered_map>
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace String;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			std::shared_ptr<EventChannel> EventChannel::Get(PeoplezString const & name)
+			{
+				// Never deleted: streams may still publish while static objects are destroyed
+				static std::mutex * const registryMutex = new std::mutex();
+				static std::unordered_map<PeoplezString, std::shared_ptr<EventChannel>> * const registry = new std::unordered_map<PeoplezString, std::shared_ptr<EventChannel>>();
+
+				std::unique_lock<std::mutex> const lock(*registryMutex);
+				std::shared_ptr<EventChannel> & channel = (*registry)[name.UniqueCopy()];
+
+				if(!channel) channel = std::make_shared<EventChannel>();
+
+				return channel;
+			}
+
+			void EventChannel::Subscribe(std::shared_ptr<EventStream> const & stream)
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				streams.push_back(stream);
+			}
+
+			void EventChannel::Unsubscribe(EventStream const * const stream) noexcept
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				// Ended streams are removed as well
+				streams.erase(std::remove_if(streams.begin(), streams.end(), [stream](std::weak_ptr<EventStream> const & entry)
+				{
+					std::shared_ptr<EventStream> const current = entry.lock();
+					return !current || current.get() == stream;
+				}), streams.end());
+			}
+
+			size_t EventChannel::Publish(PeoplezString const & data, PeoplezString const & event, PeoplezString const & id)
+			{
+				return Publish(EventStream::Serialize(data, event, id));
+			}
+
+			size_t EventChannel::Publish(EventStream::Event const & event)
+			{
+				size_t reached = 0;
+
+				// Send without lock (streams may subscribe or end meanwhile)
+				for(std::shared_ptr<EventStream> const & stream : Subscribers()) reached += stream->Send(event);
+
+				return reached;
+			}
+
+			std::vector<std::shared_ptr<EventStream>> EventChannel::Subscribers()
+			{
+				std::vector<std::shared_ptr<EventStream>> result;
+				std::unique_lock<std::mutex> const lock(mut);
+
+				result.reserve(streams.size());
+
+				for(size_t i = 0; i < streams.size();)
+				{
+					std::shared_ptr<EventStream> stream = streams[i].lock();
+
+					// Remove ended streams (order does not matter)
+					if(!stream || !stream->IsOpen())
+					{
+						streams[i] = std::move(streams.back());
+						streams.pop_back();
+						continue;
+					}
+
+					result.push_back(std::move(stream));
+					++i;
+				}
+
+				return result;
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_EVENTCHANNEL_HPP_
+#define PEOPLEZ_SERVICES_HTTP_EVENTCHANNEL_HPP_
+
+// Local includes
+#include "EventStream.hpp"
+
+// Extern includes
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Named group of event streams that receive the same Server-Sent Events
+			 *
+			 * @details
+			 * An event is serialized once and the same buffer is queued on every subscribed stream.
+			 * Streams are held weakly; ended streams drop out automatically. All methods are thread safe.
+			 */
+			class EventChannel final
+			{
+			public:
+				/**
+				 * Gets the channel with the given name (created on first use; channels exist until the program ends)
+				 *
+				 * @param name Name of the channel
+				 *
+				 * @return The channel
+				 */
+				static std::shared_ptr<EventChannel> Get(String::PeoplezString const & name);
+				/**
+				 * Adds a stream to the channel
+				 *
+				 * @param stream Stream to add
+				 */
+				void Subscribe(std::shared_ptr<EventStream> const & stream);
+				/**
+				 * Removes a stream from the channel
+				 *
+				 * @param stream Stream to remove
+				 */
+				void Unsubscribe(EventStream const * stream) noexcept;
+				/**
+				 * Sends an event to all streams of the channel
+				 *
+				 * @param data Data of the event
+				 * @param event Event type; empty for the default type "message"
+				 * @param id Event id; empty for none
+				 *
+				 * @return Number of streams the event was queued on
+				 */
+				size_t Publish(String::PeoplezString const & data, String::PeoplezString const & event = String::PeoplezString(), String::PeoplezString const & id = String::PeoplezString());
+				/**
+				 * Sends a serialized event to all streams of the channel
+				 *
+				 * @param event Event created by EventStream::Serialize
+				 *
+				 * @return Number of streams the event was queued on
+				 */
+				size_t Publish(EventStream::Event const & event);
+				/**
+				 * Gets the streams of the channel that are still open
+				 *
+				 * @return Snapshot of the streams
+				 */
+				std::vector<std::shared_ptr<EventStream>> Subscribers();
+
+			private:
+				std::mutex mut;
+				std::vector<std::weak_ptr<EventStream>> streams;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_EVENTCHANNEL_HPP_
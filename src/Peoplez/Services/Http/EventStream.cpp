@@ -0,0 +1,477 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "EventStream.hpp"
+
+// Local includes
+#include "../../System/Logging/Logger.hpp"
+#include "../../System/Timer.hpp"
+#include "EventChannel.hpp"
+#include "HttpContext.hpp"
+
+// Extern includes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+extern "C"
+{
+#include <sys/uio.h>
+}
+
+/**
+ * @def EVENT_STREAM_SEND_BUFFER_SIZE
+ * @brief Number of queued bytes above which a stream is closed because the client does not read fast enough
+ */
+#ifndef EVENT_STREAM_SEND_BUFFER_SIZE
+#define EVENT_STREAM_SEND_BUFFER_SIZE 1048576
+#endif
+/**
+ * @def EVENT_STREAM_HEARTBEAT_INTERVAL
+ * @brief Seconds between two keep-alive comments (keeps proxies from closing idle streams)
+ */
+#ifndef EVENT_STREAM_HEARTBEAT_INTERVAL
+#define EVENT_STREAM_HEARTBEAT_INTERVAL 15
+#endif
+/**
+ * @def EVENT_STREAM_IOV_BATCH
+ * @brief Maximum number of queued events that are written with one gather write
+ */
+#define EVENT_STREAM_IOV_BATCH 64
+/**
+ * @def EVENT_STREAM_DRAIN_SIZE
+ * @brief Size of the buffer for data the client sends on a stream (dropped)
+ */
+#define EVENT_STREAM_DRAIN_SIZE 4096
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace String;
+	using namespace System::Logging;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * Checks whether a field value contains a line break (would end the field)
+			 */
+			static inline bool HasLineBreak(PeoplezString const & value) noexcept
+			{
+				return memchr(value.GetData(), '\n', value.Length()) || memchr(value.GetData(), '\r', value.Length());
+			}
+
+			/**
+			 * Appends a field line ("name: value\n")
+			 */
+			static inline void AppendField(PeoplezString & dest, char const * const name, size_t const nameLength, char const * const value, size_t const valueLength)
+			{
+				dest.Append(name, nameLength);
+				if(valueLength) dest.Append(value, valueLength);
+				dest.Append("\n", 1);
+			}
+
+			EventStream::EventStream(System::IO::Network::Socket * const s) noexcept : sender(s), context(), mut(), outputQueue(), outputOffset(0), queuedBytes(0), opened(false), ownsSender(false), closing(false), waiting(false) {}
+
+			EventStream::Event EventStream::Serialize(PeoplezString const & data, PeoplezString const & event, PeoplezString const & id)
+			{
+				if(HasLineBreak(event) || HasLineBreak(id)) throw std::invalid_argument("Line break in event type or id");
+
+				char const * const text = data.GetData();
+				size_t const length = data.Length();
+
+				// Every line gets a "data: " prefix
+				size_t lines = 1;
+				for(size_t i = 0; i < length; ++i) lines += text[i] == '\n' || text[i] == '\r';
+
+				PeoplezString result(length + lines * 7 + event.Length() + id.Length() + 16);
+
+				if(!id.IsEmpty()) AppendField(result, "id: ", 4, id.GetData(), id.Length());
+				if(!event.IsEmpty()) AppendField(result, "event: ", 7, event.GetData(), event.Length());
+
+				// Lines end with CRLF, LF or CR
+				size_t start = 0;
+
+				for(size_t i = 0; i < length; ++i)
+				{
+					if(text[i] != '\n' && text[i] != '\r') continue;
+
+					AppendField(result, "data: ", 6, text + start, i - start);
+
+					if(text[i] == '\r' && i + 1 < length && text[i + 1] == '\n') ++i;
+					start = i + 1;
+				}
+
+				AppendField(result, "data: ", 6, text + start, length - start);
+
+				// Empty line dispatches the event
+				result.Append("\n", 1);
+
+				return std::make_shared<PeoplezString const>(std::move(result));
+			}
+
+			bool EventStream::Open(HttpContext & base) noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> lock(mut);
+
+					if(closing || !sender) return false;
+
+					// Responses to requests before the stream are sent first (own copies: events are shared between threads)
+					std::vector<Event> queue;
+					queue.reserve(base.OutputQueue.size() + 1 + outputQueue.size());
+
+					for(PeoplezString const & response : base.OutputQueue) queue.push_back(std::make_shared<PeoplezString const>(response.UniqueCopy()));
+
+					{
+						// Without length or chunked coding the body ends with the connection
+						PeoplezString header(160 + base.response.Headers.SerializedLength());
+
+						header.Append("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\nConnection: close\r\n", 94);
+						base.response.Headers.AppendTo(header);
+						header.Append("\r\n", 2);
+
+						queue.push_back(std::make_shared<PeoplezString const>(std::move(header)));
+					}
+
+					// Events sent by the handler already follow the headers
+					for(Event const & event : outputQueue) queue.push_back(event);
+
+					for(size_t i = 0; i < queue.size() - outputQueue.size(); ++i) queuedBytes += queue[i]->Length();
+					outputQueue.swap(queue);
+
+					base.OutputQueue.clear();
+					base.InputBuffer.Clear();
+
+					// Nothing below throws: the socket belongs to this stream from now on
+					opened = true;
+					ownsSender = true;
+
+					Flush();
+					lock.unlock();
+
+					try
+					{
+						AddHeartbeat(shared_from_this());
+					}
+					catch(...)
+					{
+						Logger::LogException("Error while registering event stream heartbeat", __FILE__, __LINE__);
+					}
+
+					return true;
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in EventStream::Open", __FILE__, __LINE__);
+				}
+
+				std::unique_lock<std::mutex> const lock(mut);
+
+				// Socket still belongs to the http connection
+				closing = true;
+				outputQueue.clear();
+				outputOffset = queuedBytes = 0;
+
+				return false;
+			}
+
+			bool EventStream::Send(PeoplezString const & data, PeoplezString const & event, PeoplezString const & id)
+			{
+				return Send(Serialize(data, event, id));
+			}
+
+			bool EventStream::Send(Event const & event)
+			{
+				std::unique_lock<std::mutex> lock(mut);
+
+				if(closing || (opened && !sender->IsOpen())) return false;
+
+				// Slow clients are dropped instead of growing the queue without limit (they reconnect with Last-Event-ID)
+				if(queuedBytes + event->Length() > EVENT_STREAM_SEND_BUFFER_SIZE)
+				{
+					Logger::LogEvent("Event stream closed: client too slow");
+
+					closing = true;
+					outputQueue.clear();
+					outputOffset = queuedBytes = 0;
+
+					if(opened) sender->Close();
+					else Wake(lock);
+
+					return false;
+				}
+
+				outputQueue.push_back(event);
+				queuedBytes += event->Length();
+
+				if(opened) Flush();
+				else Wake(lock);
+
+				return true;
+			}
+
+			void EventStream::Close() noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> lock(mut);
+
+					if(closing) return;
+
+					closing = true;
+
+					if(opened) Flush();
+					else Wake(lock);
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in EventStream::Close", __FILE__, __LINE__);
+				}
+			}
+
+			bool EventStream::IsOpen() noexcept
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				return !closing && (!opened || sender->IsOpen());
+			}
+
+			void EventStream::MessageReceivable() noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> const lock(mut);
+
+					if(!opened) return;
+
+					char buf[EVENT_STREAM_DRAIN_SIZE];
+
+					while(sender->IsOpen())
+					{
+						int const bytes = sender->Recv(buf, EVENT_STREAM_DRAIN_SIZE);
+
+						if(bytes > 0) continue;
+
+						// If the client closed the connection ... nothing can be sent anymore
+						// Else log error (if not EAGAIN)
+						if(!bytes)
+						{
+							closing = true;
+							outputQueue.clear();
+							outputOffset = queuedBytes = 0;
+
+							sender->Close();
+						}
+						else if(errno != EAGAIN)
+						{
+							Logger::LogException("Error while reading on event stream", __FILE__, __LINE__);
+							Logger::LogException(strerror(errno), __FILE__, __LINE__);
+						}
+
+						break;
+					}
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in EventStream::MessageReceivable", __FILE__, __LINE__);
+				}
+			}
+
+			void EventStream::MessageSendable() noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> const lock(mut);
+
+					if(opened) Flush();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in EventStream::MessageSendable", __FILE__, __LINE__);
+				}
+			}
+
+			HttpResponseStreamStatus EventStream::NextChunk(HttpContext &, PeoplezString & chunk)
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				if(!outputQueue.empty())
+				{
+					// HTTP/2 frames the body itself: one copy per stream
+					chunk.ToUnique(queuedBytes);
+					for(Event const & event : outputQueue) chunk.Append(*event);
+
+					outputQueue.clear();
+					queuedBytes = 0;
+
+					return closing ? HttpResponseStreamStatus::END : HttpResponseStreamStatus::DATA;
+				}
+
+				if(closing) return HttpResponseStreamStatus::END;
+
+				// Asked again after the next event (see Wake)
+				waiting = true;
+				return HttpResponseStreamStatus::WAIT;
+			}
+
+			void EventStream::Aborted(HttpContext &) noexcept
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				closing = true;
+				waiting = false;
+				outputQueue.clear();
+				outputOffset = queuedBytes = 0;
+			}
+
+			EventStream::~EventStream()
+			{
+				if(ownsSender) delete sender;
+			}
+
+			bool EventStream::SendInner()
+			{
+				// If the socket is closed already ... nothing can be sent anymore
+				if(!sender->IsOpen())
+				{
+					outputQueue.clear();
+					outputOffset = queuedBytes = 0;
+					return false;
+				}
+
+				while(!outputQueue.empty())
+				{
+					// Collect queued events
+					iovec iov[EVENT_STREAM_IOV_BATCH];
+					size_t const count = std::min<size_t>(outputQueue.size(), EVENT_STREAM_IOV_BATCH);
+
+					for(size_t i = 0; i < count; ++i)
+					{
+						iov[i].iov_base = (void *) outputQueue[i]->GetData();
+						iov[i].iov_len = outputQueue[i]->Length();
+					}
+
+					// First event may be sent partially already
+					iov[0].iov_base = (char *) iov[0].iov_base + outputOffset;
+					iov[0].iov_len -= outputOffset;
+
+					// Send them at once
+					int const sent = sender->SendV(iov, (int)count);
+
+					// If an error occured while sending ...
+					//   Log an error (if not EAGAIN)
+					if(__builtin_expect(sent < 0, false))
+					{
+						if(errno != EAGAIN) Logger::LogEvent("Error while writing");
+						return false;
+					}
+
+					// Remove completely sent events and remember the sent part of the next one
+					size_t remaining = sent;
+					size_t done = 0;
+
+					queuedBytes -= sent;
+
+					for(; done < count && remaining >= iov[done].iov_len; ++done) remaining -= iov[done].iov_len;
+
+					outputOffset = (done ? 0 : outputOffset) + remaining;
+					outputQueue.erase(outputQueue.begin(), outputQueue.begin() + done);
+
+					// If not everything could be sent ... wait for MessageSendable
+					if(done < count) return false;
+				}
+
+				return true;
+			}
+
+			void EventStream::Flush()
+			{
+				// Close the socket after the last event is sent
+				if(SendInner() && closing && sender->IsOpen()) sender->Close();
+			}
+
+			void EventStream::Wake(std::unique_lock<std::mutex> & lock) noexcept
+			{
+				bool const resume = waiting;
+				std::shared_ptr<HttpContext> const ctx = resume ? context.lock() : nullptr;
+
+				waiting = false;
+				lock.unlock();
+
+				// Without lock: the HTTP/2 connection calls NextChunk while it holds its own lock.
+				// The connection only queues the stream if it is held (e.g. Publish from a handler of the same connection).
+				if(ctx) ctx->ResumeResponse();
+			}
+
+			void EventStream::Disconnected() noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> const lock(mut);
+
+					closing = true;
+
+					if(opened && sender->IsOpen()) sender->Close();
+
+					outputQueue.clear();
+					outputOffset = queuedBytes = 0;
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in EventStream::Disconnected", __FILE__, __LINE__);
+				}
+			}
+
+			void EventStream::AddHeartbeat(std::shared_ptr<EventStream> const & stream)
+			{
+				// Never deleted: the timer may still publish while static objects are destroyed
+				static EventChannel * const group = new EventChannel();
+				// Comment line (ignored by the client); outlives the timer
+				static Event const heartbeat = std::make_shared<PeoplezString const>(":\n\n", 3);
+				// Destroyed at exit, which stops the timer thread (it must not wait while the statics of Timer are destroyed)
+				[[maybe_unused]] static System::Timer const timer([]()
+				{
+					group->Publish(heartbeat);
+				}, std::chrono::seconds(EVENT_STREAM_HEARTBEAT_INTERVAL));
+
+				group->Subscribe(stream);
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_EVENTSTREAM_HPP_
+#define PEOPLEZ_SERVICES_HTTP_EVENTSTREAM_HPP_
+
+// Local includes
+#include "../../String/PeoplezString.hpp"
+#include "../../System/IO/Network/Socket.hpp"
+#include "HttpResponseStream.hpp"
+
+// Extern includes
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			class HttpContext;
+
+			/**
+			 * @brief Server-Sent Events response (text/event-stream) that stays open after the headers are sent
+			 *
+			 * @details
+			 * Created with HttpContext::OpenEventStream. On http/1.1 connections the stream takes over the socket after
+			 * ProcessRequest (like WebSocketConnection) and writes the queued events directly from their buffers, so an event
+			 * that is pushed to many streams (see EventChannel) is serialized once and never copied per subscriber.
+			 * On HTTP/2 the events are the body of a streamed response (HttpResponseStream) and copied into DATA frames.
+			 * Events can be sent from any thread. Streams that can not keep up are closed; EventSource clients reconnect
+			 * with Last-Event-ID then.
+			 */
+			class EventStream final : public HttpResponseStream, public std::enable_shared_from_this<EventStream>
+			{
+				friend class HttpContext;
+			public:
+				/**
+				 * @brief Serialized event that can be queued on several streams
+				 */
+				using Event = std::shared_ptr<String::PeoplezString const>;
+
+				/**
+				 * Constructor
+				 *
+				 * @param sender Socket of the http/1.1 connection (owned by the stream after a successful Open); nullptr for HTTP/2
+				 */
+				explicit EventStream(System::IO::Network::Socket * sender) noexcept;
+				/**
+				 * Serializes an event
+				 *
+				 * Every line of the data becomes a "data:" field.
+				 *
+				 * @param data Data of the event
+				 * @param event Event type; empty for the default type "message"
+				 * @param id Event id (sent back as Last-Event-ID after a reconnect); empty for none
+				 *
+				 * @return Event for Send(Event const &)
+				 *
+				 * @throws std::invalid_argument If the type or id contains a line break
+				 */
+				static Event Serialize(String::PeoplezString const & data, String::PeoplezString const & event = String::PeoplezString(), String::PeoplezString const & id = String::PeoplezString());
+				/**
+				 * Takes over an http/1.1 connection whose request opened the stream
+				 *
+				 * The pending responses of the connection, the response headers and the events sent so far are queued.
+				 *
+				 * @param base Context of the http/1.1 connection (context has to be locked)
+				 *
+				 * @return false if the connection could not be taken over (the stream is closed then)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				bool Open(HttpContext & base) noexcept;
+				/**
+				 * Sends an event (from any thread)
+				 *
+				 * @param data Data of the event
+				 * @param event Event type; empty for the default type "message"
+				 * @param id Event id; empty for none
+				 *
+				 * @return false if the stream is closed
+				 */
+				bool Send(String::PeoplezString const & data, String::PeoplezString const & event = String::PeoplezString(), String::PeoplezString const & id = String::PeoplezString());
+				/**
+				 * Sends a serialized event (from any thread)
+				 *
+				 * @param event Event created by Serialize
+				 *
+				 * @return false if the stream is closed
+				 */
+				bool Send(Event const & event);
+				/**
+				 * Ends the stream after the queued events are sent (from any thread)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void Close() noexcept;
+				/**
+				 * Indicates whether events can be sent
+				 */
+				bool IsOpen() noexcept;
+				/**
+				 * Reads (and drops) everything the client sends until the socket would block
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void MessageReceivable() noexcept;
+				/**
+				 * Continues sending after the socket became writable
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void MessageSendable() noexcept;
+				/**
+				 * Passes the queued events to an HTTP/2 response
+				 */
+				HttpResponseStreamStatus NextChunk(HttpContext & context, String::PeoplezString & chunk) override;
+				/**
+				 * Closes the stream after the HTTP/2 stream ended
+				 */
+				void Aborted(HttpContext & context) noexcept override;
+				/**
+				 * Destructor
+				 */
+				~EventStream();
+
+			private:
+				EventStream(EventStream const & other) = delete;
+				EventStream & operator=(EventStream const & other) = delete;
+
+				/**
+				 * Writes as much of the output queue as possible with a single gather write
+				 *
+				 * Stream has to be locked
+				 *
+				 * @return Indicates whether the output queue is empty now
+				 */
+				bool SendInner();
+				/**
+				 * Sends the output queue and closes the socket afterwards if the stream ends
+				 *
+				 * Stream has to be locked
+				 */
+				void Flush();
+				/**
+				 * Lets the HTTP/2 response ask for the queued events again
+				 *
+				 * The stream is queued at its connection, that continues it as soon as no handler of it runs anymore.
+				 * So events may be sent from request handlers of the same connection.
+				 *
+				 * @param lock Lock of the stream (released)
+				 */
+				void Wake(std::unique_lock<std::mutex> & lock) noexcept;
+				/**
+				 * Ends the stream after its http connection was removed (called by the destructor of HttpContext)
+				 */
+				void Disconnected() noexcept;
+				/**
+				 * Registers a stream for the regular keep-alive comments (starts the timer on first use)
+				 */
+				static void AddHeartbeat(std::shared_ptr<EventStream> const & stream);
+
+				System::IO::Network::Socket * const sender;
+				/**
+				 * @brief Context of the HTTP/2 response (see HttpContext::ResumeResponse)
+				 */
+				std::weak_ptr<HttpContext> context;
+				std::mutex mut;
+				std::vector<Event> outputQueue;
+				/**
+				 * @brief Number of bytes of the first queued event that are sent already
+				 */
+				size_t outputOffset;
+				size_t queuedBytes;
+				/**
+				 * @brief Indicates that the stream writes to the socket (after Open)
+				 */
+				bool opened;
+				bool ownsSender;
+				/**
+				 * @brief Indicates that no further events are accepted (the queued ones are still sent)
+				 */
+				bool closing;
+				/**
+				 * @brief Indicates that the HTTP/2 response waits for events
+				 */
+				bool waiting;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_EVENTSTREAM_HPP_
@@ -0,0 +1,326 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "Hpack.hpp"
+
+// Local includes
+#include "../../System/Logging/Logger.hpp"
+#include "HttpFunctions.hpp"
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace String;
+	using namespace System::Logging;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			namespace Hpack
+			{
+				void AppendInteger(PeoplezString & dest, uint8_t const flags, unsigned int const prefixBits, uint64_t value)
+				{
+					char buf[12];
+					size_t len = 0;
+					uint64_t const mask = (1u << prefixBits) - 1;
+
+					if(value < mask) buf[len++] = (char)(flags | value);
+					else
+					{
+						buf[len++] = (char)(flags | mask);
+
+						for(value -= mask; value >= 128; value >>= 7) buf[len++] = (char)((value & 0x7F) | 0x80);
+
+						buf[len++] = (char)value;
+					}
+
+					dest.Append(buf, len);
+				}
+
+				void AppendString(PeoplezString & dest, char const * const str, size_t const len)
+				{
+					AppendInteger(dest, 0x00, 7, len);
+					dest.Append(str, len);
+				}
+
+				void AppendIndexed(PeoplezString & dest, size_t const index)
+				{
+					AppendInteger(dest, 0x80, 7, index);
+				}
+
+				void AppendLiteral(PeoplezString & dest, size_t const nameIndex, char const * const value, size_t const len)
+				{
+					AppendInteger(dest, 0x00, 4, nameIndex);
+					AppendString(dest, value, len);
+				}
+
+				void AppendLiteral(PeoplezString & dest, PeoplezString const & name, PeoplezString const & value)
+				{
+					dest.Append("\0", 1);
+					AppendString(dest, name.GetData(), name.Length());
+					AppendString(dest, value.GetData(), value.Length());
+				}
+
+				bool DecodeHuffman(unsigned char const * const data, size_t const len, PeoplezString & dest)
+				{
+					// Decoded characters are collected before appending them
+					char buf[256];
+					size_t bufLen = 0;
+
+					// Left aligned bit buffer
+					uint64_t bits = 0;
+					unsigned int count = 0;
+					size_t pos = 0;
+
+					for(;;)
+					{
+						while(count <= 56 && pos < len)
+						{
+							bits |= (uint64_t)data[pos++] << (56 - count);
+							count += 8;
+						}
+
+						if(!count) break;
+
+						// Next HUFFMAN_MAX_LENGTH bits (missing bits at the end are filled with ones like the EOS prefix)
+						uint32_t const next = (uint32_t)((count < 64 ? bits | (~(uint64_t)0 >> count) : bits) >> (64 - HUFFMAN_MAX_LENGTH));
+
+						// Shortest code is 5 bits long; the limit of the longest length covers all values
+						unsigned int length = 5;
+						while(next >= HUFFMAN.limit[length]) ++length;
+
+						// If only the padding is left ...
+						if(length > count)
+						{
+							if(count >= 8 || (bits >> (64 - count)) != ((uint64_t)1 << count) - 1) return false;
+							break;
+						}
+
+						uint16_t const symbol = HUFFMAN.symbols[HUFFMAN.offset[length] + (next >> (HUFFMAN_MAX_LENGTH - length)) - HUFFMAN.first[length]];
+
+						// EOS must not be decoded (RFC 7541 Section 5.2)
+						if(symbol == 256) return false;
+
+						buf[bufLen++] = (char)symbol;
+
+						if(bufLen == sizeof(buf))
+						{
+							dest.Append(buf, bufLen);
+							bufLen = 0;
+						}
+
+						bits <<= length;
+						count -= length;
+					}
+
+					if(bufLen) dest.Append(buf, bufLen);
+
+					return true;
+				}
+			} // namespace Hpack
+
+			bool HpackDecoder::Decode(PeoplezString const & block, HeaderHandler & handler) noexcept
+			{
+				try
+				{
+					unsigned char const * const data = (unsigned char const *) block.GetData();
+					size_t const len = block.Length();
+					size_t pos = 0;
+					bool sizeUpdateAllowed = true;
+
+					while(pos < len)
+					{
+						unsigned char const first = data[pos];
+						uint64_t index;
+
+						if(first & 0x80) // Indexed header field
+						{
+							PeoplezString name, value;
+							HttpHeaderField field;
+
+							if(!ReadInteger(data, len, pos, 7, index) || !Get(index, name, value, field)) return false;
+
+							handler.Header(name, value, field);
+						}
+						else if((first & 0xE0) == 0x20) // Dynamic table size update
+						{
+							if(!sizeUpdateAllowed || !ReadInteger(data, len, pos, 5, index) || index > tableSizeLimit) return false;
+
+							maxTableSize = index;
+							Evict();
+							continue;
+						}
+						else // Literal header field (with incremental indexing, without indexing or never indexed)
+						{
+							bool const indexing = first & 0x40;
+							PeoplezString name, value;
+							HttpHeaderField field;
+
+							if(!ReadInteger(data, len, pos, indexing ? 6 : 4, index)) return false;
+
+							if(index)
+							{
+								PeoplezString unused;
+								if(!Get(index, name, unused, field)) return false;
+							}
+							else
+							{
+								if(!ReadString(block, pos, name)) return false;
+								field = name.Length() && name[0] != ':' ? HttpFunctions::ToHttpHeaderField(name) : HttpHeaderField::UNKNOWN;
+							}
+
+							if(!ReadString(block, pos, value)) return false;
+
+							if(indexing) Insert(name, value, field);
+
+							handler.Header(name, value, field);
+						}
+
+						// Size updates are only allowed at the beginning of a block (RFC 7541 Section 4.2)
+						sizeUpdateAllowed = false;
+					}
+
+					return true;
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HpackDecoder::Decode", __FILE__, __LINE__);
+				}
+
+				return false;
+			}
+
+			bool HpackDecoder::ReadInteger(unsigned char const * const data, size_t const len, size_t & pos, unsigned int const prefixBits, uint64_t & value) noexcept
+			{
+				uint64_t const mask = (1u << prefixBits) - 1;
+
+				if(pos >= len) return false;
+
+				value = data[pos++] & mask;
+				if(value < mask) return true;
+
+				for(unsigned int shift = 0; pos < len && shift <= 28; shift += 7)
+				{
+					unsigned char const b = data[pos++];
+					value += (uint64_t)(b & 0x7F) << shift;
+
+					if(!(b & 0x80)) return true;
+				}
+
+				// Truncated or too large
+				return false;
+			}
+
+			bool HpackDecoder::ReadString(PeoplezString const & block, size_t & pos, PeoplezString & value)
+			{
+				unsigned char const * const data = (unsigned char const *) block.GetData();
+
+				if(pos >= block.Length()) return false;
+
+				bool const huffman = data[pos] & 0x80;
+				uint64_t length;
+
+				if(!ReadInteger(data, block.Length(), pos, 7, length) || length > block.Length() - pos) return false;
+
+				if(huffman)
+				{
+					// Each character is coded with at least 5 bits
+					value = PeoplezString((length * 8) / 5 + 1);
+
+					if(!Hpack::DecodeHuffman(data + pos, length, value)) return false;
+				}
+				else value = block.Substring(pos, length);
+
+				pos += length;
+
+				return true;
+			}
+
+			bool HpackDecoder::Get(uint64_t const index, PeoplezString & name, PeoplezString & value, HttpHeaderField & field) const
+			{
+				if(!index) return false;
+				else if(index <= Hpack::STATIC_TABLE_SIZE)
+				{
+					Hpack::StaticEntry const & entry = Hpack::STATIC_TABLE[index];
+
+					name = PeoplezString(entry.name.data(), entry.name.size());
+					if(!entry.value.empty()) value = PeoplezString(entry.value.data(), entry.value.size());
+					field = entry.field;
+				}
+				else if(index - Hpack::STATIC_TABLE_SIZE <= table.size())
+				{
+					DynamicEntry const & entry = table[index - Hpack::STATIC_TABLE_SIZE - 1];
+
+					name = entry.name;
+					value = entry.value;
+					field = entry.field;
+				}
+				else return false;
+
+				return true;
+			}
+
+			void HpackDecoder::Insert(PeoplezString const & name, PeoplezString const & value, HttpHeaderField const field)
+			{
+				size_t const size = name.Length() + value.Length() + 32;
+
+				// An entry larger than the table empties it (RFC 7541 Section 4.4)
+				if(size > maxTableSize)
+				{
+					table.clear();
+					tableSize = 0;
+					return;
+				}
+
+				// Copy (the originals may be views into the received frame)
+				table.push_front(DynamicEntry{PeoplezString(name.GetData(), name.Length()), PeoplezString(value.GetData(), value.Length()), field});
+				tableSize += size;
+
+				Evict();
+			}
+
+			void HpackDecoder::Evict() noexcept
+			{
+				while(tableSize > maxTableSize && !table.empty())
+				{
+					tableSize -= table.back().name.Length() + table.back().value.Length() + 32;
+					table.pop_back();
+				}
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
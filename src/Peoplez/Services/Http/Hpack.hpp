@@ -0,0 +1,441 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HPACK_HPP_
+#define PEOPLEZ_SERVICES_HTTP_HPACK_HPP_
+
+// Local includes
+#include "../../String/PeoplezString.hpp"
+#include "HttpHeaderField.hpp"
+
+// Extern includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string_view>
+
+/**
+ * @def HPACK_DEFAULT_TABLE_SIZE
+ * @brief Initial size of the dynamic table in bytes (RFC 7541 Section 4.2 / SETTINGS_HEADER_TABLE_SIZE)
+ */
+#define HPACK_DEFAULT_TABLE_SIZE 4096
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Compile time tables of HPACK (RFC 7541)
+			 */
+			namespace Hpack
+			{
+				/**
+				 * @brief Entry of the static table
+				 */
+				struct StaticEntry
+				{
+					std::string_view name;
+					std::string_view value;
+					/**
+					 * @brief Well known header field of the name (resolved at compile time)
+					 */
+					HttpHeaderField field;
+				};
+
+				/**
+				 * Creates an entry of the static table
+				 *
+				 * @param name Name of the header field
+				 * @param value Value of the header field
+				 *
+				 * @return Entry with the resolved header field
+				 */
+				constexpr StaticEntry Entry(std::string_view const name, std::string_view const value = std::string_view()) noexcept
+				{
+					return StaticEntry{name, value, HttpHeaderFieldHash::Lookup(name)};
+				}
+
+				/**
+				 * @brief Number of entries in the static table
+				 */
+				constexpr size_t STATIC_TABLE_SIZE = 61;
+
+				/**
+				 * @brief Static table (RFC 7541 Appendix A; index 0 is unused)
+				 */
+				constexpr std::array<StaticEntry, STATIC_TABLE_SIZE + 1> STATIC_TABLE =
+				{
+					Entry(""),
+					Entry(":authority"),
+					Entry(":method", "GET"),
+					Entry(":method", "POST"),
+					Entry(":path", "/"),
+					Entry(":path", "/index.html"),
+					Entry(":scheme", "http"),
+					Entry(":scheme", "https"),
+					Entry(":status", "200"),
+					Entry(":status", "204"),
+					Entry(":status", "206"),
+					Entry(":status", "304"),
+					Entry(":status", "400"),
+					Entry(":status", "404"),
+					Entry(":status", "500"),
+					Entry("accept-charset"),
+					Entry("accept-encoding", "gzip, deflate"),
+					Entry("accept-language"),
+					Entry("accept-ranges"),
+					Entry("accept"),
+					Entry("access-control-allow-origin"),
+					Entry("age"),
+					Entry("allow"),
+					Entry("authorization"),
+					Entry("cache-control"),
+					Entry("content-disposition"),
+					Entry("content-encoding"),
+					Entry("content-language"),
+					Entry("content-length"),
+					Entry("content-location"),
+					Entry("content-range"),
+					Entry("content-type"),
+					Entry("cookie"),
+					Entry("date"),
+					Entry("etag"),
+					Entry("expect"),
+					Entry("expires"),
+					Entry("from"),
+					Entry("host"),
+					Entry("if-match"),
+					Entry("if-modified-since"),
+					Entry("if-none-match"),
+					Entry("if-range"),
+					Entry("if-unmodified-since"),
+					Entry("last-modified"),
+					Entry("link"),
+					Entry("location"),
+					Entry("max-forwards"),
+					Entry("proxy-authenticate"),
+					Entry("proxy-authorization"),
+					Entry("range"),
+					Entry("referer"),
+					Entry("refresh"),
+					Entry("retry-after"),
+					Entry("server"),
+					Entry("set-cookie"),
+					Entry("strict-transport-security"),
+					Entry("transfer-encoding"),
+					Entry("user-agent"),
+					Entry("vary"),
+					Entry("via"),
+					Entry("www-authenticate")
+				};
+
+				/**
+				 * @brief Indices of static table entries that are used for responses
+				 */
+				enum StaticIndex : uint8_t
+				{
+					STATUS = 8,
+					STATUS_200 = 8,
+					STATUS_204 = 9,
+					STATUS_206 = 10,
+					STATUS_304 = 11,
+					STATUS_400 = 12,
+					STATUS_404 = 13,
+					STATUS_500 = 14,
+					ACCEPT_RANGES = 18,
+					CONTENT_ENCODING = 26,
+					CONTENT_LENGTH = 28,
+					CONTENT_RANGE = 30,
+					CONTENT_TYPE = 31,
+					DATE = 33,
+					ETAG = 34,
+					LAST_MODIFIED = 44,
+					LOCATION = 46,
+					SET_COOKIE = 55,
+					VARY = 59
+				};
+
+				/**
+				 * @brief Code lengths of the Huffman code (RFC 7541 Appendix B; index 256 is EOS)
+				 * @details The code is canonical: codes of the same length are consecutive in symbol order.
+				 * The codes themselves are therefore derived from the lengths.
+				 */
+				constexpr std::array<uint8_t, 257> HUFFMAN_LENGTHS =
+				{
+					13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+					28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+					 6, 10, 10, 12, 13,  6,  8, 11, 10, 10,  8, 11,  8,  6,  6,  6,
+					 5,  5,  5,  6,  6,  6,  6,  6,  6,  6,  7,  8, 15,  6, 12, 10,
+					13,  6,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,
+					 7,  7,  7,  7,  7,  7,  7,  7,  8,  7,  8, 13, 19, 13, 14,  6,
+					15,  5,  6,  5,  6,  5,  6,  6,  6,  5,  7,  7,  6,  6,  6,  5,
+					 6,  7,  6,  5,  5,  6,  7,  7,  7,  7,  7, 15, 11, 14, 13, 28,
+					20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+					24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+					22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+					21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+					26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+					19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+					20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+					26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+					30
+				};
+
+				/**
+				 * @brief Maximum length of a Huffman code in bits
+				 */
+				constexpr unsigned int HUFFMAN_MAX_LENGTH = 30;
+
+				/**
+				 * @brief Decoding tables of the canonical Huffman code
+				 */
+				struct HuffmanTables
+				{
+					/**
+					 * @brief First code of each length, left aligned to HUFFMAN_MAX_LENGTH bits
+					 */
+					std::array<uint32_t, HUFFMAN_MAX_LENGTH + 1> limit;
+					/**
+					 * @brief First code of each length (right aligned)
+					 */
+					std::array<uint32_t, HUFFMAN_MAX_LENGTH + 1> first;
+					/**
+					 * @brief Position of the first symbol of each length in symbols
+					 */
+					std::array<uint16_t, HUFFMAN_MAX_LENGTH + 1> offset;
+					/**
+					 * @brief Symbols sorted by code
+					 */
+					std::array<uint16_t, 257> symbols;
+				};
+
+				/**
+				 * Creates the decoding tables from HUFFMAN_LENGTHS
+				 *
+				 * @return Decoding tables
+				 */
+				constexpr HuffmanTables CreateHuffmanTables() noexcept
+				{
+					HuffmanTables result = {};
+					uint32_t code = 0;
+					uint16_t count = 0;
+
+					for(unsigned int len = 1; len <= HUFFMAN_MAX_LENGTH; ++len)
+					{
+						result.first[len] = code;
+						result.offset[len] = count;
+
+						for(unsigned int sym = 0; sym < HUFFMAN_LENGTHS.size(); ++sym)
+						{
+							if(HUFFMAN_LENGTHS[sym] == len)
+							{
+								result.symbols[count++] = (uint16_t)sym;
+								++code;
+							}
+						}
+
+						// All codes of this length are below this limit; longer codes start at or above it
+						result.limit[len] = code << (HUFFMAN_MAX_LENGTH - len);
+						code <<= 1;
+					}
+
+					return result;
+				}
+
+				/**
+				 * @brief Decoding tables of the canonical Huffman code
+				 */
+				constexpr HuffmanTables HUFFMAN = CreateHuffmanTables();
+
+				static_assert(HUFFMAN.limit[HUFFMAN_MAX_LENGTH] == (1u << HUFFMAN_MAX_LENGTH), "Huffman code has to be complete");
+				static_assert(HUFFMAN.symbols[0] == '0' && HUFFMAN.symbols[256] == 256, "Huffman code is not canonical");
+
+				/**
+				 * Appends an integer with the given prefix length (RFC 7541 Section 5.1)
+				 *
+				 * @param dest String to append the integer to
+				 * @param flags Bits of the first byte above the prefix
+				 * @param prefixBits Number of bits of the prefix
+				 * @param value Integer to append
+				 */
+				void AppendInteger(String::PeoplezString & dest, uint8_t flags, unsigned int prefixBits, uint64_t value);
+				/**
+				 * Appends a string literal without Huffman coding (RFC 7541 Section 5.2)
+				 *
+				 * @param dest String to append the literal to
+				 * @param str Literal
+				 * @param len Length of the literal
+				 */
+				void AppendString(String::PeoplezString & dest, char const * str, size_t len);
+				/**
+				 * Appends an indexed header field (RFC 7541 Section 6.1)
+				 *
+				 * @param dest Header block
+				 * @param index Index of the header field
+				 */
+				void AppendIndexed(String::PeoplezString & dest, size_t index);
+				/**
+				 * Appends a header field with the name of the given table entry without indexing (RFC 7541 Section 6.2.2)
+				 *
+				 * @param dest Header block
+				 * @param nameIndex Index of the name
+				 * @param value Value of the header field
+				 * @param len Length of the value
+				 */
+				void AppendLiteral(String::PeoplezString & dest, size_t nameIndex, char const * value, size_t len);
+				/**
+				 * Appends a header field with a literal name without indexing (RFC 7541 Section 6.2.2)
+				 *
+				 * @param dest Header block
+				 * @param name Lower case name of the header field
+				 * @param value Value of the header field
+				 */
+				void AppendLiteral(String::PeoplezString & dest, String::PeoplezString const & name, String::PeoplezString const & value);
+				/**
+				 * Decodes a Huffman coded string literal
+				 *
+				 * @param data Huffman coded literal
+				 * @param len Length of the coded literal
+				 * @param dest String to append the decoded literal to
+				 *
+				 * @return Indicates whether the literal is valid (valid padding, no EOS)
+				 */
+				bool DecodeHuffman(unsigned char const * data, size_t len, String::PeoplezString & dest);
+			} // namespace Hpack
+
+			/**
+			 * @brief Decoder for HPACK header blocks (RFC 7541)
+			 *
+			 * @details
+			 * One decoder has to be used for all header blocks of a connection as the dynamic table is shared.
+			 * Names of the static table and of the dynamic table are passed with their well known header field,
+			 * so that they do not have to be looked up again.
+			 */
+			class HpackDecoder final
+			{
+			public:
+				/**
+				 * @brief Receiver of the decoded header fields
+				 */
+				class HeaderHandler
+				{
+				public:
+					/**
+					 * Is called for each decoded header field in order
+					 *
+					 * @param name Name of the header field
+					 * @param value Value of the header field
+					 * @param field Well known header field of the name (UNKNOWN for pseudo header fields)
+					 */
+					virtual void Header(String::PeoplezString const & name, String::PeoplezString const & value, HttpHeaderField field) = 0;
+					virtual ~HeaderHandler() {}
+				};
+
+				/**
+				 * Constructor
+				 *
+				 * @param maxSize Maximum size of the dynamic table (the advertised SETTINGS_HEADER_TABLE_SIZE)
+				 */
+				HpackDecoder(size_t maxSize = HPACK_DEFAULT_TABLE_SIZE) noexcept : table(), tableSize(0), maxTableSize(maxSize), tableSizeLimit(maxSize) {}
+				/**
+				 * Decodes a complete header block
+				 *
+				 * @param block Header block (concatenated HEADERS and CONTINUATION fragments)
+				 * @param handler Receiver of the header fields
+				 *
+				 * @return Indicates whether the block could be decoded (otherwise it is a COMPRESSION_ERROR)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				bool Decode(String::PeoplezString const & block, HeaderHandler & handler) noexcept;
+
+			private:
+				/**
+				 * @brief Entry of the dynamic table
+				 */
+				struct DynamicEntry
+				{
+					String::PeoplezString name;
+					String::PeoplezString value;
+					HttpHeaderField field;
+				};
+
+				/**
+				 * Reads an integer with the given prefix length
+				 *
+				 * @return Indicates whether the integer is valid
+				 */
+				static bool ReadInteger(unsigned char const * data, size_t len, size_t & pos, unsigned int prefixBits, uint64_t & value) noexcept;
+				/**
+				 * Reads a (possibly Huffman coded) string literal
+				 *
+				 * @return Indicates whether the literal is valid
+				 */
+				static bool ReadString(String::PeoplezString const & block, size_t & pos, String::PeoplezString & value);
+				/**
+				 * Looks up the name (and value) of a table entry
+				 *
+				 * @return Indicates whether the index is valid
+				 */
+				bool Get(uint64_t index, String::PeoplezString & name, String::PeoplezString & value, HttpHeaderField & field) const;
+				/**
+				 * Adds an entry to the dynamic table and evicts old entries
+				 */
+				void Insert(String::PeoplezString const & name, String::PeoplezString const & value, HttpHeaderField field);
+				/**
+				 * Evicts entries until the table fits into maxTableSize
+				 */
+				void Evict() noexcept;
+
+				/**
+				 * @brief Dynamic table (newest entry first)
+				 */
+				std::deque<DynamicEntry> table;
+				size_t tableSize;
+				size_t maxTableSize;
+				/**
+				 * @brief Upper bound of maxTableSize (advertised by the server)
+				 */
+				size_t const tableSizeLimit;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HPACK_HPP_
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "Http2ClientInfo.hpp"
+
+// Extern includes
+#include <cstring>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Protocols offered via ALPN in wire format (preferred first)
+			 */
+			static unsigned char const ALPN_PROTOCOLS[] = "\x02h2\x08http/1.1";
+			/**
+			 * @brief Part of ALPN_PROTOCOLS without HTTP/2
+			 */
+			static unsigned char const * const ALPN_HTTP11 = ALPN_PROTOCOLS + 3;
+
+			/**
+			 * Checks whether the cipher suite of a handshake may be used for HTTP/2
+			 *
+			 * RFC 7540 Section 9.2: TLS 1.2 or newer without the suites of Appendix A, which are all suites without
+			 * AEAD cipher or without ephemeral key exchange (TLS 1.3 suites are fine).
+			 */
+			static bool IsHttp2Cipher(SSL * const ssl) noexcept
+			{
+				SSL_CIPHER const * const cipher = SSL_get_pending_cipher(ssl);
+
+				if(!cipher || SSL_version(ssl) < TLS1_2_VERSION || !SSL_CIPHER_is_aead(cipher)) return false;
+
+				int const kx = SSL_CIPHER_get_kx_nid(cipher);
+
+				return kx == NID_kx_ecdhe || kx == NID_kx_dhe || kx == NID_kx_any;
+			}
+
+			Http2ClientInfo::Http2ClientInfo(int const fileDescriptor, HttpRequestHandler & requestHandler, System::IO::Network::Socket * const sender)
+				: ClientInfo(fileDescriptor), connection(std::make_shared<Http2Connection>(requestHandler, sender))
+			{
+				// Queue the server preface
+				connection->Start(String::PeoplezString());
+			}
+
+			void Http2ClientInfo::MessageReceivableCB()
+			{
+				connection->MessageReceivable();
+			}
+
+			void Http2ClientInfo::MessageSendableCB()
+			{
+				connection->MessageSendable();
+			}
+
+			int Http2ClientInfo::SelectProtocolCB(SSL * const ssl, unsigned char const ** const out, unsigned char * const outLen, unsigned char const * const in, unsigned int const inLen, void *)
+			{
+				unsigned char * selected = nullptr;
+				// HTTP/2 is only offered with an allowed cipher suite (the cipher suite is selected before)
+				bool const http2 = IsHttp2Cipher(ssl);
+				unsigned char const * const protocols = http2 ? ALPN_PROTOCOLS : ALPN_HTTP11;
+				unsigned int const protocolsLen = sizeof(ALPN_PROTOCOLS) - 1 - (protocols - ALPN_PROTOCOLS);
+
+				// If the client supports none of the protocols ... continue without ALPN (http/1.1)
+				if(SSL_select_next_proto(&selected, outLen, protocols, protocolsLen, in, inLen) != OPENSSL_NPN_NEGOTIATED) return SSL_TLSEXT_ERR_NOACK;
+
+				*out = selected;
+				return SSL_TLSEXT_ERR_OK;
+			}
+
+			bool Http2ClientInfo::IsNegotiated(SSL const * const ssl) noexcept
+			{
+				unsigned char const * protocol = nullptr;
+				unsigned int len = 0;
+
+				SSL_get0_alpn_selected(ssl, &protocol, &len);
+
+				return len == 2 && !memcmp(protocol, "h2", 2);
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTP2CLIENTINFO_HPP_
+#define PEOPLEZ_SERVICES_HTTP_HTTP2CLIENTINFO_HPP_
+
+// Local includes
+#include "../../System/IO/Network/ClientInfo.hpp"
+#include "Http2Connection.hpp"
+#include "HttpRequestHandler.hpp"
+
+// Extern includes
+#include <memory>
+#include <openssl/ssl.h>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Specific ClientInfo for connections that speak HTTP/2 from the start (h2 negotiated via ALPN)
+			 */
+			class Http2ClientInfo final : public System::IO::Network::ClientInfo
+			{
+			public:
+				/**
+				 * Constructor
+				 *
+				 * @param fileDescriptor Copy of the file descriptor of the socket (needed for ConnectionsManager)
+				 * @param requestHandler Handler that should process the requests
+				 * @param sender Socket for communication with client/browser (owned by the connection afterwards)
+				 */
+				Http2ClientInfo(int fileDescriptor, HttpRequestHandler & requestHandler, System::IO::Network::Socket * sender);
+				virtual ClientInfo *Copy() {return new Http2ClientInfo(*this);}
+				virtual void MessageReceivableCB();
+				virtual void MessageSendableCB();
+				virtual bool KeepOpen() noexcept {return connection->IsResponding();}
+				virtual ~Http2ClientInfo() {}
+
+				/**
+				 * ALPN callback for SSL_CTX_set_alpn_select_cb that prefers h2 over http/1.1
+				 *
+				 * h2 is only selected if the cipher suite of the handshake is allowed for HTTP/2 (RFC 7540 Section 9.2.2, AEAD with ephemeral key exchange).
+				 *
+				 * @return SSL_TLSEXT_ERR_OK if a protocol was selected; SSL_TLSEXT_ERR_NOACK otherwise
+				 */
+				static int SelectProtocolCB(SSL * ssl, unsigned char const ** out, unsigned char * outLen, unsigned char const * in, unsigned int inLen, void * arg);
+				/**
+				 * Checks whether h2 was negotiated for the given (accepted) ssl connection
+				 *
+				 * @param ssl SSL connection after the handshake
+				 *
+				 * @return Indicates whether the connection speaks HTTP/2
+				 */
+				static bool IsNegotiated(SSL const * ssl) noexcept;
+
+			private:
+				std::shared_ptr<Http2Connection> const connection;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTP2CLIENTINFO_HPP_
@@ -0,0 +1,1408 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "Http2Connection.hpp"
+
+// Local includes
+#include "../../System/Logging/Logger.hpp"
+#include "HttpFunctions.hpp"
+
+// Extern includes
+#include <algorithm>
+#include <cstring>
+extern "C"
+{
+#include <sys/uio.h>
+}
+
+/**
+ * @def HTTP2_MAX_CONCURRENT_STREAMS
+ * @brief Maximum number of streams a client may open concurrently (SETTINGS_MAX_CONCURRENT_STREAMS)
+ */
+#ifndef HTTP2_MAX_CONCURRENT_STREAMS
+#define HTTP2_MAX_CONCURRENT_STREAMS 100
+#endif
+/**
+ * @def HTTP2_RECEIVE_WINDOW
+ * @brief Flow control window for request bodies in bytes (per stream and for the connection)
+ */
+#ifndef HTTP2_RECEIVE_WINDOW
+#define HTTP2_RECEIVE_WINDOW 1048576
+#endif
+/**
+ * @def HTTP2_MAX_FRAME_SIZE
+ * @brief Maximum accepted frame payload in bytes (default of SETTINGS_MAX_FRAME_SIZE)
+ */
+#define HTTP2_MAX_FRAME_SIZE 16384
+/**
+ * @def HTTP2_MAX_HEADER_LIST_SIZE
+ * @brief Maximum accepted size of the header fields of a request (SETTINGS_MAX_HEADER_LIST_SIZE)
+ */
+#define HTTP2_MAX_HEADER_LIST_SIZE 16384
+/**
+ * @def MAX_BODY_LENGTH
+ * @brief Maximum accepted length of the http body in bytes
+ */
+#define MAX_BODY_LENGTH 5242880
+/**
+ * @def HTTP2_SEND_BUFFER_SIZE
+ * @brief Number of queued bytes that stop fetching response data and reading further requests until the socket is writable
+ */
+#define HTTP2_SEND_BUFFER_SIZE 65536
+/**
+ * @def HTTP2_IOV_BATCH
+ * @brief Maximum number of queued buffers that are written with one gather write
+ */
+#define HTTP2_IOV_BATCH 64
+/**
+ * @def INPUT_BUFFER_STEP_SIZE
+ * @brief Size of the read buffer in bytes
+ */
+#define INPUT_BUFFER_STEP_SIZE 16384
+
+static_assert(HTTP2_RECEIVE_WINDOW >= 65535 && HTTP2_RECEIVE_WINDOW <= 0x7FFFFFFF, "Invalid flow control window");
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace String;
+	using namespace System::Logging;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			static size_t const FRAME_HEADER_LENGTH = 9;
+			static int64_t const DEFAULT_WINDOW = 65535;
+			static int64_t const MAX_WINDOW = 0x7FFFFFFF;
+			/**
+			 * @brief Payloads up to this size are copied behind their frame header
+			 */
+			static size_t const SMALL_PAYLOAD_SIZE = 256;
+
+			static uint8_t const FLAG_END_STREAM = 0x1;
+			static uint8_t const FLAG_ACK = 0x1;
+			static uint8_t const FLAG_END_HEADERS = 0x4;
+			static uint8_t const FLAG_PADDED = 0x8;
+			static uint8_t const FLAG_PRIORITY = 0x20;
+
+			static uint16_t const SETTINGS_ENABLE_PUSH = 0x2;
+			static uint16_t const SETTINGS_MAX_CONCURRENT_STREAMS = 0x3;
+			static uint16_t const SETTINGS_INITIAL_WINDOW_SIZE = 0x4;
+			static uint16_t const SETTINGS_MAX_FRAME_SIZE = 0x5;
+			static uint16_t const SETTINGS_MAX_HEADER_LIST_SIZE = 0x6;
+
+			static inline uint32_t ReadUInt32(unsigned char const * const data) noexcept
+			{
+				return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+			}
+
+			static inline void WriteUInt32(char * const dest, uint32_t const value) noexcept
+			{
+				dest[0] = (char)(value >> 24);
+				dest[1] = (char)(value >> 16);
+				dest[2] = (char)(value >> 8);
+				dest[3] = (char)value;
+			}
+
+			static inline void WriteSetting(char * const dest, uint16_t const id, uint32_t const value) noexcept
+			{
+				dest[0] = (char)(id >> 8);
+				dest[1] = (char)id;
+				WriteUInt32(dest + 2, value);
+			}
+
+			/**
+			 * Decodes base64url (RFC 4648 Section 5) as used by the HTTP2-Settings header
+			 *
+			 * @param src Coded data (padding is optional)
+			 * @param dest Target for the decoded data
+			 *
+			 * @return Indicates whether the data is valid base64url
+			 */
+			static bool DecodeBase64Url(PeoplezString const & src, PeoplezString & dest)
+			{
+				char buf[256];
+				size_t len = 0;
+				uint32_t bits = 0;
+				unsigned int count = 0;
+
+				dest = PeoplezString((src.Length() * 3) / 4 + 1);
+
+				for(size_t i = 0; i < src.Length() && src[i] != '='; ++i)
+				{
+					char const c = src[i];
+					uint32_t value;
+
+					if(c >= 'A' && c <= 'Z') value = c - 'A';
+					else if(c >= 'a' && c <= 'z') value = c - 'a' + 26;
+					else if(c >= '0' && c <= '9') value = c - '0' + 52;
+					else if(c == '-') value = 62;
+					else if(c == '_') value = 63;
+					else return false;
+
+					bits = (bits << 6) | value;
+					count += 6;
+
+					if(count >= 8)
+					{
+						count -= 8;
+						buf[len++] = (char)(bits >> count);
+
+						if(len == sizeof(buf))
+						{
+							dest.Append(buf, len);
+							len = 0;
+						}
+					}
+				}
+
+				if(len) dest.Append(buf, len);
+
+				return true;
+			}
+
+			/**
+			 * @brief Passes the decoded header fields of a request to its HttpContext
+			 */
+			class RequestHeaderHandler final : public HpackDecoder::HeaderHandler
+			{
+			public:
+				/**
+				 * Constructor
+				 *
+				 * @param _context Context of the request; nullptr if the header fields are only decoded (refused streams and trailers)
+				 */
+				RequestHeaderHandler(HttpContext * const _context) : context(_context), method(), path(), size(0), regularSeen(false), schemeSeen(false), malformed(false) {}
+
+				virtual void Header(PeoplezString const & name, PeoplezString const & value, HttpHeaderField const field)
+				{
+					// Size as defined for SETTINGS_MAX_HEADER_LIST_SIZE
+					size += name.Length() + value.Length() + 32;
+
+					if(!context || malformed) return;
+
+					// Header field names must be lower case (RFC 7540 Section 8.1.2)
+					for(size_t i = 0; i < name.Length(); ++i)
+					{
+						if(name[i] >= 'A' && name[i] <= 'Z')
+						{
+							malformed = true;
+							return;
+						}
+					}
+
+					if(name.Length() && name[0] == ':')
+					{
+						// Pseudo header fields precede all other fields (RFC 7540 Section 8.1.2.1)
+						if(regularSeen) malformed = true;
+						else if(name.EqualTo(":method", 7))
+						{
+							if(!method.IsEmpty()) malformed = true;
+							else method = value;
+						}
+						else if(name.EqualTo(":path", 5))
+						{
+							if(!path.IsEmpty()) malformed = true;
+							else path = value;
+						}
+						else if(name.EqualTo(":scheme", 7))
+						{
+							if(schemeSeen) malformed = true;
+							else schemeSeen = true;
+						}
+						else if(name.EqualTo(":authority", 10)) context->InsertHeader(HttpHeaderField::HOST, PeoplezString("host", 4), value);
+						else malformed = true;
+					}
+					else
+					{
+						regularSeen = true;
+
+						switch(field)
+						{
+						case HttpHeaderField::CONNECTION:
+						case HttpHeaderField::KEEP_ALIVE:
+						case HttpHeaderField::TRANSFER_ENCODING:
+						case HttpHeaderField::UPGRADE:
+							// Connection specific header fields are not allowed (RFC 7540 Section 8.1.2.2)
+							malformed = true;
+							break;
+						case HttpHeaderField::TE:
+							if(!value.EqualTo("trailers", 8)) malformed = true;
+							else context->InsertHeader(field, name, value);
+							break;
+						default:
+							context->InsertHeader(field, name, value);
+							break;
+						}
+					}
+				}
+
+				HttpContext * const context;
+				PeoplezString method;
+				PeoplezString path;
+				/**
+				 * @brief Decoded size of the header list
+				 */
+				size_t size;
+				bool regularSeen;
+				bool schemeSeen;
+				bool malformed;
+			};
+
+			Http2Connection::Http2Connection(HttpRequestHandler & reqHandler, System::IO::Network::Socket * const _sender)
+				: requestHandler(reqHandler), sender(_sender ? _sender : throw std::invalid_argument("Invalid socket")), mut(), owner(), resumes(), resumeMutex(), decoder(), streams(), input(), outputQueue(), queuedBytes(0), headerBlock(),
+				  continuationStream(0), continuationFlags(0), lastStreamId(0), sendWindow(DEFAULT_WINDOW), receiveWindow(DEFAULT_WINDOW), initialSendWindow(DEFAULT_WINDOW), maxSendFrameSize(HTTP2_MAX_FRAME_SIZE),
+				  ownsSender(false), prefaceReceived(false), receiveThrottled(false), goingAway(false), closing(false)
+			{
+			}
+
+			void Http2Connection::Start(PeoplezString const & received) noexcept
+			{
+				try
+				{
+					Lock const lock(*this);
+
+					ownsSender = true;
+					QueuePreface();
+
+					input = received;
+					ProcessInput();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in Http2Connection::Start", __FILE__, __LINE__);
+				}
+			}
+
+			bool Http2Connection::Upgrade(HttpContext & base) noexcept
+			{
+				try
+				{
+					Lock const lock(*this);
+
+					// Settings of the client are sent with the upgrade request (RFC 7540 Section 3.2.1)
+					{
+						PeoplezString settings;
+
+						if(!DecodeBase64Url(base.request.GetHeaderValue(HttpHeaderField::HTTP2_SETTINGS), settings)) return false;
+						if(ApplySettings(settings) != Http2ErrorCode::NO_ERROR) return false;
+					}
+
+					// Responses to requests before the upgrade request are sent first
+					for(PeoplezString const & response : base.OutputQueue)
+					{
+						outputQueue.push_back(response);
+						queuedBytes += response.Length();
+					}
+
+					base.OutputQueue.clear();
+
+					{
+						PeoplezString const switching("HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n", 71);
+
+						outputQueue.push_back(switching);
+						queuedBytes += switching.Length();
+					}
+
+					ownsSender = true;
+					QueuePreface();
+
+					// Upgrade request is answered on stream 1 (half-closed remote)
+					{
+						lastStreamId = 1;
+
+						Stream & stream = CreateStream(1);
+						stream.context->request = base.request;
+						stream.endReceived = true;
+
+						Respond(1, stream, HttpStatusCode::OK);
+					}
+
+					// Client preface follows the upgrade request
+					input = base.InputBuffer;
+					base.InputBuffer.Clear();
+					ProcessInput();
+
+					return true;
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in Http2Connection::Upgrade", __FILE__, __LINE__);
+				}
+
+				return false;
+			}
+
+			void Http2Connection::MessageReceivable() noexcept
+			{
+				try
+				{
+					Lock const lock(*this);
+
+					ReceiveInner();
+					Flush();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in Http2Connection::MessageReceivable", __FILE__, __LINE__);
+				}
+			}
+
+			void Http2Connection::MessageSendable() noexcept
+			{
+				try
+				{
+					Lock const lock(*this);
+					Flush();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in Http2Connection::MessageSendable", __FILE__, __LINE__);
+				}
+			}
+
+			bool Http2Connection::IsResponding() noexcept
+			{
+				bool responding = false;
+
+				{
+					std::unique_lock<std::mutex> const lock(mut, std::try_to_lock);
+
+					// A connection that is processed at the moment is not idle
+					if(!lock.owns_lock()) return true;
+
+					for(std::pair<uint32_t const, Stream> const & stream : streams)
+					{
+						if(stream.second.endReceived && !stream.second.finished)
+						{
+							responding = true;
+							break;
+						}
+					}
+				}
+
+				// Streams resumed meanwhile were left to this thread
+				ResumeQueued();
+
+				return responding;
+			}
+
+			Http2Connection::Stream & Http2Connection::CreateStream(uint32_t const streamId)
+			{
+				Stream & stream = streams[streamId];
+
+				stream.context = std::shared_ptr<HttpContext>(new HttpContext(nullptr));
+				stream.sendWindow = initialSendWindow;
+				stream.receiveWindow = HTTP2_RECEIVE_WINDOW;
+
+				// Continues the stream after HttpContext::ResumeResponse or HttpCompletion::Complete
+				std::weak_ptr<Http2Connection> const weakConnection(shared_from_this());
+
+				stream.context->resume = [weakConnection, streamId]()
+				{
+					// If the connection still exists ... continue it
+					std::shared_ptr<Http2Connection> const connection = weakConnection.lock();
+					if(connection) connection->Resume(streamId);
+				};
+
+				return stream;
+			}
+
+			void Http2Connection::ProcessInput()
+			{
+				// Client connection preface (RFC 7540 Section 3.5)
+				if(!prefaceReceived)
+				{
+					size_t const len = std::min(input.Length(), PREFACE_LENGTH);
+
+					if(memcmp(input.GetData(), PREFACE, len))
+					{
+						ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+						return;
+					}
+					else if(len < PREFACE_LENGTH) return;
+
+					input <<= PREFACE_LENGTH;
+					prefaceReceived = true;
+				}
+
+				// While a complete frame is received ...
+				while(input.Length() >= FRAME_HEADER_LENGTH && !closing)
+				{
+					unsigned char const * const header = (unsigned char const *) input.GetData();
+					size_t const length = ((size_t)header[0] << 16) | ((size_t)header[1] << 8) | (size_t)header[2];
+
+					if(length > HTTP2_MAX_FRAME_SIZE)
+					{
+						ConnectionError(Http2ErrorCode::FRAME_SIZE_ERROR);
+						return;
+					}
+					else if(input.Length() < FRAME_HEADER_LENGTH + length) break;
+
+					Http2FrameType const type = (Http2FrameType) header[3];
+					uint8_t const flags = header[4];
+					uint32_t const streamId = ReadUInt32(header + 5) & 0x7FFFFFFF;
+					PeoplezString const payload = input.Substring(FRAME_HEADER_LENGTH, length);
+
+					// Remove frame from input buffer (the payload stays valid)
+					if(FRAME_HEADER_LENGTH + length < input.Length()) input <<= FRAME_HEADER_LENGTH + length;
+					else input.Clear();
+
+					HandleFrame(type, flags, streamId, payload);
+				}
+			}
+
+			void Http2Connection::HandleFrame(Http2FrameType const type, uint8_t const flags, uint32_t const streamId, PeoplezString const & payload)
+			{
+				// A header block must not be interrupted (RFC 7540 Section 6.10)
+				if(continuationStream && (type != Http2FrameType::CONTINUATION || streamId != continuationStream))
+				{
+					ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					return;
+				}
+
+				switch(type)
+				{
+				case Http2FrameType::DATA:
+					HandleData(flags, streamId, payload);
+					break;
+				case Http2FrameType::HEADERS:
+					HandleHeaders(flags, streamId, payload);
+					break;
+				case Http2FrameType::PRIORITY:
+					// Prioritization is not supported (streams are served round robin)
+					if(!streamId) ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					else if(payload.Length() != 5) StreamError(streamId, Http2ErrorCode::FRAME_SIZE_ERROR);
+					break;
+				case Http2FrameType::RST_STREAM:
+					if(!streamId || streamId > lastStreamId) ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					else if(payload.Length() != 4) ConnectionError(Http2ErrorCode::FRAME_SIZE_ERROR);
+					else streams.erase(streamId);
+					break;
+				case Http2FrameType::SETTINGS:
+					HandleSettings(flags, streamId, payload);
+					break;
+				case Http2FrameType::PUSH_PROMISE:
+					// Clients must not push (RFC 7540 Section 8.2)
+					ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					break;
+				case Http2FrameType::PING:
+					if(streamId) ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					else if(payload.Length() != 8) ConnectionError(Http2ErrorCode::FRAME_SIZE_ERROR);
+					else if(!(flags & FLAG_ACK)) QueueFrame(Http2FrameType::PING, FLAG_ACK, 0, payload.GetData(), 8);
+					break;
+				case Http2FrameType::GOAWAY:
+					// Open streams are completed, new ones are refused
+					if(streamId) ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					else goingAway = true;
+					break;
+				case Http2FrameType::WINDOW_UPDATE:
+					HandleWindowUpdate(streamId, payload);
+					break;
+				case Http2FrameType::CONTINUATION:
+					if(!continuationStream) ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					else
+					{
+						headerBlock.Append(payload);
+
+						if(headerBlock.Length() > 4 * HTTP2_MAX_HEADER_LIST_SIZE) ConnectionError(Http2ErrorCode::ENHANCE_YOUR_CALM);
+						else if(flags & FLAG_END_HEADERS)
+						{
+							PeoplezString const block = headerBlock;
+
+							headerBlock = PeoplezString();
+							continuationStream = 0;
+
+							HeaderBlockReceived(streamId, continuationFlags, block);
+						}
+					}
+					break;
+				default:
+					// Unknown frame types are ignored (RFC 7540 Section 4.1)
+					break;
+				}
+			}
+
+			void Http2Connection::HandleData(uint8_t const flags, uint32_t const streamId, PeoplezString const & payload)
+			{
+				if(!streamId || streamId > lastStreamId)
+				{
+					ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					return;
+				}
+
+				// The whole frame (including padding) counts for flow control (RFC 7540 Section 6.9)
+				receiveWindow -= payload.Length();
+
+				if(receiveWindow < 0)
+				{
+					ConnectionError(Http2ErrorCode::FLOW_CONTROL_ERROR);
+					return;
+				}
+				else if(receiveWindow <= HTTP2_RECEIVE_WINDOW / 2)
+				{
+					char increment[4];
+					WriteUInt32(increment, (uint32_t)(HTTP2_RECEIVE_WINDOW - receiveWindow));
+					QueueFrame(Http2FrameType::WINDOW_UPDATE, 0, 0, increment, 4);
+
+					receiveWindow = HTTP2_RECEIVE_WINDOW;
+				}
+
+				size_t begin = 0;
+				size_t end = payload.Length();
+
+				if(flags & FLAG_PADDED)
+				{
+					if(!end || (unsigned char)payload[0] >= end)
+					{
+						ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+						return;
+					}
+
+					end -= (unsigned char)payload[0];
+					begin = 1;
+				}
+
+				std::map<uint32_t, Stream>::iterator const iter = streams.find(streamId);
+
+				// Data of reset streams is dropped
+				if(iter == streams.end()) return;
+
+				Stream & stream = iter->second;
+
+				if(stream.endReceived)
+				{
+					StreamError(streamId, Http2ErrorCode::STREAM_CLOSED);
+					return;
+				}
+
+				stream.receiveWindow -= payload.Length();
+
+				if(stream.receiveWindow < 0)
+				{
+					StreamError(streamId, Http2ErrorCode::FLOW_CONTROL_ERROR);
+					return;
+				}
+
+				stream.received += end - begin;
+
+				// The body must not exceed the content-length (RFC 7540 Section 8.1.2.6)
+				if(stream.context->request.ContentLengthIsSet() && stream.received > stream.context->request.ContentLength())
+				{
+					StreamError(streamId, Http2ErrorCode::PROTOCOL_ERROR);
+					return;
+				}
+
+				// Collect body (unless the request is answered already)
+				if(!stream.responding && end > begin)
+				{
+					PeoplezString & body = stream.context->BodyBuffer;
+
+					if(body.Length() + (end - begin) > MAX_BODY_LENGTH) Respond(streamId, stream, HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
+					else if(body.IsEmpty()) body = payload.Substring(begin, end - begin);
+					else body.Append(payload.GetData() + begin, end - begin);
+				}
+
+				if(flags & FLAG_END_STREAM) RequestComplete(streamId, stream);
+				else if(stream.receiveWindow <= HTTP2_RECEIVE_WINDOW / 2)
+				{
+					char increment[4];
+					WriteUInt32(increment, (uint32_t)(HTTP2_RECEIVE_WINDOW - stream.receiveWindow));
+					QueueFrame(Http2FrameType::WINDOW_UPDATE, 0, streamId, increment, 4);
+
+					stream.receiveWindow = HTTP2_RECEIVE_WINDOW;
+				}
+			}
+
+			void Http2Connection::HandleHeaders(uint8_t const flags, uint32_t const streamId, PeoplezString const & payload)
+			{
+				// Streams of the client have odd ids (RFC 7540 Section 5.1.1)
+				if(!(streamId & 1))
+				{
+					ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					return;
+				}
+
+				size_t begin = 0;
+				size_t end = payload.Length();
+
+				if(flags & FLAG_PADDED)
+				{
+					if(!end || (unsigned char)payload[0] >= end)
+					{
+						ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+						return;
+					}
+
+					end -= (unsigned char)payload[0];
+					begin = 1;
+				}
+
+				// Priority information is skipped
+				if(flags & FLAG_PRIORITY)
+				{
+					if(end - begin < 5)
+					{
+						ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+						return;
+					}
+
+					begin += 5;
+				}
+
+				PeoplezString const fragment = payload.Substring(begin, end - begin);
+
+				// If the header block is complete ... handle it
+				// Else wait for CONTINUATION frames
+				if(flags & FLAG_END_HEADERS) HeaderBlockReceived(streamId, flags, fragment);
+				else
+				{
+					continuationStream = streamId;
+					continuationFlags = flags;
+					headerBlock = fragment;
+				}
+			}
+
+			void Http2Connection::HandleSettings(uint8_t const flags, uint32_t const streamId, PeoplezString const & payload)
+			{
+				if(streamId) ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+				else if(flags & FLAG_ACK)
+				{
+					if(payload.Length()) ConnectionError(Http2ErrorCode::FRAME_SIZE_ERROR);
+				}
+				else
+				{
+					Http2ErrorCode const error = ApplySettings(payload);
+
+					if(error != Http2ErrorCode::NO_ERROR) ConnectionError(error);
+					else QueueFrame(Http2FrameType::SETTINGS, FLAG_ACK, 0, nullptr, 0);
+				}
+			}
+
+			Http2ErrorCode Http2Connection::ApplySettings(PeoplezString const & payload)
+			{
+				unsigned char const * const data = (unsigned char const *) payload.GetData();
+
+				if(payload.Length() % 6) return Http2ErrorCode::FRAME_SIZE_ERROR;
+
+				for(size_t pos = 0; pos < payload.Length(); pos += 6)
+				{
+					uint16_t const id = ((uint16_t)data[pos] << 8) | data[pos + 1];
+					uint32_t const value = ReadUInt32(data + pos + 2);
+
+					switch(id)
+					{
+					case SETTINGS_ENABLE_PUSH:
+						if(value > 1) return Http2ErrorCode::PROTOCOL_ERROR;
+						break;
+					case SETTINGS_INITIAL_WINDOW_SIZE:
+						if(value > MAX_WINDOW) return Http2ErrorCode::FLOW_CONTROL_ERROR;
+
+						// Change applies to all open streams (RFC 7540 Section 6.9.2)
+						for(std::map<uint32_t, Stream>::iterator iter = streams.begin(); iter != streams.end(); ++iter) iter->second.sendWindow += (int64_t)value - initialSendWindow;
+
+						initialSendWindow = value;
+						break;
+					case SETTINGS_MAX_FRAME_SIZE:
+						if(value < HTTP2_MAX_FRAME_SIZE || value > 0xFFFFFF) return Http2ErrorCode::PROTOCOL_ERROR;
+
+						maxSendFrameSize = value;
+						break;
+					default:
+						// The encoder does not use the dynamic table (SETTINGS_HEADER_TABLE_SIZE); other settings concern servers only
+						break;
+					}
+				}
+
+				return Http2ErrorCode::NO_ERROR;
+			}
+
+			void Http2Connection::HandleWindowUpdate(uint32_t const streamId, PeoplezString const & payload)
+			{
+				if(payload.Length() != 4)
+				{
+					ConnectionError(Http2ErrorCode::FRAME_SIZE_ERROR);
+					return;
+				}
+
+				uint32_t const increment = ReadUInt32((unsigned char const *) payload.GetData()) & 0x7FFFFFFF;
+
+				if(!streamId)
+				{
+					sendWindow += increment;
+
+					if(!increment) ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+					else if(sendWindow > MAX_WINDOW) ConnectionError(Http2ErrorCode::FLOW_CONTROL_ERROR);
+				}
+				else if(streamId > lastStreamId) ConnectionError(Http2ErrorCode::PROTOCOL_ERROR);
+				else
+				{
+					std::map<uint32_t, Stream>::iterator const iter = streams.find(streamId);
+
+					// Updates of closed streams are ignored
+					if(iter == streams.end()) return;
+
+					iter->second.sendWindow += increment;
+
+					if(!increment) StreamError(streamId, Http2ErrorCode::PROTOCOL_ERROR);
+					else if(iter->second.sendWindow > MAX_WINDOW) StreamError(streamId, Http2ErrorCode::FLOW_CONTROL_ERROR);
+				}
+			}
+
+			void Http2Connection::HeaderBlockReceived(uint32_t const streamId, uint8_t const flags, PeoplezString const & block)
+			{
+				std::map<uint32_t, Stream>::iterator const iter = streams.find(streamId);
+
+				// If the stream is open ... the block contains trailers (RFC 7540 Section 8.1)
+				if(iter != streams.end())
+				{
+					// Trailers are decoded (shared HPACK state) but not used
+					RequestHeaderHandler trailers(nullptr);
+
+					if(!decoder.Decode(block, trailers)) ConnectionError(Http2ErrorCode::COMPRESSION_ERROR);
+					else if(iter->second.endReceived) StreamError(streamId, Http2ErrorCode::STREAM_CLOSED);
+					else if(!(flags & FLAG_END_STREAM)) StreamError(streamId, Http2ErrorCode::PROTOCOL_ERROR);
+					else RequestComplete(streamId, iter->second);
+
+					return;
+				}
+
+				// Closed streams can not be opened again
+				if(streamId <= lastStreamId)
+				{
+					ConnectionError(Http2ErrorCode::STREAM_CLOSED);
+					return;
+				}
+
+				lastStreamId = streamId;
+
+				// If no further stream is accepted ... decode the header block nevertheless (shared HPACK state)
+				if(goingAway || closing || streams.size() >= HTTP2_MAX_CONCURRENT_STREAMS)
+				{
+					RequestHeaderHandler refused(nullptr);
+
+					if(!decoder.Decode(block, refused)) ConnectionError(Http2ErrorCode::COMPRESSION_ERROR);
+					else QueueReset(streamId, Http2ErrorCode::REFUSED_STREAM);
+
+					return;
+				}
+
+				Stream & stream = CreateStream(streamId);
+				RequestHeaderHandler handler(stream.context.get());
+
+				if(!decoder.Decode(block, handler))
+				{
+					ConnectionError(Http2ErrorCode::COMPRESSION_ERROR);
+					return;
+				}
+				else if(handler.malformed || handler.method.IsEmpty() || handler.path.IsEmpty() || !handler.schemeSeen) //If a mandatory pseudo header field is missing (RFC 7540 Section 8.1.2.3)
+				{
+					StreamError(streamId, Http2ErrorCode::PROTOCOL_ERROR);
+					return;
+				}
+
+				HttpStatusCode stat = handler.size > HTTP2_MAX_HEADER_LIST_SIZE ? HttpStatusCode::REQUEST_HEADER_FIELDS_TOO_LARGE : stream.context->HandleRequestLine(HttpFunctions::ToHttpMethod(handler.method), handler.path);
+
+				if(stat == HttpStatusCode::OK && stream.context->request.ContentLengthIsSet() && stream.context->request.ContentLength() > MAX_BODY_LENGTH) stat = HttpStatusCode::REQUEST_ENTITY_TOO_LARGE;
+
+				// If the request is invalid ... answer immediately
+				// Else if there is no body ... process the request
+				if(stat != HttpStatusCode::OK) Respond(streamId, stream, stat);
+				else if(flags & FLAG_END_STREAM) RequestComplete(streamId, stream);
+				else
+				{
+					// Decide on the headers alone before the body is received
+					PeoplezString expect = stream.context->request.GetHeaderValue(HttpHeaderField::EXPECT);
+
+					expect.ToLower_ASCII();
+					expect.TrimFast();
+
+					if(!expect.IsEmpty() && !expect.EqualTo("100-continue", 12)) Respond(streamId, stream, HttpStatusCode::EXPECTATION_FAILED);
+					else if(!requestHandler.AcceptHeaders(*stream.context.get())) SendResponse(streamId, stream);
+					else if(!expect.IsEmpty())
+					{
+						// Interim response without END_STREAM
+						PeoplezString block(4);
+						Hpack::AppendLiteral(block, Hpack::STATUS, "100", 3);
+						QueueHeaders(streamId, block, false);
+					}
+				}
+			}
+
+			void Http2Connection::RequestComplete(uint32_t const streamId, Stream & stream)
+			{
+				HttpContext & context = *stream.context.get();
+
+				// The body must match the content-length (RFC 7540 Section 8.1.2.6)
+				if(context.request.ContentLengthIsSet() && stream.received != context.request.ContentLength())
+				{
+					StreamError(streamId, Http2ErrorCode::PROTOCOL_ERROR);
+					return;
+				}
+
+				stream.endReceived = true;
+
+				// If the request is answered already (e.g. body too large)
+				if(stream.responding) return;
+
+				HttpStatusCode stat = HttpStatusCode::OK;
+
+				// Extract post parameters
+				if(!context.BodyBuffer.IsEmpty() || context.request.HttpMethod() == HttpMethods::POST || context.request.HttpMethod() == HttpMethods::PUT) stat = context.HandleBody(context.BodyBuffer);
+
+				Respond(streamId, stream, stat);
+			}
+
+			void Http2Connection::Respond(uint32_t const streamId, Stream & stream, HttpStatusCode const error)
+			{
+				HttpContext & context = *stream.context.get();
+				HttpResponse & response = context.response;
+				HttpMethods const method = context.request.HttpMethod();
+
+				if(error != HttpStatusCode::OK) response.SetOther(error);
+				else if(method == HttpMethods::UNKNOWN) response.SetOther(HttpStatusCode::NOT_IMPLEMENTED);
+				else
+				{
+					try
+					{
+						requestHandler.ProcessRequest(context);
+
+						// If the handler completes the response later ... send it in Resume
+						if(context.Park()) return;
+					}
+					catch(...)
+					{
+						Logger::LogException("Error in Http2Connection::Respond", __FILE__, __LINE__);
+						response.SetOther(HttpStatusCode::INTERNAL_SERVER_ERROR);
+					}
+				}
+
+				SendResponse(streamId, stream);
+			}
+
+			void Http2Connection::SendResponse(uint32_t const streamId, Stream & stream)
+			{
+				HttpContext & context = *stream.context.get();
+				HttpResponse & response = context.response;
+				// Responses to HEAD requests only consist of the header fields (RFC 9110 Section 9.3.2)
+				bool const withBody = context.request.HttpMethod() != HttpMethods::HEAD && response.statusCode != HttpStatusCode::NOT_MODIFIED && (response.stream || !response.data.IsEmpty());
+
+				QueueHeaders(streamId, EncodeHeaders(response), !withBody);
+				stream.responding = true;
+
+				// Body is sent by PumpData within the flow control windows
+				if(withBody)
+				{
+					stream.pending = response.data;
+					context.ResponseStream = response.stream;
+				}
+				else stream.finished = true;
+			}
+
+			void Http2Connection::Resume(uint32_t const streamId) noexcept
+			{
+				try
+				{
+					{
+						std::unique_lock<std::mutex> const lock(resumeMutex);
+						resumes.push_back(streamId);
+					}
+
+					// If called by a handler of this connection (mut held by this thread) ... continued by Lock
+					if(owner.load() == std::this_thread::get_id()) return;
+
+					ResumeQueued();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in Http2Connection::Resume", __FILE__, __LINE__);
+				}
+			}
+
+			void Http2Connection::ResumeQueued() noexcept
+			{
+				try
+				{
+					for(;;)
+					{
+						// Checked after releasing mut, so no stream is left behind
+						{
+							std::unique_lock<std::mutex> const lock(resumeMutex);
+							if(resumes.empty()) return;
+						}
+
+						std::unique_lock<std::mutex> lock(mut, std::try_to_lock);
+
+						// If another thread holds the connection ... it continues the streams after releasing it
+						if(!lock.owns_lock()) return;
+
+						std::vector<uint32_t> streamIds;
+
+						{
+							std::unique_lock<std::mutex> const resumeLock(resumeMutex);
+							streamIds.swap(resumes);
+						}
+
+						owner = std::this_thread::get_id();
+
+						try
+						{
+							for(uint32_t const streamId : streamIds) ResumeInner(streamId);
+						}
+						catch(...)
+						{
+							Logger::LogException("Error in Http2Connection::ResumeQueued", __FILE__, __LINE__);
+						}
+
+						owner = std::thread::id();
+					}
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in Http2Connection::ResumeQueued", __FILE__, __LINE__);
+				}
+			}
+
+			void Http2Connection::ResumeInner(uint32_t const streamId)
+			{
+				std::map<uint32_t, Stream>::iterator const iter = streams.find(streamId);
+
+				if(iter == streams.end()) return;
+
+				// If a deferred response was completed ... send it
+				if(!iter->second.responding)
+				{
+					if(iter->second.context->Unpark())
+					{
+						SendResponse(streamId, iter->second);
+						Flush();
+					}
+
+					return;
+				}
+
+				if(!iter->second.context->ResponsePaused) return;
+
+				// Ask response stream again (in PumpData)
+				iter->second.context->ResponsePaused = false;
+				Flush();
+			}
+
+			Http2Connection::Lock::Lock(Http2Connection & _connection) : connection(_connection)
+			{
+				connection.mut.lock();
+				connection.owner = std::this_thread::get_id();
+			}
+
+			Http2Connection::Lock::~Lock()
+			{
+				connection.owner = std::thread::id();
+				connection.mut.unlock();
+
+				// Streams resumed while holding mut (by this or other threads)
+				connection.ResumeQueued();
+			}
+
+			bool Http2Connection::PumpData()
+			{
+				bool queued = false;
+				bool progress = true;
+
+				// One frame per stream and pass (round robin) until enough is queued or nothing can be sent
+				while(progress && queuedBytes < HTTP2_SEND_BUFFER_SIZE)
+				{
+					progress = false;
+
+					for(std::map<uint32_t, Stream>::iterator iter = streams.begin(); iter != streams.end();)
+					{
+						Stream & stream = iter->second;
+						HttpContext & context = *stream.context.get();
+
+						if(stream.responding && !stream.finished)
+						{
+							// Fetch the next chunk of a streamed body
+							if(stream.pending.IsEmpty() && context.ResponseStream && !context.ResponsePaused)
+							{
+								HttpResponseStreamStatus const status = context.ResponseStream->NextChunk(context, stream.pending);
+
+								if(status == HttpResponseStreamStatus::END) context.ResponseStream.reset();
+								else if(status == HttpResponseStreamStatus::WAIT) context.ResponsePaused = true;
+							}
+
+							size_t const length = (size_t)std::max<int64_t>(0, std::min<int64_t>({(int64_t)stream.pending.Length(), stream.sendWindow, sendWindow, (int64_t)maxSendFrameSize}));
+							bool const last = !context.ResponseStream && length == stream.pending.Length();
+
+							if(length || last)
+							{
+								QueueFrame(Http2FrameType::DATA, last ? FLAG_END_STREAM : 0, iter->first, length < stream.pending.Length() ? stream.pending.Substring(0, length) : stream.pending);
+
+								if(length < stream.pending.Length()) stream.pending <<= length;
+								else stream.pending.Clear();
+
+								stream.sendWindow -= length;
+								sendWindow -= length;
+								stream.finished = last;
+								progress = queued = true;
+							}
+						}
+
+						// Remove completed streams
+						if(stream.finished)
+						{
+							// The rest of the request is not needed any more (RFC 7540 Section 8.1)
+							if(!stream.endReceived) QueueReset(iter->first, Http2ErrorCode::NO_ERROR);
+
+							iter = streams.erase(iter);
+						}
+						else ++iter;
+					}
+				}
+
+				return queued;
+			}
+
+			void Http2Connection::Flush()
+			{
+				// While everything could be sent ...
+				while(SendInner())
+				{
+					// Close the connection after GOAWAY is sent or if the client is done with it
+					if(closing || (goingAway && streams.empty()))
+					{
+						sender->Close();
+						return;
+					}
+
+					bool const queued = PumpData();
+
+					// Continue reading if it was stopped because of a full queue (edge-triggered: no new event will come)
+					if(receiveThrottled) ReceiveInner();
+
+					// Nothing more to send
+					if(!queued && outputQueue.empty()) return;
+				}
+			}
+
+			void Http2Connection::ReceiveInner()
+			{
+				// Reserve memory for receiving
+				char buf[INPUT_BUFFER_STEP_SIZE];
+
+				receiveThrottled = false;
+
+				while(sender->IsOpen() && !closing)
+				{
+					// If the client does not read the responses ... leave its requests in the socket
+					if(queuedBytes >= HTTP2_SEND_BUFFER_SIZE)
+					{
+						receiveThrottled = true;
+						break;
+					}
+
+					int const bytes = sender->Recv(buf, INPUT_BUFFER_STEP_SIZE);
+
+					if(bytes > 0)
+					{
+						input.Append(buf, bytes);
+						ProcessInput();
+					}
+					else
+					{
+						// Log error (if not EAGAIN)
+						if(bytes < 0 && errno != EAGAIN)
+						{
+							Logger::LogException("Error while reading http/2 frames", __FILE__, __LINE__);
+							Logger::LogException(strerror(errno), __FILE__, __LINE__);
+						}
+
+						break;
+					}
+				}
+			}
+
+			bool Http2Connection::SendInner()
+			{
+				while(!outputQueue.empty())
+				{
+					// Collect queued frames
+					iovec iov[HTTP2_IOV_BATCH];
+					size_t const count = std::min<size_t>(outputQueue.size(), HTTP2_IOV_BATCH);
+
+					for(size_t i = 0; i < count; ++i)
+					{
+						iov[i].iov_base = (void *) outputQueue[i].GetData();
+						iov[i].iov_len = outputQueue[i].Length();
+					}
+
+					// Send them at once
+					int const sent = sender->SendV(iov, (int)count);
+
+					// If an error occured while sending ...
+					//   Log an error (if not EAGAIN)
+					if(__builtin_expect(sent < 0, false))
+					{
+						if(errno != EAGAIN) Logger::LogEvent("Error while writing");
+						return false;
+					}
+
+					// Remove completely sent frames and the sent part of the next one
+					size_t remaining = sent;
+					size_t done = 0;
+
+					queuedBytes -= sent;
+
+					for(; done < count && remaining >= iov[done].iov_len; ++done) remaining -= iov[done].iov_len;
+
+					if(done < count) outputQueue[done] <<= remaining;
+					outputQueue.erase(outputQueue.begin(), outputQueue.begin() + done);
+
+					// If not everything could be sent ... wait for MessageSendable
+					if(done < count) return false;
+				}
+
+				return true;
+			}
+
+			void Http2Connection::QueueFrame(Http2FrameType const type, uint8_t const flags, uint32_t const streamId, PeoplezString const & payload)
+			{
+				bool const copy = payload.Length() <= SMALL_PAYLOAD_SIZE;
+				PeoplezString frame(FRAME_HEADER_LENGTH + (copy ? payload.Length() : 0));
+				char header[FRAME_HEADER_LENGTH];
+
+				header[0] = (char)(payload.Length() >> 16);
+				header[1] = (char)(payload.Length() >> 8);
+				header[2] = (char)payload.Length();
+				header[3] = (char)type;
+				header[4] = (char)flags;
+				WriteUInt32(header + 5, streamId);
+
+				frame.Append(header, FRAME_HEADER_LENGTH);
+
+				if(copy) frame.Append(payload);
+
+				outputQueue.push_back(frame);
+				if(!copy) outputQueue.push_back(payload);
+
+				queuedBytes += FRAME_HEADER_LENGTH + payload.Length();
+			}
+
+			void Http2Connection::QueueFrame(Http2FrameType const type, uint8_t const flags, uint32_t const streamId, char const * const payload, size_t const len)
+			{
+				QueueFrame(type, flags, streamId, len ? PeoplezString(payload, len) : PeoplezString());
+			}
+
+			void Http2Connection::QueueHeaders(uint32_t const streamId, PeoplezString const & block, bool const endStream)
+			{
+				size_t pos = 0;
+
+				// First fragment in HEADERS, the rest in CONTINUATION frames
+				do
+				{
+					size_t const length = std::min<size_t>(block.Length() - pos, maxSendFrameSize);
+					uint8_t flags = pos + length == block.Length() ? FLAG_END_HEADERS : 0;
+
+					if(!pos && endStream) flags |= FLAG_END_STREAM;
+
+					QueueFrame(pos ? Http2FrameType::CONTINUATION : Http2FrameType::HEADERS, flags, streamId, block.Substring(pos, length));
+					pos += length;
+				}
+				while(pos < block.Length());
+			}
+
+			void Http2Connection::QueuePreface()
+			{
+				char settings[18];
+
+				WriteSetting(settings, SETTINGS_MAX_CONCURRENT_STREAMS, HTTP2_MAX_CONCURRENT_STREAMS);
+				WriteSetting(settings + 6, SETTINGS_INITIAL_WINDOW_SIZE, HTTP2_RECEIVE_WINDOW);
+				WriteSetting(settings + 12, SETTINGS_MAX_HEADER_LIST_SIZE, HTTP2_MAX_HEADER_LIST_SIZE);
+
+				QueueFrame(Http2FrameType::SETTINGS, 0, 0, settings, sizeof(settings));
+
+				// Initial connection window can not be changed by SETTINGS
+				if(HTTP2_RECEIVE_WINDOW > DEFAULT_WINDOW)
+				{
+					char increment[4];
+					WriteUInt32(increment, (uint32_t)(HTTP2_RECEIVE_WINDOW - DEFAULT_WINDOW));
+					QueueFrame(Http2FrameType::WINDOW_UPDATE, 0, 0, increment, 4);
+				}
+
+				receiveWindow = HTTP2_RECEIVE_WINDOW;
+			}
+
+			void Http2Connection::QueueReset(uint32_t const streamId, Http2ErrorCode const code)
+			{
+				char payload[4];
+				WriteUInt32(payload, (uint32_t)code);
+
+				QueueFrame(Http2FrameType::RST_STREAM, 0, streamId, payload, 4);
+			}
+
+			void Http2Connection::StreamError(uint32_t const streamId, Http2ErrorCode const code)
+			{
+				QueueReset(streamId, code);
+				streams.erase(streamId);
+			}
+
+			void Http2Connection::ConnectionError(Http2ErrorCode const code)
+			{
+				if(closing) return;
+
+				Logger::LogEvent("HTTP/2 connection error");
+
+				char payload[8];
+				WriteUInt32(payload, lastStreamId);
+				WriteUInt32(payload + 4, (uint32_t)code);
+
+				QueueFrame(Http2FrameType::GOAWAY, 0, 0, payload, 8);
+
+				// Nothing more is processed
+				closing = true;
+				input.Clear();
+			}
+
+			PeoplezString Http2Connection::EncodeHeaders(HttpResponse & response)
+			{
+				PeoplezString block(64 + response.contentType.Length() + response.redirectLocation.Length());
+
+				// Status codes of the static table are indexed
+				switch(response.statusCode)
+				{
+				case HttpStatusCode::OK:
+					Hpack::AppendIndexed(block, Hpack::STATUS_200);
+					break;
+				case HttpStatusCode::NO_CONTENT:
+					Hpack::AppendIndexed(block, Hpack::STATUS_204);
+					break;
+				case HttpStatusCode::PARTIAL_CONTENT:
+					Hpack::AppendIndexed(block, Hpack::STATUS_206);
+					break;
+				case HttpStatusCode::NOT_MODIFIED:
+					Hpack::AppendIndexed(block, Hpack::STATUS_304);
+					break;
+				case HttpStatusCode::BAD_REQUEST:
+					Hpack::AppendIndexed(block, Hpack::STATUS_400);
+					break;
+				case HttpStatusCode::NOT_FOUND:
+					Hpack::AppendIndexed(block, Hpack::STATUS_404);
+					break;
+				case HttpStatusCode::INTERNAL_SERVER_ERROR:
+					Hpack::AppendIndexed(block, Hpack::STATUS_500);
+					break;
+				default:
+				{
+					PeoplezString const status = PeoplezString::ParseDec((unsigned int)response.statusCode);
+					Hpack::AppendLiteral(block, Hpack::STATUS, status.GetData(), status.Length());
+					break;
+				}
+				}
+
+				// Current date of the per second cache of the HTTP/1.1 header block ("\r\nDate: <date>...")
+				Hpack::AppendLiteral(block, Hpack::DATE, HttpResponse::GetConnectionHeaders(true).first + 8, HttpFunctions::HTTP_DATE_LENGTH);
+
+				if(response.IsRedict()) Hpack::AppendLiteral(block, Hpack::LOCATION, response.redirectLocation.GetData(), response.redirectLocation.Length());
+				else if(response.eTag != 0)
+				{
+					PeoplezString eTag(2 + (sizeof(response.eTag) << 1));
+					eTag.Append("\"", 1);
+					eTag.Append(PeoplezString::ParseHex(response.eTag));
+					eTag.Append("\"", 1);
+					Hpack::AppendLiteral(block, Hpack::ETAG, eTag.GetData(), eTag.Length());
+				}
+
+				if(response.lastModified)
+				{
+					char date[HttpFunctions::HTTP_DATE_LENGTH];
+					HttpFunctions::FormatHttpDate(response.lastModified, date);
+
+					Hpack::AppendLiteral(block, Hpack::LAST_MODIFIED, date, HttpFunctions::HTTP_DATE_LENGTH);
+				}
+
+				if(response.statusCode != HttpStatusCode::NOT_MODIFIED)
+				{
+					Hpack::AppendLiteral(block, Hpack::CONTENT_TYPE, response.contentType.GetData(), response.contentType.Length());
+
+					if(response.compression == HTTP_COMPRESSION_GZIP) Hpack::AppendLiteral(block, Hpack::CONTENT_ENCODING, "gzip", 4);
+					else if(response.compression == HTTP_COMPRESSION_DEFLATE) Hpack::AppendLiteral(block, Hpack::CONTENT_ENCODING, "deflate", 7);
+					else if(response.compression == HTTP_COMPRESSION_BROTLI) Hpack::AppendLiteral(block, Hpack::CONTENT_ENCODING, "br", 2);
+					else if(response.compression == HTTP_COMPRESSION_ZSTD) Hpack::AppendLiteral(block, Hpack::CONTENT_ENCODING, "zstd", 4);
+
+					// Streamed bodies end with END_STREAM (no chunked coding in HTTP/2)
+					if(!response.stream)
+					{
+						PeoplezString const length = PeoplezString::ParseDec(response.data.Length());
+						Hpack::AppendLiteral(block, Hpack::CONTENT_LENGTH, length.GetData(), length.Length());
+					}
+
+					if(!response.contentRange.IsEmpty()) Hpack::AppendLiteral(block, Hpack::CONTENT_RANGE, response.contentRange.GetData(), response.contentRange.Length());
+				}
+
+				if(response.acceptRanges) Hpack::AppendLiteral(block, Hpack::ACCEPT_RANGES, "bytes", 5);
+				if(response.varyEncoding) Hpack::AppendLiteral(block, Hpack::VARY, "accept-encoding", 15);
+
+				for(std::list<HttpCookie>::const_iterator iter = response.Cookies.begin(); iter != response.Cookies.end(); ++iter)
+				{
+					// Without "Set-Cookie: "
+					PeoplezString const cookie = iter->ToString();
+					if(cookie.Length() > 12) Hpack::AppendLiteral(block, Hpack::SET_COOKIE, cookie.GetData() + 12, cookie.Length() - 12);
+				}
+
+				for(HttpHeaderList::ConstIterator iter = response.Headers.begin(); iter != response.Headers.end(); ++iter)
+				{
+					// Header field names are lower case in HTTP/2 (RFC 7540 Section 8.1.2)
+					PeoplezString name(iter->first.GetData(), iter->first.Length());
+					PeoplezString value = iter->second;
+
+					name.ToLower_ASCII_NU();
+					value.TrimFast();
+
+					Hpack::AppendLiteral(block, name, value);
+				}
+
+				return block;
+			}
+
+			Http2Connection::~Http2Connection()
+			{
+				// Abort open streams before the socket is gone
+				streams.clear();
+
+				if(ownsSender) delete sender;
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,422 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTP2CONNECTION_HPP_
+#define PEOPLEZ_SERVICES_HTTP_HTTP2CONNECTION_HPP_
+
+// Local includes
+#include "../../System/IO/Network/Socket.hpp"
+#include "../../String/PeoplezString.hpp"
+#include "Hpack.hpp"
+#include "HttpContext.hpp"
+#include "HttpRequestHandler.hpp"
+
+// Extern includes
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Frame types of HTTP/2 (RFC 7540 Section 6)
+			 */
+			enum class Http2FrameType : uint8_t
+			{
+				DATA = 0x0,
+				HEADERS = 0x1,
+				PRIORITY = 0x2,
+				RST_STREAM = 0x3,
+				SETTINGS = 0x4,
+				PUSH_PROMISE = 0x5,
+				PING = 0x6,
+				GOAWAY = 0x7,
+				WINDOW_UPDATE = 0x8,
+				CONTINUATION = 0x9
+			};
+
+			/**
+			 * @brief Error codes of HTTP/2 (RFC 7540 Section 7)
+			 */
+			enum class Http2ErrorCode : uint32_t
+			{
+				NO_ERROR = 0x0,
+				PROTOCOL_ERROR = 0x1,
+				INTERNAL_ERROR = 0x2,
+				FLOW_CONTROL_ERROR = 0x3,
+				SETTINGS_TIMEOUT = 0x4,
+				STREAM_CLOSED = 0x5,
+				FRAME_SIZE_ERROR = 0x6,
+				REFUSED_STREAM = 0x7,
+				CANCEL = 0x8,
+				COMPRESSION_ERROR = 0x9,
+				CONNECT_ERROR = 0xA,
+				ENHANCE_YOUR_CALM = 0xB,
+				INADEQUATE_SECURITY = 0xC,
+				HTTP_1_1_REQUIRED = 0xD
+			};
+
+			/**
+			 * @brief HTTP/2 connection (RFC 7540) on an established socket
+			 *
+			 * @details
+			 * Every stream gets its own HttpContext that is passed to HttpRequestHandler::ProcessRequest as soon as the request is complete,
+			 * so request handlers work unchanged. Responses are sent as HPACK coded HEADERS and DATA frames within the flow control windows
+			 * of the client. Bodies of streamed responses (HttpResponseStream) are fetched when the windows allow sending them.
+			 * Used by Http2ClientInfo (ALPN "h2") and by HttpClientInfo after the client preface or an upgrade to h2c.
+			 */
+			class Http2Connection final : public std::enable_shared_from_this<Http2Connection>
+			{
+			public:
+				/**
+				 * @brief Client connection preface (RFC 7540 Section 3.5)
+				 */
+				static constexpr char const * PREFACE = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+				/**
+				 * @brief Length of the client connection preface
+				 */
+				static constexpr size_t PREFACE_LENGTH = 24;
+
+				/**
+				 * Constructor
+				 *
+				 * @param requestHandler Handler that processes the requests of all streams
+				 * @param sender Socket of the connection (owned by the connection after Start or a successful Upgrade)
+				 */
+				Http2Connection(HttpRequestHandler & requestHandler, System::IO::Network::Socket * sender);
+				/**
+				 * Starts the connection by queueing the server preface
+				 *
+				 * @param received Data that was already received (beginning with the client preface)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void Start(String::PeoplezString const & received) noexcept;
+				/**
+				 * Takes over an http/1.1 connection whose request asked for an upgrade to h2c (RFC 7540 Section 3.2)
+				 *
+				 * The pending responses of the connection, "101 Switching Protocols" and the server preface are queued.
+				 * The upgrade request is answered on stream 1.
+				 *
+				 * @param base Context of the http/1.1 connection (the header of the upgrade request is handled already)
+				 *
+				 * @return false if the HTTP2-Settings header is invalid (nothing is changed then)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				bool Upgrade(HttpContext & base) noexcept;
+				/**
+				 * Reads from the socket until it would block and sends the responses afterwards
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void MessageReceivable() noexcept;
+				/**
+				 * Continues sending after the socket became writable
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void MessageSendable() noexcept;
+				/**
+				 * Indicates that a complete request is not answered completely yet (e.g. a deferred or streamed response)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				bool IsResponding() noexcept;
+				/**
+				 * Destructor
+				 */
+				~Http2Connection();
+
+			private:
+				/**
+				 * @brief State of a stream
+				 */
+				struct Stream
+				{
+					/**
+					 * @brief Request and response of the stream
+					 */
+					std::shared_ptr<HttpContext> context;
+					/**
+					 * @brief Number of bytes that may be sent on the stream
+					 */
+					int64_t sendWindow;
+					/**
+					 * @brief Number of bytes the client may send on the stream
+					 */
+					int64_t receiveWindow;
+					/**
+					 * @brief Number of body bytes received (without padding)
+					 */
+					uint64_t received;
+					/**
+					 * @brief Indicates that the request is complete (half-closed remote)
+					 */
+					bool endReceived;
+					/**
+					 * @brief Indicates that the response headers are queued
+					 */
+					bool responding;
+					/**
+					 * @brief Indicates that the last frame of the response is queued
+					 */
+					bool finished;
+					/**
+					 * @brief Part of the response body that is not queued yet
+					 */
+					String::PeoplezString pending;
+				};
+
+				/**
+				 * @brief Holds mut and continues the streams that were resumed meanwhile after releasing it
+				 */
+				class Lock final
+				{
+				public:
+					explicit Lock(Http2Connection & connection);
+					~Lock();
+
+				private:
+					Lock(Lock const & other) = delete;
+					Lock & operator=(Lock const & other) = delete;
+
+					Http2Connection & connection;
+				};
+
+				Http2Connection(Http2Connection const & other) = delete;
+
+				/**
+				 * Creates a stream with a new HttpContext
+				 */
+				Stream & CreateStream(uint32_t streamId);
+				/**
+				 * Parses and handles all complete frames in the input buffer
+				 */
+				void ProcessInput();
+				/**
+				 * Handles a complete frame
+				 */
+				void HandleFrame(Http2FrameType type, uint8_t flags, uint32_t streamId, String::PeoplezString const & payload);
+				void HandleData(uint8_t flags, uint32_t streamId, String::PeoplezString const & payload);
+				void HandleHeaders(uint8_t flags, uint32_t streamId, String::PeoplezString const & payload);
+				void HandleSettings(uint8_t flags, uint32_t streamId, String::PeoplezString const & payload);
+				void HandleWindowUpdate(uint32_t streamId, String::PeoplezString const & payload);
+				/**
+				 * Applies the settings of the client
+				 *
+				 * @return NO_ERROR if all settings are valid
+				 */
+				Http2ErrorCode ApplySettings(String::PeoplezString const & payload);
+				/**
+				 * Decodes a complete header block and opens the stream
+				 */
+				void HeaderBlockReceived(uint32_t streamId, uint8_t flags, String::PeoplezString const & block);
+				/**
+				 * Handles the body of a complete request and responds
+				 */
+				void RequestComplete(uint32_t streamId, Stream & stream);
+				/**
+				 * Processes the request of the stream (or responds with an error) and queues the response headers
+				 *
+				 * @param error Status code of an error response; OK to process the request
+				 */
+				void Respond(uint32_t streamId, Stream & stream, HttpStatusCode error);
+				/**
+				 * Queues the headers of the response that is set in the context of the stream and prepares sending its body
+				 */
+				void SendResponse(uint32_t streamId, Stream & stream);
+				/**
+				 * Continues a stream whose HttpResponseStream returned WAIT or whose deferred response was completed
+				 *
+				 * The stream is only queued; it is continued by the thread that holds mut after releasing it.
+				 * So handlers may resume streams of the connection they are called by (e.g. HttpCompletion::Complete or EventChannel::Publish).
+				 */
+				void Resume(uint32_t streamId) noexcept;
+				/**
+				 * Continues the queued streams unless another thread holds mut (that continues them after releasing it)
+				 */
+				void ResumeQueued() noexcept;
+				/**
+				 * Continues a stream (mut has to be held)
+				 */
+				void ResumeInner(uint32_t streamId);
+				/**
+				 * Queues DATA frames of the responses within the flow control windows (round robin over the streams)
+				 *
+				 * @return Indicates whether anything was queued
+				 */
+				bool PumpData();
+				/**
+				 * Sends the output queue, continues the responses and closes the connection if it is done
+				 */
+				void Flush();
+				/**
+				 * Reads from the socket until it would block or the output queue is full
+				 */
+				void ReceiveInner();
+				/**
+				 * Writes as much of the output queue as possible with a single gather write
+				 *
+				 * @return Indicates whether the output queue is empty now
+				 */
+				bool SendInner();
+				/**
+				 * Queues a frame
+				 *
+				 * Large payloads are queued as a separate buffer (not copied).
+				 */
+				void QueueFrame(Http2FrameType type, uint8_t flags, uint32_t streamId, String::PeoplezString const & payload);
+				/**
+				 * Queues a frame with a small payload
+				 */
+				void QueueFrame(Http2FrameType type, uint8_t flags, uint32_t streamId, char const * payload, size_t len);
+				/**
+				 * Queues a header block (split into HEADERS and CONTINUATION frames)
+				 */
+				void QueueHeaders(uint32_t streamId, String::PeoplezString const & block, bool endStream);
+				/**
+				 * Queues the server preface (SETTINGS) and enlarges the connection window
+				 */
+				void QueuePreface();
+				/**
+				 * Queues a RST_STREAM frame
+				 */
+				void QueueReset(uint32_t streamId, Http2ErrorCode code);
+				/**
+				 * Queues a RST_STREAM frame and removes the stream
+				 */
+				void StreamError(uint32_t streamId, Http2ErrorCode code);
+				/**
+				 * Queues a GOAWAY frame and closes the connection after sending it
+				 */
+				void ConnectionError(Http2ErrorCode code);
+				/**
+				 * Encodes the header fields of a response
+				 *
+				 * @param response Response to encode
+				 *
+				 * @return HPACK header block
+				 */
+				static String::PeoplezString EncodeHeaders(HttpResponse & response);
+
+				HttpRequestHandler & requestHandler;
+				System::IO::Network::Socket * const sender;
+				std::mutex mut;
+				/**
+				 * @brief Thread that holds mut (via Lock)
+				 */
+				std::atomic<std::thread::id> owner;
+				/**
+				 * @brief Streams to continue after mut is released (see Resume)
+				 */
+				std::vector<uint32_t> resumes;
+				std::mutex resumeMutex;
+				HpackDecoder decoder;
+				/**
+				 * @brief Open streams (ordered by id)
+				 */
+				std::map<uint32_t, Stream> streams;
+				String::PeoplezString input;
+				/**
+				 * @brief Frames that are not (completely) sent yet
+				 */
+				std::vector<String::PeoplezString> outputQueue;
+				size_t queuedBytes;
+				/**
+				 * @brief Fragments of a header block that is continued by CONTINUATION frames
+				 */
+				String::PeoplezString headerBlock;
+				/**
+				 * @brief Stream of the incomplete header block (0 if none)
+				 */
+				uint32_t continuationStream;
+				uint8_t continuationFlags;
+				/**
+				 * @brief Highest stream id opened by the client
+				 */
+				uint32_t lastStreamId;
+				/**
+				 * @brief Connection flow control window for sending
+				 */
+				int64_t sendWindow;
+				/**
+				 * @brief Connection flow control window for receiving
+				 */
+				int64_t receiveWindow;
+				/**
+				 * @brief SETTINGS_INITIAL_WINDOW_SIZE of the client
+				 */
+				int64_t initialSendWindow;
+				/**
+				 * @brief SETTINGS_MAX_FRAME_SIZE of the client
+				 */
+				uint32_t maxSendFrameSize;
+				/**
+				 * @brief Indicates that the socket is deleted by the destructor
+				 */
+				bool ownsSender;
+				bool prefaceReceived;
+				/**
+				 * @brief Indicates that reading was stopped because of a full output queue
+				 */
+				bool receiveThrottled;
+				/**
+				 * @brief Indicates that the client sent GOAWAY (no new streams)
+				 */
+				bool goingAway;
+				/**
+				 * @brief Indicates that the connection is closed after the output queue is sent
+				 */
+				bool closing;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTP2CONNECTION_HPP_
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTPBODYSTREAMHANDLER_HPP_
+#define PEOPLEZ_SERVICES_HTTP_HTTPBODYSTREAMHANDLER_HPP_
+
+// Local includes
+#include "../../String/PeoplezString.hpp"
+
+// Extern includes
+#include <cstddef>
+#include <cstdint>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			class HttpContext;
+
+			/**
+			 * @brief Receives a request body in chunks while it arrives
+			 *
+			 * @details
+			 * Opt-in alternative to the buffered body (see HttpRequestHandler::GetBodyStreamHandler).
+			 * The body is not accumulated in the input buffer, so uploads are handled in constant memory.
+			 * If a chunk is not consumed completely the connection stops reading from the socket until HttpContext::ResumeBody is called.
+			 * Note that the ConnectionsManager drops connections that stay inactive for too long.
+			 */
+			class HttpBodyStreamHandler
+			{
+			public:
+				/**
+				 * Maximum accepted body length for this handler (replaces MAX_BODY_LENGTH)
+				 *
+				 * @param context Context of the request (headers are available)
+				 *
+				 * @return Maximum body length in bytes
+				 */
+				virtual uint64_t MaxBodyLength(HttpContext const & context) const noexcept = 0;
+				/**
+				 * Handles the next chunk of the body
+				 *
+				 * Views of the chunk (e.g. parts of a MultipartFormDataParser) may be kept; the input buffer is copied on the next receive then.
+				 *
+				 * @param context Context of the request
+				 * @param chunk Next bytes of the body (view of the input buffer, not empty)
+				 *
+				 * @return Number of bytes consumed. Less than the chunk length pauses receiving until HttpContext::ResumeBody is called; the rest is offered again then.
+				 */
+				virtual size_t BodyChunkReceived(HttpContext & context, String::PeoplezString const & chunk) = 0;
+				/**
+				 * Called after the complete body was consumed. Has to set the response.
+				 *
+				 * @param context Context of the request
+				 */
+				virtual void BodyComplete(HttpContext & context) = 0;
+				/**
+				 * Called if the connection ends before the body was completely consumed
+				 *
+				 * @param context Context of the request
+				 */
+				virtual void BodyAborted(HttpContext & context) noexcept {}
+				virtual ~HttpBodyStreamHandler() {}
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTPBODYSTREAMHANDLER_HPP_
@@ -37,10 +37,18 @@
 #include "HttpClientInfo.hpp"
 
 // Local includes
+#include "../../System/IO/Network/SecureSocket.hpp"
 #include "../../System/Logging/Logger.hpp"
 #include "../../System/Resources/ResourceManager.hpp"
 #include "../../String/PeoplezString.hpp"
 
+// Extern includes
+#include <algorithm>
+extern "C"
+{
+#include <sys/uio.h>
+}
+
 /**
  * @def MAX_HEADER_LENGTH
  * @brief Maximum accepted length of the http header in bytes
@@ -57,6 +65,23 @@
  * @details Number of bytes that can be read in one step. To read on the buffer must be appended to the target string first.
  */
 #define INPUT_BUFFER_STEP_SIZE 2000
+/**
+ * @def PEOPLEZ_HTTP_PIPELINE_DEPTH
+ * @brief Maximum number of pipelined responses that are queued for one connection
+ * @details Requests that are already received are processed until this number of responses waits for sending.
+ * All queued responses are written with a single gather write. Set to 1 to disable pipelining.
+ */
+#ifndef PEOPLEZ_HTTP_PIPELINE_DEPTH
+#define PEOPLEZ_HTTP_PIPELINE_DEPTH 16
+#endif
+
+/**
+ * @def RESPONSE_STREAM_BUFFER_SIZE
+ * @brief Number of bytes of a streamed response that are queued before waiting for the socket to become writable
+ */
+#define RESPONSE_STREAM_BUFFER_SIZE 65536
+
+static_assert(PEOPLEZ_HTTP_PIPELINE_DEPTH > 0, "Pipeline depth has to be positive");
 
 namespace Peoplez
 {
@@ -70,6 +95,19 @@ namespace Peoplez
 		{
 			HttpClientInfo::HttpClientInfo(int const fileDescriptor, HttpRequestHandler & reqHandler, System::IO::Network::Socket * const _sender)
 				: ClientInfo(fileDescriptor >= 0 ? fileDescriptor : throw std::invalid_argument("Invalid file descriptor")), requestHandler(reqHandler), context(new HttpContext(_sender)), firstByte(0)
+			{
+				std::weak_ptr<HttpContext> const weakContext(context);
+
+				context->resume = [fileDescriptor, &reqHandler, weakContext]()
+				{
+					// If the connection still exists ... continue it
+					std::shared_ptr<HttpContext> const ctx = weakContext.lock();
+					if(ctx) HttpClientInfo(fileDescriptor, reqHandler, ctx).Resume();
+				};
+			}
+
+			HttpClientInfo::HttpClientInfo(int const fileDescriptor, HttpRequestHandler & reqHandler, std::shared_ptr<HttpContext> const & ctx) noexcept
+				: ClientInfo(fileDescriptor), requestHandler(reqHandler), context(ctx), firstByte(0)
 			{
 			}
 
@@ -89,7 +127,6 @@ namespace Peoplez
 						else
 						{
 							context->response.SetOther(stat);
-							context->OutputBuffer = context->response.GetResponseText();
 							SwitchToSend();
 						}
 					}
@@ -109,6 +146,17 @@ namespace Peoplez
 				// Else log error
 				if(context->Status == HTTP_SOCKET_STATUS_RECEIVE_HEADER)
 				{
+					// If the client starts with the HTTP/2 connection preface (prior knowledge) ... hand the connection over
+					if(context->OutputQueue.empty() && context->InputBuffer.BeginsWith(Http2Connection::PREFACE, 16))
+					{
+						std::shared_ptr<Http2Connection> const http2 = std::make_shared<Http2Connection>(requestHandler, context->sender);
+
+						context->Http2 = http2;
+						http2->Start(context->InputBuffer);
+						context->InputBuffer.Clear();
+						return;
+					}
+
 					// Search for end of header
 					size_t const dlPos = context->InputBuffer.FindDoubleNewLine(startPos > 4 ? startPos - 4 : 0);
 
@@ -125,13 +173,9 @@ namespace Peoplez
 						Logger::LogEvent("Request too long");
 
 						// Set error response
-						context->response.SetOther(HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
-
-						// And initiate disconnect
-						context->response.KeepAlive = false;
+						context->response.SetError(HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
 
 						// Send answer (error)
-						context->OutputBuffer = context->response.GetResponseText();
 						SwitchToSend();
 					}
 				}
@@ -150,11 +194,14 @@ namespace Peoplez
 						BodyReceived();
 					}
 				}
-				else if(context->Status == HTTP_SOCKET_STATUS_SEND)
+				else if(context->Status == HTTP_SOCKET_STATUS_RECEIVE_BODY_STREAM)
+				{
+					// Pass received data to stream handler (unless it is busy)
+					if(!context->BodyPaused) StreamBody();
+				}
+				else if(context->Status == HTTP_SOCKET_STATUS_SEND || context->Status == HTTP_SOCKET_STATUS_SEND_STREAM || context->Status == HTTP_SOCKET_STATUS_WAIT_RESPONSE)
 				{
-					//context->Status = HTTP_SOCKET_STATUS_RECEIVE_HEADER;
-					//Logger::LogException("Received in send mode", __FILE__, __LINE__);
-					//TODO Attacker could send huge amounts of data here
+					// Data stays in the input buffer until the pipeline continues (see ProcessPipeline)
 				}
 				else Logger::LogException("Received in unknown mode", __FILE__, __LINE__);
 			}
@@ -171,48 +218,102 @@ namespace Peoplez
 
 					if(stat == HttpStatusCode::OK) //If header is ok
 					{
-						if(context->request.HttpMethod() == HttpMethods::GET || context->request.HttpMethod() == HttpMethods::POST || context->request.HttpMethod() == HttpMethods::PUT) //If method is supported
+						if(context->request.HttpMethod() != HttpMethods::UNKNOWN) //If method is known (the request handler decides on it, e.g. HttpRouter)
 						{
-							if(context->request.ContentLengthIsSet()) //If body is needed
+							// If the client asks for HTTP/2 ... the request is answered on the upgraded connection
+							if(UpgradeToHttp2()) return;
+
+							bool expectContinue = false;
+
+							// If a body follows ... decide on the headers alone before it is read
+							if(context->request.IsChunked() || (context->request.ContentLengthIsSet() && context->request.ContentLength()))
+							{
+								PeoplezString expect = context->request.GetHeaderValue(HttpHeaderField::EXPECT);
+
+								if(!expect.IsEmpty())
+								{
+									expect.ToLower_ASCII();
+									expect.TrimFast();
+
+									if(!expect.EqualTo("100-continue", 12)) //If expectation is unknown
+									{
+										context->response.SetError(HttpStatusCode::EXPECTATION_FAILED);
+										SwitchToSend();
+										return;
+									}
+
+									// HTTP/1.0 clients do not know the interim response (RFC 9110 Section 10.1.1)
+									expectContinue = context->request.IsHttp11();
+								}
+
+								if(!requestHandler.AcceptHeaders(*context.get())) //If rejected by the handler ... send its response without reading the body
+								{
+									context->response.KeepAlive = false;
+									SwitchToSend();
+									return;
+								}
+							}
+
+							HttpBodyStreamHandler * const bodyStream = context->request.ContentLengthIsSet() || context->request.IsChunked() ? requestHandler.GetBodyStreamHandler(*context.get()) : nullptr;
+
+							if(bodyStream || context->request.IsChunked()) //If body is streamed or decoded while receiving
+							{
+								uint64_t const maxLength = bodyStream ? bodyStream->MaxBodyLength(*context.get()) : MAX_BODY_LENGTH;
+
+								if(context->request.ContentLengthIsSet() && context->request.ContentLength() > maxLength) //If message is too long
+								{
+									Logger::LogEvent("Request too long");
+									context->response.SetError(HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
+									SwitchToSend();
+								}
+								else
+								{
+									context->Status = HTTP_SOCKET_STATUS_RECEIVE_BODY_STREAM;
+									context->BodyStream = bodyStream;
+									context->BodyChunked = context->request.IsChunked();
+									context->BodyRemaining = context->BodyChunked ? maxLength : context->request.ContentLength();
+
+									// If the client waits for permission ... let it send the body
+									if(expectContinue && context->InputBuffer.IsEmpty()) QueueContinue();
+
+									StreamBody();
+								}
+							}
+							else if(context->request.ContentLengthIsSet()) //If body is needed
 							{
 								if(context->request.ContentLength() > MAX_BODY_LENGTH) //If message is too long
 								{
 									Logger::LogEvent("Request too long");
-									context->response.SetOther(HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
-									context->response.KeepAlive = false;
-									context->OutputBuffer = context->response.GetResponseText();
+									context->response.SetError(HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
 									SwitchToSend();
 								}
 								else if(context->request.ContentLength() > context->InputBuffer.Length()) //If body is not completely received
 								{
 									context->Status = HTTP_SOCKET_STATUS_RECEIVE_BODY;
 
+									// If the client waits for permission ... let it send the body
+									if(expectContinue && context->InputBuffer.IsEmpty()) QueueContinue();
+
 									if(context->request.ContentLength() > 2 * INPUT_BUFFER_STEP_SIZE) context->InputBuffer.Resize(context->request.ContentLength());
 								}
 								else BodyReceived(); //If body is completely received ... handle it
 							}
 							else if(context->request.HttpMethod() == HttpMethods::POST || context->request.HttpMethod() == HttpMethods::PUT) //If body would be needed
 							{
-								context->response.SetOther(HttpStatusCode::LENGTH_REQUIRED);
-								context->response.KeepAlive = false;
-								context->OutputBuffer = context->response.GetResponseText();
+								context->response.SetError(HttpStatusCode::LENGTH_REQUIRED);
 								SwitchToSend();
 							}
 							else MessageReady();
 						}
 						else
 						{
-							context->response.SetOther(HttpStatusCode::METHOD_NOT_ALLOWED);
-							context->response.KeepAlive = false;
-							context->OutputBuffer = context->response.GetResponseText();
+							context->response.SetError(HttpStatusCode::NOT_IMPLEMENTED);
 							SwitchToSend();
 						}
 					}
 					else
 					{
-						context->response.SetOther(stat);
-						context->response.KeepAlive = false;
-						context->OutputBuffer = context->response.GetResponseText();
+						context->response.SetError(stat);
 						SwitchToSend();
 					}
 				}
@@ -222,13 +323,90 @@ namespace Peoplez
 				}
 			}
 
+			void HttpClientInfo::QueueContinue()
+			{
+				// Interim response (sent by Flush before the final one)
+				context->OutputQueue.push_back(PeoplezString("HTTP/1.1 100 Continue\r\n\r\n", 25));
+			}
+
+			bool HttpClientInfo::UpgradeToHttp2()
+			{
+				// h2c is only used for cleartext connections (h2 is negotiated via ALPN)
+				if(dynamic_cast<System::IO::Network::SecureSocket *>(context->sender)) return false;
+
+				// Requests with body are answered with http/1.1
+				if(context->request.IsChunked() || (context->request.ContentLengthIsSet() && context->request.ContentLength())) return false;
+
+				{
+					PeoplezString upgrade = context->request.GetHeaderValue(HttpHeaderField::UPGRADE);
+					upgrade.ToLower_ASCII();
+					upgrade.TrimFast();
+
+					if(!upgrade.EqualTo("h2c", 3) || context->request.HeaderView(HttpHeaderField::HTTP2_SETTINGS).empty()) return false;
+				}
+
+				std::shared_ptr<Http2Connection> const http2 = std::make_shared<Http2Connection>(requestHandler, context->sender);
+
+				// If the settings are invalid ... continue with http/1.1
+				if(!http2->Upgrade(*context.get())) return false;
+
+				context->Http2 = http2;
+				return true;
+			}
+
+			bool HttpClientInfo::UpgradeToWebSocket()
+			{
+				std::shared_ptr<WebSocketConnection> const webSocket = std::make_shared<WebSocketConnection>(std::move(context->webSocketHandler), context->sender);
+
+				context->webSocketHandler.reset();
+
+				// If the connection can not be taken over ... answer with an error
+				if(!webSocket->Upgrade(*context.get(), context->webSocketProtocol))
+				{
+					context->response.SetError(HttpStatusCode::INTERNAL_SERVER_ERROR);
+					return false;
+				}
+
+				context->WebSocket = webSocket;
+				return true;
+			}
+
+			bool HttpClientInfo::StartEventStream()
+			{
+				std::shared_ptr<EventStream> const stream = std::move(context->eventStream);
+
+				context->eventStream.reset();
+
+				// If the connection can not be taken over ... answer with an error
+				if(!stream->Open(*context.get()))
+				{
+					context->response.SetError(HttpStatusCode::INTERNAL_SERVER_ERROR);
+					return false;
+				}
+
+				context->Events = stream;
+				return true;
+			}
+
 			void HttpClientInfo::MessageReady()
 			{
 				try
 				{
 					requestHandler.ProcessRequest(*context.get());
 
-					context->OutputBuffer = context->response.GetResponseText();
+					// If the handler accepted a WebSocket handshake ... the connection is taken over
+					if(context->webSocketHandler && UpgradeToWebSocket()) return;
+
+					// Same for an event stream
+					if(context->eventStream && StartEventStream()) return;
+
+					// If the handler completes the response later ... park the connection until Resume
+					if(context->Park())
+					{
+						context->Status = HTTP_SOCKET_STATUS_WAIT_RESPONSE;
+						return;
+					}
+
 					SwitchToSend();
 				}
 				catch(...)
@@ -237,21 +415,223 @@ namespace Peoplez
 				}
 			}
 
+			void HttpClientInfo::StreamBody()
+			{
+				try
+				{
+					// While body data is received and not consumed yet ...
+					while(!context->InputBuffer.IsEmpty())
+					{
+						size_t available;
+
+						if(context->BodyChunked)
+						{
+							// Skip chunk framing
+							context->InputBuffer <<= context->BodyDecoder.Parse(context->InputBuffer.GetData(), context->InputBuffer.Length());
+
+							if(context->BodyDecoder.HasFailed())
+							{
+								Logger::LogEvent("Invalid chunked body");
+								context->response.SetError(HttpStatusCode::BAD_REQUEST);
+								SwitchToSend();
+								return;
+							}
+
+							// Remaining input belongs to the next request
+							if(context->BodyDecoder.IsComplete()) break;
+
+							available = context->BodyDecoder.Available(context->InputBuffer.Length());
+
+							if(available > context->BodyRemaining)
+							{
+								Logger::LogEvent("Request too long");
+								context->response.SetError(HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
+								SwitchToSend();
+								return;
+							}
+						}
+						else available = std::min<uint64_t>(context->InputBuffer.Length(), context->BodyRemaining);
+
+						// If waiting for more input ...
+						if(!available) break;
+
+						PeoplezString const chunk = available < context->InputBuffer.Length() ? context->InputBuffer.Substring(0, available) : context->InputBuffer;
+						size_t consumed = available;
+
+						// Pass data to handler or collect it
+						if(context->BodyStream) consumed = std::min(context->BodyStream->BodyChunkReceived(*context.get(), chunk), available);
+						else context->BodyBuffer.Append(chunk);
+
+						// Remove consumed data
+						if(consumed < context->InputBuffer.Length()) context->InputBuffer <<= consumed;
+						else context->InputBuffer.Clear();
+
+						context->BodyRemaining -= consumed;
+						if(context->BodyChunked) context->BodyDecoder.Consume(consumed);
+
+						// If handler is busy ... pause receiving
+						if(consumed < available)
+						{
+							context->BodyPaused = true;
+							return;
+						}
+					}
+
+					// If complete body is consumed ... create the response
+					if(context->BodyChunked ? context->BodyDecoder.IsComplete() : !context->BodyRemaining)
+					{
+						if(context->BodyStream)
+						{
+							HttpBodyStreamHandler * const bodyStream = context->BodyStream;
+							context->BodyStream = nullptr;
+
+							bodyStream->BodyComplete(*context.get());
+
+							SwitchToSend();
+						}
+						else
+						{
+							HttpStatusCode const stat = context->HandleBody(context->BodyBuffer);
+
+							if(stat == HttpStatusCode::OK) MessageReady();
+							else
+							{
+								context->response.SetOther(stat);
+								SwitchToSend();
+							}
+						}
+					}
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HttpClientInfo::StreamBody", __FILE__, __LINE__);
+				}
+			}
+
+			bool HttpClientInfo::PumpResponse()
+			{
+				size_t queued = 0;
+
+				// Until enough is queued for the socket ...
+				while(queued < RESPONSE_STREAM_BUFFER_SIZE)
+				{
+					PeoplezString chunk;
+					HttpResponseStreamStatus const status = context->ResponseStream->NextChunk(*context.get(), chunk);
+
+					if(!chunk.IsEmpty())
+					{
+						// Chunk size line (after the line break that ends the previous chunk)
+						PeoplezString header(22);
+						if(context->ResponseChunkSent) header.Append("\r\n", 2);
+						header.Append(PeoplezString::ParseHex(chunk.Length()));
+						header.Append("\r\n", 2);
+
+						queued += header.Length() + chunk.Length();
+						context->OutputQueue.push_back(header);
+						context->OutputQueue.push_back(chunk);
+						context->ResponseChunkSent = true;
+					}
+
+					if(status == HttpResponseStreamStatus::END)
+					{
+						// Last chunk
+						if(context->ResponseChunkSent) context->OutputQueue.push_back(PeoplezString("\r\n0\r\n\r\n", 7));
+						else context->OutputQueue.push_back(PeoplezString("0\r\n\r\n", 5));
+
+						context->ResponseStream.reset();
+						context->Status = HTTP_SOCKET_STATUS_SEND;
+						return true;
+					}
+					else if(status == HttpResponseStreamStatus::WAIT)
+					{
+						context->ResponsePaused = true;
+						break;
+					}
+				}
+
+				return queued > 0;
+			}
+
+			void HttpClientInfo::Resume()
+			{
+				try
+				{
+					std::unique_lock<std::mutex> const lock(context->mut);
+
+					// If a deferred response was completed ... send it and continue with the pipeline (in Flush)
+					if(context->Status == HTTP_SOCKET_STATUS_WAIT_RESPONSE && context->Unpark())
+					{
+						SwitchToSend();
+						Flush();
+						return;
+					}
+
+					if(!context->BodyPaused && !context->ResponsePaused) return;
+
+					if(context->BodyPaused)
+					{
+						// Offer the rest of the body again
+						context->BodyPaused = false;
+						StreamBody();
+
+						// Continue connection
+						ProcessPipeline();
+						if(context->ReceiveThrottled) ReceiveInner();
+					}
+
+					// Ask response stream again (in Flush)
+					context->ResponsePaused = false;
+					Flush();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HttpClientInfo::Resume", __FILE__, __LINE__);
+				}
+			}
+
 			void HttpClientInfo::MessageReceivableCB()
 			{
 				// fd >= 0 ensured by constructor
 
 				try
 				{
-					// Reserve memory for receiving
-					char buf[INPUT_BUFFER_STEP_SIZE];
-
 					// Lock the context while receiving
-					std::unique_lock<std::mutex> const lock(context->mut);
+					std::unique_lock<std::mutex> lock(context->mut);
+
+					// If the connection was upgraded to HTTP/2 ... it is handled there
+					if(context->Http2)
+					{
+						std::shared_ptr<Http2Connection> const http2 = context->Http2;
+
+						lock.unlock();
+						http2->MessageReceivable();
+						return;
+					}
+
+					// Same for WebSocket connections
+					if(context->WebSocket)
+					{
+						std::shared_ptr<WebSocketConnection> const webSocket = context->WebSocket;
+
+						lock.unlock();
+						webSocket->MessageReceivable();
+						return;
+					}
+
+					// And event streams
+					if(context->Events)
+					{
+						std::shared_ptr<EventStream> const stream = context->Events;
+
+						lock.unlock();
+						stream->MessageReceivable();
+						return;
+					}
 
 					// If no bytes received so far ...
+					// Else if waiting for the rest of a request ...
 					if(context->InputBuffer.IsEmpty()) firstByte = time(0);
-					else
+					else if(context->Status == HTTP_SOCKET_STATUS_RECEIVE_HEADER || context->Status == HTTP_SOCKET_STATUS_RECEIVE_BODY)
 					{
 						// Prevent Slow Loris attacks
 						uint64_t const diffTime = time(0) - firstByte;
@@ -260,51 +640,41 @@ namespace Peoplez
 						if(__builtin_expect(context->InputBuffer.Length() < minData, false))
 						{
 							// Set error response
-							context->response.SetOther(HttpStatusCode::REQUEST_TIMEOUT);
-
-							// And initiate disconnect
-							context->response.KeepAlive = false;
+							context->response.SetError(HttpStatusCode::REQUEST_TIMEOUT);
 
 							// Send answer (error)
-							context->OutputBuffer = context->response.GetResponseText();
 							SwitchToSend();
 						}
 					}
 
-					for(unsigned int i = (MAX_HEADER_LENGTH + MAX_BODY_LENGTH)/INPUT_BUFFER_STEP_SIZE; i > 0 && context->sender->IsOpen(); --i)
+					// Receive and process everything available
+					ReceiveInner();
+
+					// If the connection was just upgraded to HTTP/2 ... continue there with the rest of the socket data
+					if(context->Http2)
 					{
-						// Receive next chunk of data
-						int const bytes = context->sender->Recv(buf, INPUT_BUFFER_STEP_SIZE);
+						std::shared_ptr<Http2Connection> const http2 = context->Http2;
 
-						if(bytes > 0) // If sth. received ...
-						{
-							// Append received chunk to input buffer
-							context->InputBuffer.Append(buf, bytes);
+						lock.unlock();
+						http2->MessageReceivable();
+						return;
+					}
 
-							// Handle received data
-							DataReceived(bytes);
-						}
-						else if(bytes < 0) // On error ...
-						{
-							// Log error (if not EAGAIN)
-							if(errno != EAGAIN)
-							{
-								Logger::LogException("Error while reading http request", __FILE__, __LINE__);
-								Logger::LogException(strerror(errno), __FILE__, __LINE__);
-							}
+					// A new WebSocket connection read the rest of the socket data already
+					if(context->WebSocket) return;
 
-							// Stop receiving
-							break;
-						}
-#ifdef SHOW_RB_EMPTY
-						else
-						{
-							// Log the fact that no bytes were received
-							Logger::LogEvent("Read buffer empty");
-							break;
-						}
-#endif
+					// A new event stream drops what the client sends
+					if(context->Events)
+					{
+						std::shared_ptr<EventStream> const stream = context->Events;
+
+						lock.unlock();
+						stream->MessageReceivable();
+						return;
 					}
+
+					// Send all responses at once
+					Flush();
 				}
 				catch(...)
 				{
@@ -313,54 +683,238 @@ namespace Peoplez
 				}
 			}
 
+			bool HttpClientInfo::KeepOpen() noexcept
+			{
+				std::unique_lock<std::mutex> const lock(context->mut, std::try_to_lock);
+
+				// A connection that is processed at the moment is not idle
+				if(!lock.owns_lock()) return true;
+
+				if(context->Events) return context->Events->IsOpen();
+				if(context->Http2) return context->Http2->IsResponding();
+
+				// Deferred response or streamed body/response that waits for Resume
+				return context->Status == HTTP_SOCKET_STATUS_WAIT_RESPONSE || context->ResponsePaused || context->BodyPaused;
+			}
+
 			void HttpClientInfo::MessageSendableCB()
 			{
-				std::unique_lock<std::mutex> const lock(context->mut);
-				SendInner();
+				std::unique_lock<std::mutex> lock(context->mut);
+
+				// If the connection was upgraded to HTTP/2 ... it is handled there
+				if(context->Http2)
+				{
+					std::shared_ptr<Http2Connection> const http2 = context->Http2;
+
+					lock.unlock();
+					http2->MessageSendable();
+				}
+				else if(context->WebSocket)
+				{
+					std::shared_ptr<WebSocketConnection> const webSocket = context->WebSocket;
+
+					lock.unlock();
+					webSocket->MessageSendable();
+				}
+				else if(context->Events)
+				{
+					std::shared_ptr<EventStream> const stream = context->Events;
+
+					lock.unlock();
+					stream->MessageSendable();
+				}
+				else Flush();
 			}
 
-			void HttpClientInfo::SendInner()
+			void HttpClientInfo::Flush()
 			{
 				try
 				{
-					// If output buffer is empty ... return
-					if(!context->OutputBuffer.Length()) return;
-
-					// Send remaining content in output buffer
-					int const sent = context->sender->Send(context->OutputBuffer.GetData(), context->OutputBuffer.Length());
-
-					// If an error occured while sending ...
-					//   Log an error
-					// Else if everything could be sent ...
-					// Else ...
-					//   Remove sent content from output buffer
-					if(__builtin_expect(sent < 0, false)) Logger::LogEvent("Error while writing");
-					else if((size_t) sent >= context->OutputBuffer.Length())
+					// While everything could be sent ...
+					while(SendInner())
 					{
-						// Backup keep alive flag
-						bool const keepAlive = context->response.KeepAlive;
-
-						// Clean up http context and switch to receive header mode
-						context->Reset();
-						context->Status = HTTP_SOCKET_STATUS_RECEIVE_HEADER;
+						// If a streamed response is sent ... fetch its next chunks
+						if(context->Status == HTTP_SOCKET_STATUS_SEND_STREAM)
+						{
+							if(context->ResponsePaused || !PumpResponse()) return;
+							continue;
+						}
 
-						// If not keep alive ...
+						// If the last response requested closing the connection ...
 						// 	 Close socket
-						if(!keepAlive) context->sender->Close();
-						else DataReceived(context->InputBuffer.Length());
+						if(context->CloseAfterSend)
+						{
+							context->sender->Close();
+							return;
+						}
+
+						// Continue with pipelined requests
+						ProcessPipeline();
+
+						// Continue reading if it was stopped because of a full queue (edge-triggered: no new event will come)
+						if(context->ReceiveThrottled && !context->BodyPaused) ReceiveInner();
+
+						// Nothing more to send
+						if(context->OutputQueue.empty()) return;
+					}
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HttpClientInfo::Flush", __FILE__, __LINE__);
+				}
+			}
+
+			void HttpClientInfo::ProcessPipeline()
+			{
+				// While the current request is answered and there is space for further responses ...
+				while(context->Status == HTTP_SOCKET_STATUS_SEND && !context->CloseAfterSend && context->OutputQueue.size() < PEOPLEZ_HTTP_PIPELINE_DEPTH)
+				{
+					// Clean up http context and switch to receive header mode
+					context->Reset();
+
+					// If no further request is received ... wait for it
+					if(context->InputBuffer.IsEmpty()) break;
+
+					// Handle next request (ends in send mode if it is complete)
+					DataReceived(context->InputBuffer.Length());
+				}
+			}
+
+			void HttpClientInfo::ReceiveInner()
+			{
+				// Reserve memory for receiving
+				char buf[INPUT_BUFFER_STEP_SIZE];
+
+				context->ReceiveThrottled = false;
+
+				// Streamed bodies are read completely (constant memory); buffered requests are limited by their maximum size
+				for(unsigned int i = (MAX_HEADER_LENGTH + MAX_BODY_LENGTH)/INPUT_BUFFER_STEP_SIZE; i > 0 && context->sender->IsOpen(); i -= (context->Status != HTTP_SOCKET_STATUS_RECEIVE_BODY_STREAM))
+				{
+					// Nothing more is processed on this connection (or it is handled as HTTP/2, WebSocket or event stream)
+					if(context->CloseAfterSend || context->Http2 || context->WebSocket || context->Events) break;
+
+					// If the output queue is full, the body stream is busy or a deferred response is pending ... leave data in the socket
+					if(context->BodyPaused || context->Status == HTTP_SOCKET_STATUS_SEND_STREAM || context->Status == HTTP_SOCKET_STATUS_WAIT_RESPONSE || (context->Status == HTTP_SOCKET_STATUS_SEND && context->OutputQueue.size() >= PEOPLEZ_HTTP_PIPELINE_DEPTH))
+					{
+						context->ReceiveThrottled = true;
+						break;
+					}
+
+					// Receive next chunk of data
+					int const bytes = context->sender->Recv(buf, INPUT_BUFFER_STEP_SIZE);
+
+					if(bytes > 0) // If sth. received ...
+					{
+						// Append received chunk to input buffer
+						context->InputBuffer.Append(buf, bytes);
+
+						// Handle received data
+						DataReceived(bytes);
+
+						// If the connection was handed over to HTTP/2, WebSocket or an event stream ... stop reading here
+						if(context->Http2 || context->WebSocket || context->Events) break;
+
+						// Handle further requests in the same chunk
+						ProcessPipeline();
+					}
+					else if(bytes < 0) // On error ...
+					{
+						// Log error (if not EAGAIN)
+						if(errno != EAGAIN)
+						{
+							Logger::LogException("Error while reading http request", __FILE__, __LINE__);
+							Logger::LogException(strerror(errno), __FILE__, __LINE__);
+						}
+
+						// Stop receiving
+						break;
+					}
+#ifdef SHOW_RB_EMPTY
+					else
+					{
+						// Log the fact that no bytes were received
+						Logger::LogEvent("Read buffer empty");
+						break;
+					}
+#endif
+				}
+			}
+
+			bool HttpClientInfo::SendInner()
+			{
+				try
+				{
+					std::vector<PeoplezString> & queue = context->OutputQueue;
+
+					while(!queue.empty())
+					{
+						// Collect queued responses
+						iovec iov[PEOPLEZ_HTTP_PIPELINE_DEPTH];
+						size_t const count = std::min<size_t>(queue.size(), PEOPLEZ_HTTP_PIPELINE_DEPTH);
+
+						for(size_t i = 0; i < count; ++i)
+						{
+							iov[i].iov_base = (void *) queue[i].GetData();
+							iov[i].iov_len = queue[i].Length();
+						}
+
+						// Send them at once
+						int const sent = context->sender->SendV(iov, (int)count);
+
+						// If an error occured while sending ...
+						//   Log an error (if not EAGAIN)
+						if(__builtin_expect(sent < 0, false))
+						{
+							if(errno != EAGAIN) Logger::LogEvent("Error while writing");
+							return false;
+						}
+
+						// Remove completely sent responses and the sent part of the next one
+						size_t remaining = sent;
+						size_t done = 0;
+
+						for(; done < count && remaining >= iov[done].iov_len; ++done) remaining -= iov[done].iov_len;
+
+						if(done < count) queue[done] <<= remaining;
+						queue.erase(queue.begin(), queue.begin() + done);
+
+						// If not everything could be sent ... wait for MessageSendableCB
+						if(done < count) return false;
 					}
-					else context->OutputBuffer <<= sent;
+
+					return true;
 				}
 				catch(...)
 				{
 					Logger::LogException("Error in HttpClientInfo::SendInner", __FILE__, __LINE__);
 				}
+
+				return false;
 			}
 
 			void HttpClientInfo::SwitchToSend()
 			{
 				context->Status = HTTP_SOCKET_STATUS_SEND;
-				SendInner();
+
+				// Responses to HEAD requests only consist of the header (RFC 9110 Section 9.3.2)
+				bool const headOnly = context->request.HttpMethod() == HttpMethods::HEAD;
+
+				// Serialize into the reused output buffer and queue it (sent by Flush)
+				// Large bodies are queued as they are instead of being copied behind the header
+				context->response.SerializeTo(context->OutputBuffer, false, headOnly);
+				context->OutputQueue.push_back(context->OutputBuffer);
+
+				if(!headOnly && context->response.HasSeparateBody()) context->OutputQueue.push_back(context->response.GetBody());
+				if(!context->response.KeepAlive) context->CloseAfterSend = true;
+
+				// If the body is streamed ... fetch it after the header is sent
+				if(!headOnly && context->response.GetStream())
+				{
+					context->ResponseStream = context->response.GetStream();
+					context->ResponsePaused = false;
+					context->ResponseChunkSent = false;
+					context->Status = HTTP_SOCKET_STATUS_SEND_STREAM;
+				}
 			}
 		} // namespace Http
 	} // namespace Services
@@ -39,6 +39,9 @@
 // Local includes
 #include "../../System/IO/Network/ClientInfo.hpp"
 #include "Enums.hpp"
+#include "Http2Connection.hpp"
+#include "EventStream.hpp"
+#include "WebSocketConnection.hpp"
 #include "HttpContext.hpp"
 #include "HttpRequestHandler.hpp"
 
@@ -71,17 +74,106 @@ namespace Peoplez
 				virtual ClientInfo *Copy() {return new HttpClientInfo(*this);}
 				virtual void MessageReceivableCB();
 				virtual void MessageSendableCB();
+				/**
+				 * Keeps connections that push events, wait for a deferred or paused response (or body) or for HTTP/2 responses from timing out
+				 */
+				virtual bool KeepOpen() noexcept;
 				virtual ~HttpClientInfo() {}
 
 			private:
+				/**
+				 * Creates another handle for an existing connection (used to resume paused streams and deferred responses)
+				 *
+				 * @param fileDescriptor File descriptor of the socket
+				 * @param requestHandler Handler of the connection
+				 * @param context Context of the connection
+				 */
+				HttpClientInfo(int fileDescriptor, HttpRequestHandler & requestHandler, std::shared_ptr<HttpContext> const & context) noexcept;
 				void DataReceived(size_t bytesReceived);
 				void BodyReceived();
 				void HeaderReceived(size_t size);
+				/**
+				 * Hands the connection over to HTTP/2 if the current request asks for an h2c upgrade
+				 *
+				 * Context has to be locked
+				 *
+				 * @return Indicates whether the connection was upgraded (and the request is answered there)
+				 */
+				bool UpgradeToHttp2();
+				/**
+				 * Hands the connection over to a WebSocketConnection after the handler accepted the handshake
+				 *
+				 * Context has to be locked
+				 *
+				 * @return Indicates whether the connection was upgraded (the handshake is answered there)
+				 */
+				bool UpgradeToWebSocket();
+				/**
+				 * Hands the connection over to the event stream the handler opened
+				 *
+				 * Context has to be locked
+				 *
+				 * @return Indicates whether the stream took over the connection
+				 */
+				bool StartEventStream();
 				/**
 				 * Relays the request to the specific modules and writes the result into the output buffer
 				 */
 				void MessageReady();
-				void SendInner();
+				/**
+				 * Fetches the next chunks of a streamed response into the output queue
+				 *
+				 * Context has to be locked
+				 *
+				 * @return Indicates whether anything was queued
+				 */
+				bool PumpResponse();
+				/**
+				 * Queues the interim response "100 Continue" for a client that waits before sending the body (Expect: 100-continue)
+				 *
+				 * Context has to be locked
+				 */
+				void QueueContinue();
+				/**
+				 * Continues a paused body stream, response stream or deferred response and the processing of the connection afterwards
+				 */
+				void Resume();
+				/**
+				 * Passes the received part of a streamed or chunked body to its HttpBodyStreamHandler (or the body buffer)
+				 *
+				 * Context has to be locked
+				 */
+				void StreamBody();
+				/**
+				 * Sends the output queue until it is empty and continues with pipelined requests afterwards
+				 *
+				 * Context has to be locked
+				 */
+				void Flush();
+				/**
+				 * Processes requests that are already completely in the input buffer
+				 *
+				 * Stops if the pipeline depth is reached or the connection is going to be closed.
+				 * Context has to be locked
+				 */
+				void ProcessPipeline();
+				/**
+				 * Reads from the socket until it would block or the pipeline depth is reached
+				 *
+				 * Context has to be locked
+				 */
+				void ReceiveInner();
+				/**
+				 * Writes as much of the output queue as possible with a single gather write
+				 *
+				 * Context has to be locked
+				 *
+				 * @return Indicates whether the output queue is empty now
+				 */
+				bool SendInner();
+				/**
+				 * Serializes the response into the output buffer and appends it (and a large body) to the output queue
+				 */
 				void SwitchToSend();
 
 				HttpRequestHandler & requestHandler;
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "HttpCompletion.hpp"
+
+// Local includes
+#include "../../System/Logging/Logger.hpp"
+#include "HttpContext.hpp"
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace System::Logging;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			HttpCompletion::HttpCompletion(std::shared_ptr<HttpContext> && ctx) noexcept : context(std::move(ctx))
+			{
+			}
+
+			HttpCompletion::HttpCompletion(HttpCompletion && other) noexcept : context(std::move(other.context))
+			{
+			}
+
+			HttpCompletion & HttpCompletion::operator=(HttpCompletion && other) noexcept
+			{
+				if(this != &other)
+				{
+					// The destructor of the old token answers its request (if it is not completed)
+					HttpCompletion const old(std::move(*this));
+					context = std::move(other.context);
+				}
+
+				return *this;
+			}
+
+			void HttpCompletion::Complete() noexcept
+			{
+				// The token can be used only once
+				std::shared_ptr<HttpContext> const ctx = std::move(context);
+
+				if(ctx) ctx->CompleteDeferred();
+			}
+
+			HttpCompletion::~HttpCompletion()
+			{
+				try
+				{
+					// If the request was not answered ... do not leave the connection parked
+					if(context)
+					{
+						Logger::LogException("Deferred response was not completed", __FILE__, __LINE__);
+
+						context->response.SetError(HttpStatusCode::INTERNAL_SERVER_ERROR);
+						Complete();
+					}
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in destructor of HttpCompletion", __FILE__, __LINE__);
+				}
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTPCOMPLETION_HPP_
+#define PEOPLEZ_SERVICES_HTTP_HTTPCOMPLETION_HPP_
+
+// Extern includes
+#include <memory>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			class HttpContext;
+
+			/**
+			 * @brief Token for a response that is completed after HttpRequestHandler::ProcessRequest returned
+			 *
+			 * @details
+			 * Returned by HttpContext::Defer. Until Complete is called the connection is parked: it holds no thread
+			 * and further (pipelined) requests of the connection wait. The token keeps the context alive,
+			 * so the response may be filled by any thread in the meantime.
+			 * A token that is destroyed without completing answers the request with "500 Internal Server Error".
+			 */
+			class HttpCompletion final
+			{
+				friend class HttpContext;
+			public:
+				/**
+				 * Constructor (creates an invalid token)
+				 */
+				HttpCompletion() noexcept : context() {}
+				HttpCompletion(HttpCompletion && other) noexcept;
+				HttpCompletion & operator=(HttpCompletion && other) noexcept;
+				/**
+				 * Context of the deferred request; valid until Complete is called
+				 */
+				HttpContext & Context() const noexcept {return *context;}
+				/**
+				 * Indicates whether the token belongs to a request that is not completed yet
+				 */
+				bool IsValid() const noexcept {return (bool)context;}
+				/**
+				 * Sends the response that was set in the context meanwhile and invalidates the token
+				 *
+				 * Can be called from any thread (also from within ProcessRequest). The connection continues in a worker thread of the
+				 * System::IO::Network::ConnectionsManager that processed the request (in the calling thread if there was none).
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void Complete() noexcept;
+				~HttpCompletion();
+
+			private:
+				HttpCompletion(HttpCompletion const & other) = delete;
+				HttpCompletion & operator=(HttpCompletion const & other) = delete;
+				/**
+				 * Constructor
+				 *
+				 * @param context Context of the deferred request
+				 */
+				explicit HttpCompletion(std::shared_ptr<HttpContext> && context) noexcept;
+
+				std::shared_ptr<HttpContext> context;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTPCOMPLETION_HPP_
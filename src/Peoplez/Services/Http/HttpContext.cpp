@@ -40,6 +40,16 @@
 #include "../../System/Logging/Logger.hpp"
 #include "../../General/MimeOperations.hpp"
 #include "HttpFunctions.hpp"
+#include "MultipartFormDataParser.hpp"
+#include "EventChannel.hpp"
+#include "EventStream.hpp"
+#include "WebSocketConnection.hpp"
+
+// External includes
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <strings.h>
 
 /**
  * @def MIN_FIRST_LINE_LENGTH
@@ -49,6 +59,14 @@
  */
 #define MIN_FIRST_LINE_LENGTH 14
 
+/**
+ * @def HEADER_RESERVATION
+ * @brief Number of header fields reserved in the request arena before parsing the header lines
+ */
+#ifndef HEADER_RESERVATION
+#define HEADER_RESERVATION 16
+#endif
+
 // External namespaces
 using namespace std;
 
@@ -63,13 +81,6 @@ namespace Peoplez
 	{
 		namespace Http
 		{
-			const String::PeoplezString HttpContext::COMPARE_STRING_ACCEPT_LANGUAGE = "Accept-Language"; //15
-			const String::PeoplezString HttpContext::COMPARE_STRING_CONNECTION = "Connection"; //10
-			const String::PeoplezString HttpContext::COMPARE_STRING_IF_NONE_MATCH = "If-None-Match"; //13
-			const String::PeoplezString HttpContext::COMPARE_STRING_CONTENT_LENGTH = "Content-Length"; //14
-			const String::PeoplezString HttpContext::COMPARE_STRING_COOKIE = "Cookie"; //6
-			const String::PeoplezString HttpContext::COMPARE_STRING_HOST = "Host"; // 4
-
 			HttpStatusCode HttpContext::HandleHeader() noexcept
 			{
 				try
@@ -83,7 +94,7 @@ namespace Peoplez
 						PeoplezString firstLine(InputBuffer.Substring(0, positionEnd));
 						// Split the request-line
 						//std::vector<PeoplezString> &lineElements = threadLocalVector;
-						std::vector<PeoplezString> lineElements;
+						std::pmr::vector<PeoplezString> lineElements(&RequestArena);
 						firstLine.Split<false>(lineElements, ' '); // Uses 'false' to determine number of whitespace characters
 
 						// Interpret the three parts of the request-line as:
@@ -94,35 +105,16 @@ namespace Peoplez
 						if(lineElements.size() != 3) return HttpStatusCode::BAD_REQUEST;
 						else
 						{
-							// Extract Http method
-							request.httpMethod = HttpFunctions::ToHttpMethod(lineElements[0]);
+							// Extract Http method and request target
+							HttpStatusCode const stat = HandleRequestLine(HttpFunctions::ToHttpMethod(lineElements[0]), lineElements[1]);
 
-							// Check for asterisk ("*") for URI
-							if(lineElements[1].EqualTo("*", 1))
-							{
-								if(request.httpMethod == HttpMethods::OPTIONS)
-								{
-									//TODO: Send list of options to client
-									Logger::LogException("Not yet implemented", __FILE__, __LINE__);
-									exit(1);
-								}
-								else return HttpStatusCode::BAD_REQUEST; // Parsing error
-							}
+							if(stat != HttpStatusCode::OK) return stat;
 							else
 							{
-								// Remove possibly existing fragment from URI
-								{
-									size_t const fragmentBeginsAt = lineElements[1].Find('#');
-									if(fragmentBeginsAt != PeoplezString::NPOS) lineElements[1] = lineElements[1].Substring(0, fragmentBeginsAt);
-								}
-
-								// Parse remaining request URI
-								request.uri = HttpRequestUri(lineElements[1], request.httpMethod);
-
-								// Check whether request URI could be resolved/parsed
-								if(request.uri.type == UriType::UNDEFINED) return HttpStatusCode::BAD_REQUEST;
+								request.http11 = !lineElements[2].EqualTo("HTTP/1.0", 8);
 
 								// Read headers from input buffer
+								request.headers.reserve(HEADER_RESERVATION);
 								positionStart = positionEnd + 2;
 								positionEnd = InputBuffer.FindEndOfLine(positionStart);
 								size_t seperateCharPos = 0;
@@ -140,6 +132,11 @@ namespace Peoplez
 									positionStart = positionEnd + 2;
 									positionEnd = InputBuffer.FindEndOfLine(positionStart);
 								}
+
+								// Check transfer coding (RFC 7230 Section 3.3.3)
+								// Content-Length together with Transfer-Encoding is rejected to prevent request smuggling
+								if(request.transferCoding == HttpRequest::TransferCoding::UNSUPPORTED) return HttpStatusCode::NOT_IMPLEMENTED;
+								else if(request.transferCoding == HttpRequest::TransferCoding::CHUNKED && request.ContentLengthIsSet()) return HttpStatusCode::BAD_REQUEST;
 							}
 						}
 					}
@@ -184,13 +181,60 @@ namespace Peoplez
 //				return HttpStatusCode::INTERNAL_SERVER_ERROR;
 //			}
 
+			HttpStatusCode HttpContext::HandleRequestLine(HttpMethods const method, PeoplezString target) noexcept
+			{
+				try
+				{
+					request.httpMethod = method;
+
+					// Check for asterisk ("*") for URI
+					if(target.EqualTo("*", 1))
+					{
+						if(request.httpMethod == HttpMethods::OPTIONS)
+						{
+							//TODO: Send list of options to client
+							Logger::LogException("Not yet implemented", __FILE__, __LINE__);
+							exit(1);
+						}
+						else return HttpStatusCode::BAD_REQUEST; // Parsing error
+					}
+
+					// Remove possibly existing fragment from URI
+					{
+						size_t const fragmentBeginsAt = target.Find('#');
+						if(fragmentBeginsAt != PeoplezString::NPOS) target = target.Substring(0, fragmentBeginsAt);
+					}
+
+					// Parse remaining request URI
+					request.uri = HttpRequestUri(target, request.httpMethod, &RequestArena);
+
+					// Check whether request URI could be resolved/parsed
+					if(request.uri.type == UriType::UNDEFINED) return HttpStatusCode::BAD_REQUEST;
+
+					return HttpStatusCode::OK;
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HttpContext::HandleRequestLine", __FILE__, __LINE__);
+				}
+
+				return HttpStatusCode::INTERNAL_SERVER_ERROR;
+			}
+
 			HttpStatusCode HttpContext::HandleBody(size_t const size) noexcept
+			{
+				return HandleBody(InputBuffer.Substring(0, size));
+			}
+
+			HttpStatusCode HttpContext::HandleBody(PeoplezString const body) noexcept
 			{
 				try
 				{
+					// Length of a decoded (chunked) body
+					request.contentLength = body.Length();
+
 					if(request.HttpMethod() == HttpMethods::POST) //Auslesen des Bodys
 					{
-						PeoplezString body = InputBuffer.Substring(0, size);
 
 						if(request.contentType == MimeType::APPLICATION_X_WWW_FORM_URLENCODED) body.SplitToPairs<PostParam>(request.postParams, &PostParam::Name, &PostParam::Value, '&', '=', true);
 						else if(request.contentType == MimeType::MULTIPART_FORM_DATA) return HandleMultipartFormData(body, request.postParams, request.boundary);
@@ -294,115 +338,37 @@ namespace Peoplez
 				return HttpStatusCode::INTERNAL_SERVER_ERROR;
 			}
 
-			HttpStatusCode HttpContext::HandleMultipartFormData(PeoplezString const src, std::vector<PostParam> &dest, PeoplezString boundary) noexcept
+			HttpStatusCode HttpContext::HandleMultipartFormData(PeoplezString const src, std::pmr::vector<PostParam> &dest, PeoplezString boundary) noexcept
 			{
-				try
+				/**
+				 * @brief Collects the parts of a completely received body as post parameters
+				 */
+				class PostParamCollector final : public MultipartFormDataParser::PartHandler
 				{
-					//TODO Somthing is wrong with variables "name" and "content"!
-					PeoplezString name, content;
-					size_t posStart = 0, posEnd = 0, contentStart = 0;
-					size_t const srcLen = src.Length(), boundaryLen = boundary.Length() + 2;
-					unsigned int phase = 0;
-
-					boundary = (PeoplezString)"--" + boundary;
-
-					while(phase < 6 && posEnd < srcLen && posEnd != PeoplezString::NPOS)
+				public:
+					PostParamCollector(std::pmr::vector<PostParam> & _dest) : dest(_dest) {}
+					virtual void PartBegin(PostParam const & part) {dest.push_back(part);}
+					virtual void PartData(PeoplezString const & data)
 					{
-						PostParam param;
-						posStart = posEnd + 2;
-						posEnd = src.FindEndOfLine(posStart);
-
-						switch(phase)
-						{
-						case 0:
-							//Initial Boundary
-							posStart = 0;
-
-							if(posEnd - posStart == boundaryLen && src.EqualTo(posStart, boundaryLen, boundary)) phase = 1;
-							else if(posEnd - posStart == boundaryLen + 2 && src.EqualTo(posStart, boundaryLen, boundary) && src.EqualTo(posStart + boundaryLen, "--", 2)) phase = 5;
-							else return HttpStatusCode::BAD_REQUEST;
-							break;
-						case 1:
-							//Content-Disposition
-							if(src.EqualTo(posStart, "Content-Disposition: ", 21))
-							{
-								posStart += 21;
-
-								if(src.EqualTo(posStart, "form-data; ", 11)) posStart += 11;
-								else if(src.EqualTo(posStart, "file; ", 6)) posStart += 6;
-								else return HttpStatusCode::BAD_REQUEST;
-
-								if(src.EqualTo(posStart, "name=\"", 6))
-								{
-									posStart += 6;
-
-									size_t const posQuote = src.Find('\"', posStart);
-									if(posQuote < posEnd && posQuote != PeoplezString::NPOS)
-									{
-										param.Name = src.Substring(posStart, posQuote - posStart);
-										param.Name.Trim();
-
-										if(!param.Name.IsUrlEncoded()) return HttpStatusCode::BAD_REQUEST;
-									}
-									else return HttpStatusCode::BAD_REQUEST;
-
-									posStart = posQuote + 1;
-								}
-								else return HttpStatusCode::BAD_REQUEST;
+						// Content of a complete body is a single view (unless split by the parser)
+						if(dest.back().Value.IsEmpty()) dest.back().Value = data;
+						else dest.back().Value.Append(data);
+					}
+					virtual void PartEnd() {}
 
-								if(src.EqualTo(posStart, "filename=\"", 10))
-								{
-									posStart += 10;
-									size_t const posQuote = src.Find('\"', posStart);
-									if(posQuote < posEnd && posQuote != PeoplezString::NPOS)
-									{
-										param.FileName = src.Substring(posStart, posQuote - posStart);
-										param.FileName.Trim();
+				private:
+					std::pmr::vector<PostParam> & dest;
+				};
 
-										if(!param.FileName.IsUrlEncoded()) return HttpStatusCode::BAD_REQUEST;
-									}
-									else return HttpStatusCode::BAD_REQUEST;
-								}
-
-								++phase;
-							}
-							else return HttpStatusCode::BAD_REQUEST;
-							break;
-						case 2:
-							//Content-Type or empty line
-							if(posStart == posEnd) phase += 2;
-							else if(src.EqualTo(posStart, "Content-Type: ", 14))
-							{
-								posStart += 14;
-								param.Mime = MimeOperations::StringToMimeType(src.Substring(posStart, posEnd - posStart));
-								if(param.Mime == MimeType::NONE) return HttpStatusCode::UNSUPPORTED_MEDIA_TYPE;
-								++phase;
-							}
-							else return HttpStatusCode::BAD_REQUEST;
-							break;
-						case 3:
-							//Empty line
-							if(posStart == posEnd) ++phase;
-							else return HttpStatusCode::BAD_REQUEST;
-							break;
-						case 4:
-							//Content
-							contentStart = posStart;
-							++phase;
-							break;
-						case 5:
-							//Content, Boundary or End
-							if(posEnd - posStart == boundaryLen && src.EqualTo(posStart, boundaryLen, boundary)) phase = 1;
-							else if(posEnd - posStart == boundaryLen  + 2 && src.EqualTo(posStart, boundaryLen, boundary)) phase = 6;
-
-							if(phase != 5) dest.push_back(PostParam(name, src.Substring(contentStart, posStart - contentStart - 2)));
-							break;
-						}
-					}
+				try
+				{
+					MultipartFormDataParser parser(boundary);
+					PostParamCollector collector(dest);
 
-					Logger::LogEvent("end");
+					HttpStatusCode const stat = parser.Feed(src, collector);
 
-					if(phase != 6) return HttpStatusCode::BAD_REQUEST;
+					if(stat != HttpStatusCode::OK) return stat;
+					else if(!parser.IsComplete()) return HttpStatusCode::BAD_REQUEST;
 					else return HttpStatusCode::OK;
 				}
 				catch(...)
@@ -413,110 +379,110 @@ namespace Peoplez
 				return HttpStatusCode::INTERNAL_SERVER_ERROR;
 			}
 
-			void HttpContext::InsertHeader(PeoplezString const name, PeoplezString value) noexcept
+			void HttpContext::InsertHeader(PeoplezString const name, PeoplezString const value) noexcept
+			{
+				InsertHeader(HttpFunctions::ToHttpHeaderField(name), name, value);
+			}
+
+			void HttpContext::InsertHeader(HttpHeaderField const field, PeoplezString const name, PeoplezString value) noexcept
 			{
 				try
 				{
 					value.TrimFast();
 
-					switch(name.Length()) //With RETURN at the end of each complete match!!!
+					switch(field) //With RETURN at the end of each complete match!!!
 					{
-					case 4:
-						if(name == COMPARE_STRING_HOST)
-						{
-							request.host = value;
-
-							return;
-						}
-						break;
-					case 6:
-						if(name == COMPARE_STRING_COOKIE)
-						{
-							std::vector<PeoplezString> cookies;
-							value.Split<true>(cookies, ';');
+					case HttpHeaderField::HOST:
+						request.host = value;
 
-							std::vector<PeoplezString>::size_type const cookiesSize = cookies.size();
-							std::vector<PeoplezString>::size_type pos;
+						return;
+					case HttpHeaderField::COOKIE:
+						// Cookies are parsed on first access (see HttpRequest::Cookies())
+						if(request.cookieString.IsEmpty()) request.cookieString = value;
+						else request.cookieString = request.cookieString + "; " + value;
 
-							for(std::vector<PeoplezString>::size_type i = 0; i < cookiesSize; ++i)
-							{
-								pos = cookies[i].Find('=');
-								if(pos == PeoplezString::NPOS) throw "Unreadable cookie"; //TODOPeoplez So wirklich gut?
-								PeoplezString firstPart = cookies[i].Substring(0, pos);
-								PeoplezString secondPart = cookies[i].Substring(pos + 1, cookies[i].Length() - pos - 1);
+						return;
+					case HttpHeaderField::CONNECTION:
+					{
+						// Comma separated list of options (e.g. "keep-alive, Upgrade")
+						char const * option = value.GetData();
+						char const * const end = option + value.Length();
 
-								firstPart.Trim();
-								secondPart.Trim();
+						while(option < end)
+						{
+							char const * optionEnd = (char const *) memchr(option, ',', end - option);
+							char const * const next = optionEnd ? optionEnd + 1 : end;
+							if(!optionEnd) optionEnd = end;
 
-								request.cookies.push_back(HttpCookie(firstPart, secondPart));
-							}
+							// Trim spaces
+							while(option < optionEnd && (*option == ' ' || *option == '\t')) ++option;
+							while(optionEnd > option && (optionEnd[-1] == ' ' || optionEnd[-1] == '\t')) --optionEnd;
 
-							return;
-						}
-						break;
-					case 10:
-						if(name == COMPARE_STRING_CONNECTION)
-						{
-							value.ToLower_ASCII_NU();
+							size_t const len = optionEnd - option;
 
-							if(value.EqualTo("keep-alive", 10)) response.KeepAlive = request.keepAlive = true;
-							else if(value.EqualTo("close", 5)) response.KeepAlive = request.keepAlive = false;
-							else Logger::LogEvent("Connection not decodeable");
+							if(len == 10 && !strncasecmp(option, "keep-alive", 10)) response.KeepAlive = request.keepAlive = true;
+							else if(len == 5 && !strncasecmp(option, "close", 5)) response.KeepAlive = request.keepAlive = false;
+							else if(len == 7 && !strncasecmp(option, "upgrade", 7)) request.connectionUpgrade = true;
+							else if(len) Logger::LogEvent("Connection not decodeable");
 
-							return;
+							option = next;
 						}
 
-						break;
-					case 12:
-						if(name.EqualTo("Content-Type", 12))
+						return;
+					}
+					case HttpHeaderField::CONTENT_TYPE:
+					{
+						std::pmr::vector<PeoplezString> parts(&RequestArena);
+						value.Split<true>(parts, ';');
+
+						if(parts.size())
 						{
-							std::vector<PeoplezString> parts;
-							value.Split<true>(parts, ';');
+							request.contentType = MimeOperations::StringToMimeType(parts[0]);
 
-							if(parts.size())
+							if(parts.size() > 1)
 							{
-								request.contentType = MimeOperations::StringToMimeType(parts[0]);
-
-								if(parts.size() > 1)
-								{
-									parts[1].Trim();
+								parts[1].Trim();
 
-									if(parts[1].BeginsWith("boundary=", 9)) request.boundary = parts[1].Substring(9);
-								}
-								//TODO: What happens otherwise?
-
-								if(request.contentType == MimeType::MULTIPART_FORM_DATA && request.boundary.IsEmpty()) request.contentType = MimeType::NONE;
+								if(parts[1].BeginsWith("boundary=", 9)) request.boundary = parts[1].Substring(9);
 							}
+							//TODO: What happens otherwise?
 
-							return;
+							if(request.contentType == MimeType::MULTIPART_FORM_DATA && request.boundary.IsEmpty()) request.contentType = MimeType::NONE;
 						}
+
+						return;
+					}
+					case HttpHeaderField::CONTENT_LENGTH:
+						request.contentLength = value.ToInt64(10);
+
+						return;
+					case HttpHeaderField::TRANSFER_ENCODING:
+						// Only a single "chunked" coding is supported (others are answered by HandleHeader)
+						request.transferCoding = request.transferCoding == HttpRequest::TransferCoding::NONE && value.Length() == 7 && !strncasecmp(value.GetData(), "chunked", 7) ? HttpRequest::TransferCoding::CHUNKED : HttpRequest::TransferCoding::UNSUPPORTED;
+
+						return;
+					case HttpHeaderField::ACCEPT_LANGUAGE:
+						request.userLanguages = value;
+
+						return;
+					case HttpHeaderField::UNKNOWN:
 						break;
-					case 13:
-						if(name == COMPARE_STRING_IF_NONE_MATCH)
+					case HttpHeaderField::IF_NONE_MATCH:
+						// Single entity tag (see HttpRequest::ETag); the complete list stays available for HttpRequest::IsNotModified
+						if(value.Length() > 2 && value.Length() <= (sizeof(size_t) << 1) + 2 && value[0] == '"' && value[value.Length() - 1] == '"'
+								&& std::all_of(value.GetData() + 1, value.GetData() + value.Length() - 1, [](char const c) {return isxdigit((unsigned char)c) != 0;}))
 						{
 							request.eTag = value.Substring(1, value.Length() - 2).ToUInt64(16);
-
-							return;
 						}
-						break;
-					case 14:
-						if(name == COMPARE_STRING_CONTENT_LENGTH)
-						{
-							request.contentLength = value.ToInt64(10);
 
-							return;
-						}
-						break;
-					case 15:
-						if(name == COMPARE_STRING_ACCEPT_LANGUAGE)
+						[[fallthrough]];
+					default:
+						// Remember position of well known header (first occurrence only)
+						if(request.headerPositions[(size_t)field] == HttpRequest::NO_HEADER_POSITION && request.headers.size() < HttpRequest::NO_HEADER_POSITION)
 						{
-							request.userLanguages = value;
-
-							return;
+							request.headerPositions[(size_t)field] = (uint16_t)request.headers.size();
 						}
 						break;
-					default:
-						break;
 					}
 
 					//request.headers[name] = value;
@@ -533,8 +499,142 @@ namespace Peoplez
 				OutputBuffer.Clear();
 				request.Clean();
 				response.Clean();
+				// Nothing of the request uses the arena anymore
+				RequestArena.Reset();
 				//InputBuffer.Clear();
 				Status = HTTP_SOCKET_STATUS_RECEIVE_HEADER;
+				BodyStream = nullptr;
+				RoutedHandler.reset();
+				BodyRemaining = 0;
+				BodyPaused = false;
+				BodyChunked = false;
+				BodyDecoder.Reset();
+				BodyBuffer.Clear();
+			}
+
+			void HttpContext::ResumeBody() noexcept
+			{
+				try
+				{
+					if(resume) resume();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HttpContext::ResumeBody", __FILE__, __LINE__);
+				}
+			}
+
+			void HttpContext::ResumeResponse() noexcept
+			{
+				try
+				{
+					if(resume) resume();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HttpContext::ResumeResponse", __FILE__, __LINE__);
+				}
+			}
+
+			HttpCompletion HttpContext::Defer()
+			{
+				uint8_t expected = DEFER_NONE;
+
+				if(!deferState.compare_exchange_strong(expected, DEFER_PROCESSING, std::memory_order_acq_rel)) return HttpCompletion();
+
+				// Called within ProcessRequest ... the worker pool of the connection
+				completionScheduler = General::Scheduler::Current();
+
+				return HttpCompletion(shared_from_this());
+			}
+
+			bool HttpContext::AcceptWebSocket(std::shared_ptr<WebSocketHandler> handler, PeoplezString const & protocol)
+			{
+				// Only http/1.1 connections can be taken over (HTTP/2 streams have no own socket)
+				if(!sender || !handler || !WebSocketConnection::IsUpgradeRequest(request))
+				{
+					response.SetError(HttpStatusCode::BAD_REQUEST);
+					return false;
+				}
+
+				PeoplezString version = request.GetHeaderValue(HttpHeaderField::SEC_WEBSOCKET_VERSION);
+				version.Trim();
+
+				if(!version.EqualTo("13", 2))
+				{
+					response.SetOther(HttpStatusCode::UPGRADE_REQUIRED);
+					response.Headers.Set(PeoplezString("Sec-WebSocket-Version", 21), PeoplezString("13", 2));
+					return false;
+				}
+
+				webSocketHandler = std::move(handler);
+				webSocketProtocol = protocol;
+
+				return true;
+			}
+
+			std::shared_ptr<EventStream> HttpContext::OpenEventStream(PeoplezString const & channel)
+			{
+				std::shared_ptr<EventStream> const stream = std::make_shared<EventStream>(sender);
+
+				// http/1.1: the socket is taken over after ProcessRequest (HttpClientInfo)
+				// HTTP/2: the events are the body of a streamed response
+				if(sender) eventStream = stream;
+				else
+				{
+					stream->context = shared_from_this();
+
+					response.SetStream(HttpStatusCode::OK, PeoplezString("text/event-stream", 17), stream);
+					response.Headers.Set(PeoplezString("Cache-Control", 13), PeoplezString("no-cache", 8));
+
+					EventStream::AddHeartbeat(stream);
+				}
+
+				if(!channel.IsEmpty()) EventChannel::Get(channel)->Subscribe(stream);
+
+				return stream;
+			}
+
+			bool HttpContext::Park() noexcept
+			{
+				uint8_t expected = DEFER_PROCESSING;
+
+				// If the response is deferred and not completed yet ... wait for CompleteDeferred
+				if(deferState.compare_exchange_strong(expected, DEFER_PARKED, std::memory_order_acq_rel)) return true;
+
+				// Response was completed already from within ProcessRequest (or not deferred at all)
+				if(expected == DEFER_COMPLETED) deferState.store(DEFER_NONE, std::memory_order_relaxed);
+
+				return false;
+			}
+
+			bool HttpContext::Unpark() noexcept
+			{
+				uint8_t expected = DEFER_COMPLETED;
+
+				return deferState.compare_exchange_strong(expected, DEFER_NONE, std::memory_order_acq_rel);
+			}
+
+			void HttpContext::CompleteDeferred() noexcept
+			{
+				try
+				{
+					// If ProcessRequest did not return yet ... the response is sent by Park's caller
+					uint8_t expected = DEFER_PROCESSING;
+					if(deferState.compare_exchange_strong(expected, DEFER_COMPLETED, std::memory_order_acq_rel)) return;
+
+					// Continue the parked connection
+					if(expected == DEFER_PARKED && deferState.compare_exchange_strong(expected, DEFER_COMPLETED, std::memory_order_acq_rel) && resume)
+					{
+						// In a worker of the connection; the completing thread (e.g. a backend client) must not send the response itself
+						if(completionScheduler) completionScheduler->Post([context = shared_from_this()]() {context->ResumeResponse();});
+						else resume();
+					}
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HttpContext::CompleteDeferred", __FILE__, __LINE__);
+				}
 			}
 
 			/**
@@ -542,7 +642,15 @@ namespace Peoplez
 			 */
 			HttpContext::~HttpContext()
 			{
-				delete sender;
+				if(BodyStream) BodyStream->BodyAborted(*this);
+				if(ResponseStream) ResponseStream->Aborted(*this);
+
+				if(WebSocket) WebSocket->Disconnected();
+				if(Events) Events->Disconnected();
+				if(eventStream) eventStream->Disconnected();
+
+				// After an upgrade the socket belongs to the HTTP/2, WebSocket or event stream connection
+				if(!Http2 && !WebSocket && !Events) delete sender;
 			}
 		} // namespace Http
 	} // namespace Services
@@ -37,13 +37,23 @@
 #define PEOPLEZ_SERVICES_HTTP_HTTPCONTEXT_H_
 
 // Local includes
+#include "../../General/Arena.hpp"
+#include "../../General/Scheduler.hpp"
 #include "../../System/IO/Network/Socket.hpp"
+#include "ChunkedDecoder.hpp"
+#include "HttpBodyStreamHandler.hpp"
+#include "HttpCompletion.hpp"
 #include "HttpRequest.hpp"
 #include "HttpResponse.hpp"
 #include "PostParam.hpp"
+#include "WebSocketHandler.hpp"
 
 // Extern includes
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace Peoplez
 {
@@ -51,6 +61,11 @@ namespace Peoplez
 	{
 		 namespace Http
 		 {
+			class EventStream;
+			class Http2Connection;
+			class HttpRequestHandler;
+			class WebSocketConnection;
+
 		 	 enum HttpRequestReadStatus
 			 {
 		 		 READ_STATUS_COMPLETE,
@@ -68,15 +83,18 @@ namespace Peoplez
 			/**
 			 * @brief Container for request and response
 			 */
-			class HttpContext final
+			class HttpContext final : public std::enable_shared_from_this<HttpContext>
 			{
+				friend class HttpClientInfo;
+				friend class HttpCompletion;
+				friend class Http2Connection;
 			public:
 				/**
 				 * Constructor
 				 *
 				 * @param s Socket for sending the response to the client/browser
 				 */
-				HttpContext(System::IO::Network::Socket *s) : request(), response(), InputBuffer(), OutputBuffer(), Status(HTTP_SOCKET_STATUS_RECEIVE_HEADER), SendableCBEnabled(false), sender(s) {}
+				HttpContext(System::IO::Network::Socket *s) : RequestArena(), request(&RequestArena), response(), InputBuffer(), OutputBuffer(), OutputQueue(), Status(HTTP_SOCKET_STATUS_RECEIVE_HEADER), SendableCBEnabled(false), CloseAfterSend(false), ReceiveThrottled(false), BodyStream(nullptr), RoutedHandler(), BodyRemaining(0), BodyPaused(false), BodyChunked(false), BodyDecoder(), BodyBuffer(), ResponseStream(), ResponsePaused(false), ResponseChunkSent(false), Http2(), WebSocket(), Events(), sender(s), resume(), deferState(DEFER_NONE), completionScheduler(nullptr), webSocketHandler(), webSocketProtocol(), eventStream() {}
 				/**
 				 * Extracts all information from the http header
 				 *
@@ -86,6 +104,20 @@ namespace Peoplez
 				 *  No-throw guarantee
 				 */
 				HttpStatusCode HandleHeader() noexcept;
+				/**
+				 * Sets method and URI of the request
+				 *
+				 * Used for the request line of http/1.x and the pseudo header fields of HTTP/2
+				 *
+				 * @param method Method of the request
+				 * @param target Request target (fragments are removed)
+				 *
+				 * @return Indicates whether the request target is valid
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				HttpStatusCode HandleRequestLine(HttpMethods method, String::PeoplezString target) noexcept;
 				//HttpStatusCode HandleRequestStream(RequestStream & readInfo) noexcept;
 				/**
 				 * Extracts the information from the http body
@@ -94,6 +126,15 @@ namespace Peoplez
 				 *  No-throw guarantee
 				 */
 				HttpStatusCode HandleBody(size_t size) noexcept;
+				/**
+				 * Extracts the information from the given (decoded) http body
+				 *
+				 * @param body Complete body
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				HttpStatusCode HandleBody(String::PeoplezString body) noexcept;
 				/**
 				 * Extracts the information from a MultipartFormData body
 				 *
@@ -101,7 +142,7 @@ namespace Peoplez
 				 * @param dest Target to put the extrated date into
 				 * @param boundary
 				 */
-				HttpStatusCode HandleMultipartFormData(String::PeoplezString src, std::vector<PostParam> &dest, String::PeoplezString boundary) noexcept;
+				HttpStatusCode HandleMultipartFormData(String::PeoplezString src, std::pmr::vector<PostParam> &dest, String::PeoplezString boundary) noexcept;
 				/**
 				 * Sorts a header to the right place
 				 *
@@ -111,12 +152,75 @@ namespace Peoplez
 				 * @param value Value of the http header field
 				 */
 				void InsertHeader(String::PeoplezString const name, String::PeoplezString value) noexcept;
+				/**
+				 * Sorts a header whose well known header field is already identified (e.g. by HPACK) to the right place
+				 *
+				 * @param field Well known header field of the name
+				 * @param name Name of the http header field
+				 * @param value Value of the http header field
+				 */
+				void InsertHeader(HttpHeaderField field, String::PeoplezString const name, String::PeoplezString value) noexcept;
 				/**
 				 * Resets all information to default
 				 */
 				void Reset();
+				/**
+				 * Continues receiving a streamed body that was paused by the HttpBodyStreamHandler
+				 *
+				 * Can be called from any thread, but not from within the callbacks of the HttpBodyStreamHandler
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void ResumeBody() noexcept;
+				/**
+				 * Continues sending a streamed response after its HttpResponseStream returned WAIT
+				 *
+				 * Can be called from any thread, but not from within HttpResponseStream::NextChunk
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void ResumeResponse() noexcept;
+				/**
+				 * Defers the response of the current request
+				 *
+				 * The response is not sent when HttpRequestHandler::ProcessRequest returns but after HttpCompletion::Complete.
+				 * Can only be called from within ProcessRequest, once per request.
+				 *
+				 * @return Token for completing the response; invalid if the response is deferred already
+				 */
+				HttpCompletion Defer();
+				/**
+				 * Accepts a WebSocket handshake (RFC 6455); the connection is taken over by a WebSocketConnection after ProcessRequest
+				 *
+				 * Only within ProcessRequest of http/1.1 requests. If the request is no valid handshake the error response is set
+				 * (400 or 426 for unsupported versions).
+				 *
+				 * @param handler Receiver of the messages of the connection
+				 * @param protocol Selected subprotocol (one of Sec-WebSocket-Protocol); empty for none
+				 *
+				 * @return Indicates whether the handshake is accepted
+				 */
+				bool AcceptWebSocket(std::shared_ptr<WebSocketHandler> handler, String::PeoplezString const & protocol = String::PeoplezString());
+				/**
+				 * Answers the request with a Server-Sent Events stream (text/event-stream) that stays open after ProcessRequest
+				 *
+				 * Only within ProcessRequest. Headers of the response (e.g. for CORS) are sent with the stream.
+				 *
+				 * @param channel Name of the EventChannel the stream subscribes to; empty for none
+				 *
+				 * @return Stream for sending events directly (may be kept after ProcessRequest)
+				 */
+				std::shared_ptr<EventStream> OpenEventStream(String::PeoplezString const & channel = String::PeoplezString());
 				virtual ~HttpContext();
 
+				/**
+				 * @brief Memory for the parsed parts of the current request (containers of the request, temporary vectors)
+				 *
+				 * Reset in bulk after each request of the connection; may also be used by handlers for request scoped data.
+				 */
+				General::Arena RequestArena;
 				/**
 				 * @brief Http request information
 				 */
@@ -127,20 +231,145 @@ namespace Peoplez
 				HttpResponse response;
 				String::PeoplezString InputBuffer;
 				String::PeoplezString OutputBuffer;
+				/**
+				 * @brief Complete responses that are not (completely) sent yet
+				 * @details Pipelined responses are queued in request order and written with a single gather write
+				 */
+				std::vector<String::PeoplezString> OutputQueue;
 				HttpSocketStatus Status;
 				bool SendableCBEnabled;
+				/**
+				 * @brief Indicates that the connection has to be closed as soon as the output queue is sent
+				 */
+				bool CloseAfterSend;
+				/**
+				 * @brief Indicates that reading from the socket was stopped (full output queue or paused body stream)
+				 */
+				bool ReceiveThrottled;
+				/**
+				 * @brief Handler of the body that is currently streamed; nullptr if the body is buffered
+				 */
+				HttpBodyStreamHandler * BodyStream;
+				/**
+				 * @brief Handler the request was routed to (see HttpRouter); kept alive until the next request although its route may be removed
+				 */
+				std::shared_ptr<HttpRequestHandler> RoutedHandler;
+				/**
+				 * @brief Number of body bytes that are not consumed yet (chunked: remaining allowed body length)
+				 */
+				uint64_t BodyRemaining;
+				/**
+				 * @brief Indicates that the BodyStream did not consume the last chunk completely
+				 */
+				bool BodyPaused;
+				/**
+				 * @brief Indicates that the body is decoded with the BodyDecoder
+				 */
+				bool BodyChunked;
+				/**
+				 * @brief Decoder for a body with chunked transfer coding
+				 */
+				ChunkedDecoder BodyDecoder;
+				/**
+				 * @brief Decoded body if it is not streamed to a BodyStream
+				 */
+				String::PeoplezString BodyBuffer;
+				/**
+				 * @brief Producer of the response body that is currently sent
+				 */
+				std::shared_ptr<HttpResponseStream> ResponseStream;
+				/**
+				 * @brief Indicates that the ResponseStream returned WAIT
+				 */
+				bool ResponsePaused;
+				/**
+				 * @brief Indicates that a chunk of the ResponseStream was queued already
+				 */
+				bool ResponseChunkSent;
+				/**
+				 * @brief HTTP/2 connection the connection was upgraded to (h2c); owns the socket afterwards
+				 */
+				std::shared_ptr<Http2Connection> Http2;
+				/**
+				 * @brief WebSocket connection the connection was upgraded to; owns the socket afterwards
+				 */
+				std::shared_ptr<WebSocketConnection> WebSocket;
+				/**
+				 * @brief Event stream that took over the connection; owns the socket afterwards
+				 */
+				std::shared_ptr<EventStream> Events;
 				std::mutex mut;
 				System::IO::Network::Socket * const sender;
 
 			private:
+				/**
+				 * @brief State of a deferred response
+				 */
+				enum DeferState : uint8_t
+				{
+					DEFER_NONE,
+					/**
+					 * @brief Deferred by the handler; ProcessRequest did not return yet
+					 */
+					DEFER_PROCESSING,
+					/**
+					 * @brief Connection waits for HttpCompletion::Complete
+					 */
+					DEFER_PARKED,
+					/**
+					 * @brief Completed; the response is sent by the connection
+					 */
+					DEFER_COMPLETED
+				};
+
 				HttpContext(HttpContext const & other) = delete;
+				/**
+				 * Parks the connection if the handler deferred the response (called after ProcessRequest)
+				 *
+				 * Context has to be locked
+				 *
+				 * @return Indicates whether the response has to be waited for; false if it can be sent now
+				 */
+				bool Park() noexcept;
+				/**
+				 * Takes over a deferred response after it was completed
+				 *
+				 * Context has to be locked
+				 *
+				 * @return Indicates whether a completed response has to be sent
+				 */
+				bool Unpark() noexcept;
+				/**
+				 * Marks the deferred response as completed and continues a parked connection (called by HttpCompletion)
+				 *
+				 * The connection is continued in a worker thread of completionScheduler, not in the calling thread.
+				 */
+				void CompleteDeferred() noexcept;
 
-				static const String::PeoplezString COMPARE_STRING_ACCEPT_LANGUAGE;
-				static const String::PeoplezString COMPARE_STRING_CONNECTION;
-				static const String::PeoplezString COMPARE_STRING_IF_NONE_MATCH;
-				static const String::PeoplezString COMPARE_STRING_CONTENT_LENGTH;
-				static const String::PeoplezString COMPARE_STRING_COOKIE;
-				static const String::PeoplezString COMPARE_STRING_HOST;
+				/**
+				 * @brief Continues the connection after a paused body or response (set by HttpClientInfo)
+				 */
+				std::function<void()> resume;
+				/**
+				 * @brief State of a deferred response (set by different threads)
+				 */
+				std::atomic<uint8_t> deferState;
+				/**
+				 * @brief Worker pool of the connection when the response was deferred; continues it after CompleteDeferred (nullptr: the completing thread)
+				 */
+				General::Scheduler * completionScheduler;
+				/**
+				 * @brief Handler of an accepted WebSocket handshake (see AcceptWebSocket)
+				 */
+				std::shared_ptr<WebSocketHandler> webSocketHandler;
+				/**
+				 * @brief Subprotocol of an accepted WebSocket handshake
+				 */
+				String::PeoplezString webSocketProtocol;
+				/**
+				 * @brief Event stream opened on an http/1.1 connection that is not started yet (see OpenEventStream)
+				 */
+				std::shared_ptr<EventStream> eventStream;
 			};
 		} // namespace Http
 	} // namespace Services
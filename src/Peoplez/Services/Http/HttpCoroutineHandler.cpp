@@ -0,0 +1,98 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "HttpCoroutineHandler.hpp"
+
+// Local includes
+#include "../../System/Logging/Logger.hpp"
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace System::Logging;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			namespace
+			{
+				/**
+				 * @brief Coroutine that starts immediately and destroys itself when it ends
+				 */
+				struct Detached final
+				{
+					struct promise_type final
+					{
+						Detached get_return_object() const noexcept {return {};}
+						std::suspend_never initial_suspend() const noexcept {return {};}
+						std::suspend_never final_suspend() const noexcept {return {};}
+						void return_void() const noexcept {}
+						void unhandled_exception() const noexcept {}
+					};
+				};
+
+				/**
+				 * Runs the handler task and sends the response afterwards
+				 *
+				 * @param task Task of the handler
+				 * @param completion Deferred response of the request
+				 */
+				Detached Run(General::Task<void> task, HttpCompletion completion)
+				{
+					try
+					{
+						co_await task;
+					}
+					catch(...)
+					{
+						Logger::LogException("Error in HttpCoroutineHandler::Handle", __FILE__, __LINE__);
+						completion.Context().response.SetError(HttpStatusCode::INTERNAL_SERVER_ERROR);
+					}
+
+					completion.Complete();
+				}
+			} // namespace
+
+			void HttpCoroutineHandler::ProcessRequest(HttpContext & context)
+			{
+				HttpCompletion completion = context.Defer();
+
+				Run(Handle(context), std::move(completion));
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTPCOROUTINEHANDLER_HPP_
+#define PEOPLEZ_SERVICES_HTTP_HTTPCOROUTINEHANDLER_HPP_
+
+// Local includes
+#include "../../General/Task.hpp"
+#include "HttpRequestHandler.hpp"
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Request handler that is written as coroutine
+			 *
+			 * @details
+			 * Handle may co_await other tasks, General::AsyncResult (results of backends), System::DelayQueue::Sleep and
+			 * System::IO::Network::ConnectionsManager::Readable (sockets of backends).
+			 * While it is suspended the response is deferred (see HttpContext::Defer): the connection is parked and
+			 * the worker thread continues with other connections. Handle is continued by the worker threads
+			 * (see General::Scheduler), not by the thread that provides the awaited result. The response is sent when Handle ends.
+			 * An exception that leaves Handle is answered with "500 Internal Server Error".
+			 */
+			class HttpCoroutineHandler : public HttpRequestHandler
+			{
+			public:
+				/**
+				 * Starts Handle in the calling thread; it runs until it completes or suspends
+				 */
+				void ProcessRequest(HttpContext & context) final;
+				/**
+				 * Answers a request by setting the response of the context
+				 *
+				 * @param context Context of the request (valid until the task ends)
+				 */
+				virtual General::Task<void> Handle(HttpContext & context) = 0;
+				virtual ~HttpCoroutineHandler() {}
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTPCOROUTINEHANDLER_HPP_
@@ -40,8 +40,16 @@
 #include "../../System/Logging/Logger.hpp"
 
 // Extern includes
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <zlib.h>
+#ifdef PEOPLEZ_BROTLI
+#include <brotli/encode.h>
+#endif
+#ifdef PEOPLEZ_ZSTD
+#include <zstd.h>
+#endif
 extern "C"
 {
 #include <sys/stat.h>
@@ -274,6 +282,41 @@ namespace Peoplez
 				return HttpMethods::UNKNOWN;
 			}
 
+			HttpHeaderField HttpFunctions::ToHttpHeaderField(PeoplezString const & name) noexcept
+			{
+				return ToHttpHeaderField(name.GetData(), name.Length());
+			}
+
+			HttpHeaderField HttpFunctions::ToHttpHeaderField(char const * const name, size_t const len) noexcept
+			{
+				using namespace HttpHeaderFieldHash;
+
+				if(len == 0 || len > MAX_NAME_LENGTH) return HttpHeaderField::UNKNOWN;
+
+				// Copy name to an aligned buffer (zero padded)
+				uint64_t words[MAX_NAME_LENGTH / 8] = {};
+				memcpy(words, name, len);
+
+				// Lower case 8 characters at once
+				// For ASCII bytes the high bit of (c + 0x3F) is set for c >= 'A'
+				// and the high bit of (c + 0x25) is set for c > 'Z'.
+				// Non ASCII bytes are left unchanged
+				for(size_t i = 0, end = (len + 7) / 8; i < end; ++i)
+				{
+					uint64_t const w = words[i];
+					uint64_t const heptets = w & 0x7F7F7F7F7F7F7F7F;
+					uint64_t const isUpper = (heptets + 0x3F3F3F3F3F3F3F3F) & ~(heptets + 0x2525252525252525) & ~w & 0x8080808080808080;
+
+					words[i] = w | (isUpper >> 2);
+				}
+
+				char const * const lower = (char const *) words;
+				HttpHeaderField const field = TABLE[Hash(lower, len, SEED)];
+				std::string_view const & fieldName = NAMES[(size_t)field];
+
+				return (fieldName.size() == len && !memcmp(fieldName.data(), lower, len)) ? field : HttpHeaderField::UNKNOWN;
+			}
+
 			PeoplezString HttpFunctions::ToPString(HttpMethods const method)
 			{
 				switch (method) {
@@ -300,6 +343,197 @@ namespace Peoplez
 				}
 			}
 
+			static char const * const WEEKDAYS = "SunMonTueWedThuFriSat";
+			static char const * const MONTHS = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+			/**
+			 * Reads a fixed number of decimal digits
+			 *
+			 * @param str First digit (leading spaces are allowed)
+			 * @param count Number of characters
+			 *
+			 * @return Value of the digits; -1 if invalid
+			 */
+			static int ParseDateDigits(char const * const str, size_t const count) noexcept
+			{
+				int result = 0;
+				bool digitFound = false;
+
+				for(size_t i = 0; i < count; ++i)
+				{
+					if(str[i] >= '0' && str[i] <= '9')
+					{
+						result = result * 10 + (str[i] - '0');
+						digitFound = true;
+					}
+					else if(str[i] != ' ' || digitFound) return -1;
+				}
+
+				return digitFound ? result : -1;
+			}
+
+			/**
+			 * Identifies a three letter month name
+			 *
+			 * @return Month (0 - 11); -1 if invalid
+			 */
+			static int ParseDateMonth(char const * const str) noexcept
+			{
+				for(int i = 0; i < 12; ++i)
+				{
+					if(!memcmp(str, MONTHS + 3 * i, 3)) return i;
+				}
+
+				return -1;
+			}
+
+			/**
+			 * Calculates the time of a date in UTC
+			 *
+			 * @return Seconds since epoch; -1 if the date is invalid
+			 */
+			static time_t DateToTime(int year, int const month, int const day, int const hour, int const minute, int const second) noexcept
+			{
+				if(year < 1970 || month < 0 || day < 1 || day > 31 || hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 60) return -1;
+
+				// Days since epoch (proleptic gregorian calendar, March based year)
+				unsigned int const m = month + 1;
+				year -= m <= 2;
+
+				int const era = year / 400;
+				unsigned int const yearOfEra = year - era * 400;
+				unsigned int const dayOfYear = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + day - 1;
+				unsigned int const dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+				int64_t const days = (int64_t)era * 146097 + dayOfEra - 719468;
+
+				return (time_t)(days * 86400 + hour * 3600 + minute * 60 + second);
+			}
+
+			void HttpFunctions::FormatHttpDate(time_t const time, char * const dest) noexcept
+			{
+				struct tm date;
+				gmtime_r(&time, &date);
+
+				// Not locale dependent (unlike strftime)
+				memcpy(dest, WEEKDAYS + 3 * date.tm_wday, 3);
+				memcpy(dest + 3, ", ", 2);
+				dest[5] = '0' + date.tm_mday / 10;
+				dest[6] = '0' + date.tm_mday % 10;
+				dest[7] = ' ';
+				memcpy(dest + 8, MONTHS + 3 * date.tm_mon, 3);
+				dest[11] = ' ';
+
+				int const year = date.tm_year + 1900;
+				dest[12] = '0' + (year / 1000) % 10;
+				dest[13] = '0' + (year / 100) % 10;
+				dest[14] = '0' + (year / 10) % 10;
+				dest[15] = '0' + year % 10;
+				dest[16] = ' ';
+				dest[17] = '0' + date.tm_hour / 10;
+				dest[18] = '0' + date.tm_hour % 10;
+				dest[19] = ':';
+				dest[20] = '0' + date.tm_min / 10;
+				dest[21] = '0' + date.tm_min % 10;
+				dest[22] = ':';
+				dest[23] = '0' + date.tm_sec / 10;
+				dest[24] = '0' + date.tm_sec % 10;
+				memcpy(dest + 25, " GMT", 4);
+			}
+
+			time_t HttpFunctions::ParseHttpDate(PeoplezString const & str) noexcept
+			{
+				char const * const data = str.GetData();
+				size_t const len = str.Length();
+
+				// If IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT") ...
+				// Else if RFC 850 date ("Sunday, 06-Nov-94 08:49:37 GMT") ...
+				// Else if asctime date ("Sun Nov  6 08:49:37 1994") ...
+				if(len == HTTP_DATE_LENGTH && data[3] == ',')
+				{
+					if(memcmp(data + 25, " GMT", 4)) return -1;
+
+					return DateToTime(ParseDateDigits(data + 12, 4), ParseDateMonth(data + 8), ParseDateDigits(data + 5, 2), ParseDateDigits(data + 17, 2), ParseDateDigits(data + 20, 2), ParseDateDigits(data + 23, 2));
+				}
+				else if(len > 24 && len < 35)
+				{
+					char const * const date = (char const *) memchr(data, ',', len);
+
+					if(!date || data + len - date != 24 || memcmp(data + len - 4, " GMT", 4)) return -1;
+
+					// Two digit years refer to the last century up to 1969
+					int year = ParseDateDigits(date + 9, 2);
+					if(year >= 0) year += year < 70 ? 2000 : 1900;
+
+					return DateToTime(year, ParseDateMonth(date + 5), ParseDateDigits(date + 2, 2), ParseDateDigits(date + 12, 2), ParseDateDigits(date + 15, 2), ParseDateDigits(date + 18, 2));
+				}
+				else if(len == 24)
+				{
+					return DateToTime(ParseDateDigits(data + 20, 4), ParseDateMonth(data + 4), ParseDateDigits(data + 8, 2), ParseDateDigits(data + 11, 2), ParseDateDigits(data + 14, 2), ParseDateDigits(data + 17, 2));
+				}
+
+				return -1;
+			}
+
+			PeoplezString HttpFunctions::Compress(PeoplezString const & data, HttpCompression const compression)
+			{
+				size_t size = 0;
+				std::unique_ptr<unsigned char[]> buffer;
+
+				switch(compression)
+				{
+				case HTTP_COMPRESSION_GZIP:
+				case HTTP_COMPRESSION_DEFLATE:
+				{
+					z_stream strm = z_stream();
+
+					// Window bits + 16 for the gzip wrapper, zlib wrapper for deflate (RFC 7230 Section 4.2.2)
+					if(deflateInit2(&strm, Z_BEST_COMPRESSION, Z_DEFLATED, compression == HTTP_COMPRESSION_GZIP ? 16 + 15 : 15, 9, Z_DEFAULT_STRATEGY) != Z_OK) return PeoplezString();
+
+					// Single call with a buffer that is large enough in every case
+					size = deflateBound(&strm, data.Length());
+					buffer.reset(new unsigned char[size]);
+
+					strm.next_in = (unsigned char *) data.GetData();
+					strm.avail_in = data.Length();
+					strm.next_out = buffer.get();
+					strm.avail_out = size;
+
+					int const result = deflate(&strm, Z_FINISH);
+					size = strm.total_out;
+					deflateEnd(&strm);
+
+					if(result != Z_STREAM_END) return PeoplezString();
+
+					break;
+				}
+#ifdef PEOPLEZ_BROTLI
+				case HTTP_COMPRESSION_BROTLI:
+					size = BrotliEncoderMaxCompressedSize(data.Length());
+					if(!size) return PeoplezString();
+					buffer.reset(new unsigned char[size]);
+
+					if(!BrotliEncoderCompress(BROTLI_MAX_QUALITY, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_GENERIC, data.Length(), (uint8_t const *) data.GetData(), &size, buffer.get())) return PeoplezString();
+
+					break;
+#endif
+#ifdef PEOPLEZ_ZSTD
+				case HTTP_COMPRESSION_ZSTD:
+					size = ZSTD_compressBound(data.Length());
+					buffer.reset(new unsigned char[size]);
+
+					// Highest level without the memory requirements of the ultra levels
+					size = ZSTD_compress(buffer.get(), size, data.GetData(), data.Length(), 19);
+					if(ZSTD_isError(size)) return PeoplezString();
+
+					break;
+#endif
+				default:
+					return PeoplezString();
+				}
+
+				return PeoplezString((char const *) buffer.get(), size);
+			}
+
 	 		PeoplezString HttpFunctions::Shorten(PeoplezString text, FileBeginsWith const beginsWith)
 	 		{
 	 			char *const data = new char[text.Length() + 1];
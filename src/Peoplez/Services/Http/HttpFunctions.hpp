@@ -41,6 +41,10 @@
 #include "../../General/Enums.hpp"
 #include "Enums.hpp"
 #include "FileType.hpp"
+#include "HttpHeaderField.hpp"
+
+// Extern includes
+#include <ctime>
 
 namespace Peoplez
 {
@@ -91,8 +95,67 @@ namespace Peoplez
 				 * @return HttpMethod that is represented in the given string
 				 */
 				static HttpMethods ToHttpMethod(String::PeoplezString const & str) __attribute__((pure));
+				/**
+				 * Identifies the well known header field with the given name
+				 *
+				 * Header field names are case insensitive. The name is lower cased word wise and looked up in a perfect hash table.
+				 *
+				 * @param name Name of the header field
+				 *
+				 * @return Header field with the given name; UNKNOWN if it is not a well known one
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				static HttpHeaderField ToHttpHeaderField(String::PeoplezString const & name) noexcept __attribute__((pure));
+				/**
+				 * @copydoc ToHttpHeaderField(String::PeoplezString const & name)
+				 *
+				 * @param len Length of the name
+				 */
+				static HttpHeaderField ToHttpHeaderField(char const * name, size_t len) noexcept __attribute__((pure));
 
 				static String::PeoplezString ToPString(HttpMethods const method) __attribute__((pure));
+				/**
+				 * Writes the given time as HTTP-date (IMF-fixdate, RFC 7231 Section 7.1.1.1)
+				 *
+				 * @param time Time to format
+				 * @param dest Target for the date (at least HTTP_DATE_LENGTH bytes, not zero terminated)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				static void FormatHttpDate(time_t time, char * dest) noexcept;
+				/**
+				 * Parses an HTTP-date (IMF-fixdate, obsolete RFC 850 format or asctime format)
+				 *
+				 * @param str Textual representation of the date
+				 *
+				 * @return Parsed time; -1 if the date is invalid
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				static time_t ParseHttpDate(String::PeoplezString const & str) noexcept __attribute__((pure));
+				/**
+				 * Compresses data with the given content coding (with the best compression level, e.g. once per static resource)
+				 *
+				 * Brotli and zstd are only available if the library is built with PEOPLEZ_BROTLI and PEOPLEZ_ZSTD respectively.
+				 *
+				 * @param data Data to compress
+				 * @param compression Content coding to use
+				 *
+				 * @return Compressed data; empty if the content coding is not available or the compression failed
+				 *
+				 * @par Exception safety
+				 *  Strong exception guarantee
+				 */
+				static String::PeoplezString Compress(String::PeoplezString const & data, HttpCompression compression);
+
+				/**
+				 * @brief Length of an IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT")
+				 */
+				static constexpr size_t HTTP_DATE_LENGTH = 29;
 
 			private:
 		 		/**
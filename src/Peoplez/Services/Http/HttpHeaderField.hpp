@@ -0,0 +1,280 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTPHEADERFIELD_HPP_
+#define PEOPLEZ_SERVICES_HTTP_HTTPHEADERFIELD_HPP_
+
+// External includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Well known http request header fields
+			 * @details Header fields that are identified by the request parser so that their values can be looked up in O(1)
+			 */
+			enum class HttpHeaderField : unsigned char
+			{
+				UNKNOWN = 0,
+				ACCEPT,
+				ACCEPT_CHARSET,
+				ACCEPT_ENCODING,
+				ACCEPT_LANGUAGE,
+				ACCESS_CONTROL_REQUEST_HEADERS,
+				ACCESS_CONTROL_REQUEST_METHOD,
+				AUTHORIZATION,
+				CACHE_CONTROL,
+				CONNECTION,
+				CONTENT_ENCODING,
+				CONTENT_LENGTH,
+				CONTENT_TYPE,
+				COOKIE,
+				DATE,
+				DNT,
+				EXPECT,
+				FORWARDED,
+				FROM,
+				HOST,
+				HTTP2_SETTINGS,
+				IF_MATCH,
+				IF_MODIFIED_SINCE,
+				IF_NONE_MATCH,
+				IF_RANGE,
+				IF_UNMODIFIED_SINCE,
+				KEEP_ALIVE,
+				MAX_FORWARDS,
+				ORIGIN,
+				PRAGMA,
+				PROXY_AUTHORIZATION,
+				RANGE,
+				REFERER,
+				SEC_FETCH_DEST,
+				SEC_FETCH_MODE,
+				SEC_FETCH_SITE,
+				SEC_FETCH_USER,
+				SEC_WEBSOCKET_EXTENSIONS,
+				SEC_WEBSOCKET_KEY,
+				SEC_WEBSOCKET_PROTOCOL,
+				SEC_WEBSOCKET_VERSION,
+				TE,
+				TRAILER,
+				TRANSFER_ENCODING,
+				UPGRADE,
+				UPGRADE_INSECURE_REQUESTS,
+				USER_AGENT,
+				VIA,
+				WARNING,
+				X_FORWARDED_FOR,
+				X_FORWARDED_HOST,
+				X_FORWARDED_PROTO,
+				X_REQUESTED_WITH,
+				MAX = X_REQUESTED_WITH
+			};
+
+			/**
+			 * @brief Number of entries in HttpHeaderField (including UNKNOWN)
+			 */
+			constexpr size_t HTTP_HEADER_FIELD_COUNT = (size_t)HttpHeaderField::MAX + 1;
+
+			/**
+			 * @brief Compile time generated perfect hash over the names of the well known header fields
+			 * @details The hash works on lower case names. The seed is searched at compile time so that no two names share a slot.
+			 * A lookup therefore needs exactly one hash calculation and one comparison.
+			 */
+			namespace HttpHeaderFieldHash
+			{
+				/**
+				 * @brief Lower case names of the header fields (indexed by HttpHeaderField)
+				 */
+				constexpr std::array<std::string_view, HTTP_HEADER_FIELD_COUNT> NAMES =
+				{
+					"",
+					"accept",
+					"accept-charset",
+					"accept-encoding",
+					"accept-language",
+					"access-control-request-headers",
+					"access-control-request-method",
+					"authorization",
+					"cache-control",
+					"connection",
+					"content-encoding",
+					"content-length",
+					"content-type",
+					"cookie",
+					"date",
+					"dnt",
+					"expect",
+					"forwarded",
+					"from",
+					"host",
+					"http2-settings",
+					"if-match",
+					"if-modified-since",
+					"if-none-match",
+					"if-range",
+					"if-unmodified-since",
+					"keep-alive",
+					"max-forwards",
+					"origin",
+					"pragma",
+					"proxy-authorization",
+					"range",
+					"referer",
+					"sec-fetch-dest",
+					"sec-fetch-mode",
+					"sec-fetch-site",
+					"sec-fetch-user",
+					"sec-websocket-extensions",
+					"sec-websocket-key",
+					"sec-websocket-protocol",
+					"sec-websocket-version",
+					"te",
+					"trailer",
+					"transfer-encoding",
+					"upgrade",
+					"upgrade-insecure-requests",
+					"user-agent",
+					"via",
+					"warning",
+					"x-forwarded-for",
+					"x-forwarded-host",
+					"x-forwarded-proto",
+					"x-requested-with"
+				};
+
+				/**
+				 * @brief Maximum length of a well known header field name (multiple of 8 for word wise lower casing)
+				 */
+				constexpr size_t MAX_NAME_LENGTH = 32;
+				/**
+				 * @brief Number of slots in the hash table (power of 2)
+				 */
+				constexpr size_t TABLE_SIZE = 256;
+
+				/**
+				 * Calculates the (seeded) hash of a lower case header field name
+				 *
+				 * @param str Lower case name
+				 * @param len Length of the name
+				 * @param seed Seed of the hash function
+				 *
+				 * @return Slot in the hash table
+				 */
+				constexpr size_t Hash(char const * const str, size_t const len, uint32_t const seed) noexcept
+				{
+					uint32_t h = seed ^ (uint32_t)len;
+
+					for(size_t i = 0; i < len; ++i) h = (h ^ (unsigned char)str[i]) * 0x01000193;
+
+					return (h ^ (h >> 15)) & (TABLE_SIZE - 1);
+				}
+
+				/**
+				 * Searches the first seed that maps all names to distinct slots
+				 *
+				 * @return Seed for a perfect hash over NAMES
+				 */
+				constexpr uint32_t FindSeed() noexcept
+				{
+					for(uint32_t seed = 0x811C9DC5;; ++seed)
+					{
+						bool used[TABLE_SIZE] = {};
+						bool collision = false;
+
+						for(size_t i = 1; i < HTTP_HEADER_FIELD_COUNT && !collision; ++i)
+						{
+							size_t const slot = Hash(NAMES[i].data(), NAMES[i].size(), seed);
+
+							if(used[slot]) collision = true;
+							else used[slot] = true;
+						}
+
+						if(!collision) return seed;
+					}
+				}
+
+				/**
+				 * @brief Seed of the perfect hash
+				 */
+				constexpr uint32_t SEED = FindSeed();
+
+				/**
+				 * Creates the hash table mapping slots to header fields
+				 *
+				 * @return Hash table (UNKNOWN for empty slots)
+				 */
+				constexpr std::array<HttpHeaderField, TABLE_SIZE> CreateTable() noexcept
+				{
+					std::array<HttpHeaderField, TABLE_SIZE> result = {};
+
+					for(size_t i = 1; i < HTTP_HEADER_FIELD_COUNT; ++i) result[Hash(NAMES[i].data(), NAMES[i].size(), SEED)] = (HttpHeaderField)i;
+
+					return result;
+				}
+
+				/**
+				 * @brief Hash table mapping slots to header fields
+				 */
+				constexpr std::array<HttpHeaderField, TABLE_SIZE> TABLE = CreateTable();
+
+				/**
+				 * Identifies a lower case header field name at compile time
+				 *
+				 * @param name Lower case name of the header field
+				 *
+				 * @return Header field with the given name; UNKNOWN if it is not a well known one
+				 */
+				constexpr HttpHeaderField Lookup(std::string_view const name) noexcept
+				{
+					if(name.empty() || name.size() > MAX_NAME_LENGTH) return HttpHeaderField::UNKNOWN;
+
+					HttpHeaderField const field = TABLE[Hash(name.data(), name.size(), SEED)];
+
+					return NAMES[(size_t)field] == name ? field : HttpHeaderField::UNKNOWN;
+				}
+			} // namespace HttpHeaderFieldHash
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTPHEADERFIELD_HPP_
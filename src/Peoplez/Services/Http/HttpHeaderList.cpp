@@ -0,0 +1,187 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "HttpHeaderList.hpp"
+
+// Extern includes
+#include <cstring>
+#include <strings.h>
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace String;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * Compares two header field names case insensitive
+			 */
+			static inline bool NameEquals(PeoplezString const & a, PeoplezString const & b) noexcept
+			{
+				return a.Length() == b.Length() && !strncasecmp(a.GetData(), b.GetData(), a.Length());
+			}
+
+			bool HttpHeaderList::Add(PeoplezString const & name, PeoplezString const & value)
+			{
+				if(!IsValid(name, value)) return false;
+
+				if(count < INLINE_CAPACITY)
+				{
+					inlineEntries[count].first = name;
+					inlineEntries[count].second = value;
+				}
+				else overflow.emplace_back(name, value);
+
+				++count;
+
+				return true;
+			}
+
+			bool HttpHeaderList::Set(PeoplezString const & name, PeoplezString const & value)
+			{
+				if(!IsValid(name, value)) return false;
+
+				size_t pos = 0;
+				while(pos < count && !NameEquals(At(pos).first, name)) ++pos;
+
+				if(pos == count) return Add(name, value);
+
+				At(pos).second = value;
+
+				// Further fields with the same name
+				for(size_t i = count - 1; i > pos; --i)
+				{
+					if(NameEquals(At(i).first, name)) Erase(i);
+				}
+
+				return true;
+			}
+
+			size_t HttpHeaderList::Remove(PeoplezString const & name) noexcept
+			{
+				size_t removed = 0;
+
+				for(size_t i = count; i > 0; --i)
+				{
+					if(NameEquals(At(i - 1).first, name))
+					{
+						Erase(i - 1);
+						++removed;
+					}
+				}
+
+				return removed;
+			}
+
+			PeoplezString const * HttpHeaderList::Find(PeoplezString const & name) const noexcept
+			{
+				for(size_t i = 0; i < count; ++i)
+				{
+					if(NameEquals((*this)[i].first, name)) return &(*this)[i].second;
+				}
+
+				return nullptr;
+			}
+
+			void HttpHeaderList::Clear() noexcept
+			{
+				for(size_t i = 0; i < count && i < INLINE_CAPACITY; ++i)
+				{
+					inlineEntries[i].first.Clear();
+					inlineEntries[i].second.Clear();
+				}
+
+				overflow.clear();
+				count = 0;
+			}
+
+			size_t HttpHeaderList::SerializedLength() const noexcept
+			{
+				size_t result = 0;
+
+				// "Name: value\r\n"
+				for(size_t i = 0; i < count; ++i) result += (*this)[i].first.Length() + (*this)[i].second.Length() + 4;
+
+				return result;
+			}
+
+			void HttpHeaderList::AppendTo(PeoplezString & dest) const
+			{
+				for(size_t i = 0; i < count; ++i)
+				{
+					Entry const & entry = (*this)[i];
+
+					dest.Append(entry.first);
+					dest.Append(": ", 2);
+					dest.Append(entry.second);
+					dest.Append("\r\n", 2);
+				}
+			}
+
+			void HttpHeaderList::Erase(size_t const pos) noexcept
+			{
+				// Copies only share the buffers (moved-from strings must not be reused)
+				for(size_t i = pos + 1; i < count; ++i) At(i - 1) = At(i);
+
+				--count;
+
+				if(count >= INLINE_CAPACITY) overflow.pop_back();
+				else
+				{
+					inlineEntries[count].first.Clear();
+					inlineEntries[count].second.Clear();
+				}
+			}
+
+			bool HttpHeaderList::IsValid(PeoplezString const & name, PeoplezString const & value) noexcept
+			{
+				if(name.IsEmpty()) return false;
+
+				// Line breaks would end the field (response splitting), a colon would end the name
+				for(size_t i = 0; i < name.Length(); ++i)
+				{
+					char const c = name[i];
+					if(c == '\r' || c == '\n' || c == ':' || c == ' ' || c == '\t') return false;
+				}
+
+				return !memchr(value.GetData(), '\r', value.Length()) && !memchr(value.GetData(), '\n', value.Length());
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
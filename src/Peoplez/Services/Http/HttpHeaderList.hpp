@@ -0,0 +1,171 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTPHEADERLIST_H_
+#define PEOPLEZ_SERVICES_HTTP_HTTPHEADERLIST_H_
+
+// Local includes
+#include "../../String/PeoplezString.hpp"
+
+// Extern includes
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Additional header fields of a response in insertion order
+			 * @details The first INLINE_CAPACITY entries are stored inside the object, only further ones on the heap.
+			 * Clear keeps the storage, so a list that is reused for the responses of a connection does not allocate.
+			 */
+			class HttpHeaderList final
+			{
+			public:
+				typedef std::pair<String::PeoplezString, String::PeoplezString> Entry;
+
+				/**
+				 * @brief Forward iterator over the entries
+				 */
+				class ConstIterator final
+				{
+				public:
+					ConstIterator(HttpHeaderList const * list, size_t pos) noexcept : list(list), pos(pos) {}
+
+					inline Entry const & operator*() const noexcept {return (*list)[pos];}
+					inline Entry const * operator->() const noexcept {return &(*list)[pos];}
+					inline ConstIterator & operator++() noexcept {++pos; return *this;}
+					inline bool operator==(ConstIterator const & other) const noexcept {return pos == other.pos;}
+					inline bool operator!=(ConstIterator const & other) const noexcept {return pos != other.pos;}
+
+				private:
+					HttpHeaderList const * list;
+					size_t pos;
+				};
+
+				HttpHeaderList() noexcept : count(0) {}
+
+				/**
+				 * Adds a header field (also if a field with the same name exists already)
+				 *
+				 * @param name Name of the header field (e.g. "Cache-Control")
+				 * @param value Value of the header field
+				 *
+				 * @return False if name or value are invalid (empty name, line breaks or colon in the name); the field is not added then
+				 *
+				 * @par Exception safety
+				 *  Strong exception guarantee
+				 */
+				bool Add(String::PeoplezString const & name, String::PeoplezString const & value);
+				/**
+				 * Sets a header field: replaces the value of the first field with the same name (case insensitive) and removes further ones
+				 *
+				 * @param name Name of the header field (e.g. "Cache-Control")
+				 * @param value Value of the header field
+				 *
+				 * @return False if name or value are invalid (see Add); the list is unchanged then
+				 *
+				 * @par Exception safety
+				 *  Strong exception guarantee
+				 */
+				bool Set(String::PeoplezString const & name, String::PeoplezString const & value);
+				/**
+				 * Removes all header fields with the given name (case insensitive)
+				 *
+				 * @param name Name of the header field
+				 *
+				 * @return Number of removed fields
+				 */
+				size_t Remove(String::PeoplezString const & name) noexcept;
+				/**
+				 * Searches the first header field with the given name (case insensitive)
+				 *
+				 * @param name Name of the header field
+				 *
+				 * @return Pointer to the value; nullptr if not found
+				 */
+				String::PeoplezString const * Find(String::PeoplezString const & name) const noexcept __attribute__((pure));
+				/**
+				 * Removes all entries (the storage is kept for reuse)
+				 */
+				void Clear() noexcept;
+				/**
+				 * Calculates the length of the entries serialized for HTTP/1.1 (see AppendTo)
+				 *
+				 * @return Length in bytes
+				 */
+				size_t SerializedLength() const noexcept __attribute__((pure));
+				/**
+				 * Appends the entries as HTTP/1.1 header lines ("Name: value\r\n" each)
+				 *
+				 * @param dest Target (should have SerializedLength bytes of free capacity)
+				 */
+				void AppendTo(String::PeoplezString & dest) const;
+
+				inline Entry const & operator[](size_t const pos) const noexcept {return pos < INLINE_CAPACITY ? inlineEntries[pos] : overflow[pos - INLINE_CAPACITY];}
+				inline ConstIterator begin() const noexcept {return ConstIterator(this, 0);}
+				inline ConstIterator end() const noexcept {return ConstIterator(this, count);}
+				inline bool empty() const noexcept {return !count;}
+				inline size_t size() const noexcept {return count;}
+
+				/**
+				 * @brief Number of entries stored without heap allocation
+				 */
+				static constexpr size_t INLINE_CAPACITY = 8;
+
+			private:
+				inline Entry & At(size_t const pos) noexcept {return pos < INLINE_CAPACITY ? inlineEntries[pos] : overflow[pos - INLINE_CAPACITY];}
+				/**
+				 * Removes the entry at the given position (keeps the order of the others)
+				 */
+				void Erase(size_t pos) noexcept;
+				/**
+				 * Checks name and value for characters that would break the response (response splitting)
+				 */
+				static bool IsValid(String::PeoplezString const & name, String::PeoplezString const & value) noexcept __attribute__((pure));
+
+				std::array<Entry, INLINE_CAPACITY> inlineEntries;
+				std::vector<Entry> overflow;
+				size_t count;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTPHEADERLIST_H_
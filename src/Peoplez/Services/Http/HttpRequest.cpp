@@ -36,24 +36,51 @@
 // Own headers
 #include "HttpRequest.hpp"
 
+// Local includes
+#include "../../System/Logging/Logger.hpp"
+#include "HttpFunctions.hpp"
+
+// Extern includes
+#include <cstring>
+#include <strings.h>
+
 namespace Peoplez
 {
 	// Local namespaces
 	using namespace String;
+	using namespace System::Logging;
 
 	namespace Services
 	{
 		namespace Http
 		{
+			/**
+			 * Empties a container and gives its memory back to the arena
+			 *
+			 * (clear() would keep the capacity, which is invalid after the arena is reset)
+			 */
+			template<class Container>
+			static inline void Release(Container & container)
+			{
+				container = Container(container.get_allocator());
+			}
+
 			void HttpRequest::Clean()
 			{
 				eTag = 0;
+				connectionUpgrade = false;
+				http11 = true;
 				//rawUrl.clear();
 				contentLength = -1;
-				cookies.clear();
-				headers.clear();
+				transferCoding = TransferCoding::NONE;
+				cookieString.Clear();
+				Release(cookies);
+				cookiesParsed = false;
+				Release(headers);
+				headerPositions.fill(NO_HEADER_POSITION);
 				httpMethod = HttpMethods::UNKNOWN;
-				postParams.clear();
+				Release(postParams);
+				Release(routeParams);
 				userLanguages.Clear();
 				//preferredLanguage = (Language) -1;
 				uri.Clean();
@@ -120,18 +147,277 @@ namespace Peoplez
 				return result;
 			}
 
-			PeoplezString HttpRequest::GetHeaderValue(PeoplezString const & name)
+			void HttpRequest::ParseCookies() const
+			{
+				cookiesParsed = true;
+
+				char const * pos = cookieString.GetData();
+				char const * const end = pos + cookieString.Length();
+
+				// For every "name=value" section ...
+				while(pos < end)
+				{
+					char const * sectionEnd = (char const *) memchr(pos, ';', end - pos);
+					if(!sectionEnd) sectionEnd = end;
+
+					if(sectionEnd > pos)
+					{
+						char const * const posEqual = (char const *) memchr(pos, '=', sectionEnd - pos);
+
+						if(!posEqual)
+						{
+							Logger::LogEvent("Unreadable cookie");
+							break;
+						}
+
+						PeoplezString name = cookieString.Substring(pos - cookieString.GetData(), posEqual - pos);
+						PeoplezString value = cookieString.Substring(posEqual + 1 - cookieString.GetData(), sectionEnd - posEqual - 1);
+
+						name.Trim();
+						value.Trim();
+
+						cookies.push_back(HttpCookie(name, value));
+					}
+
+					pos = sectionEnd + 1;
+				}
+			}
+
+			/**
+			 * Compares two names (optionally case insensitive)
+			 */
+			static inline bool NameEquals(std::string_view const a, std::string_view const b, bool const ignoreCase) noexcept
 			{
+				if(a.size() != b.size()) return false;
+
+				return ignoreCase ? !strncasecmp(a.data(), b.data(), a.size()) : a == b;
+			}
+
+			PeoplezString HttpRequest::GetHeaderValue(PeoplezString const & name) const
+			{
+				HttpHeaderField const field = HttpFunctions::ToHttpHeaderField(name);
+				if(field != HttpHeaderField::UNKNOWN) return GetHeaderValue(field);
+
 				for(size_t i = 0; i < headers.size(); ++i)
 				{
-					if(headers[i].first == name) return headers[i].second;
+					if(NameEquals(headers[i].first.View(), name.View(), true)) return headers[i].second;
+				}
+
+				return PeoplezString();
+			}
+
+			std::string_view HttpRequest::HeaderView(std::string_view const name) const noexcept
+			{
+				HttpHeaderField const field = HttpFunctions::ToHttpHeaderField(name.data(), name.size());
+				if(field != HttpHeaderField::UNKNOWN) return HeaderView(field);
+
+				for(std::pair<PeoplezString, PeoplezString> const & header : headers)
+				{
+					if(NameEquals(header.first.View(), name, true)) return header.second.View();
+				}
+
+				return std::string_view();
+			}
+
+			HttpCookie const * HttpRequest::FindCookie(std::string_view const name, bool const ignoreCase) const
+			{
+				for(HttpCookie const & cookie : CookiesView())
+				{
+					if(NameEquals(cookie.Name.View(), name, ignoreCase)) return &cookie;
+				}
+
+				return nullptr;
+			}
+
+			PostParam const * HttpRequest::FindPostParam(std::string_view const name, bool const ignoreCase) const noexcept
+			{
+				for(PostParam const & param : postParams)
+				{
+					if(NameEquals(param.Name.View(), name, ignoreCase)) return &param;
+				}
+
+				return nullptr;
+			}
+
+			PeoplezString HttpRequest::GetHeaderValue(HttpHeaderField const field) const
+			{
+				uint16_t const pos = headerPositions[(size_t)field];
+
+				return pos != NO_HEADER_POSITION ? headers[pos].second : PeoplezString();
+			}
+
+			PeoplezString HttpRequest::RouteParam(std::string_view const name) const
+			{
+				for(std::pair<std::string_view, PeoplezString> const & param : routeParams)
+				{
+					if(param.first == name) return param.second;
 				}
 
 				return PeoplezString();
 			}
 
-			HttpRequestUri::HttpRequestUri(String::PeoplezString uriString, HttpMethods const httpMethod) :
-					scheme(uriString.Substring(0,0)), authorityString(scheme), pathString(scheme), queryString(scheme)
+			bool HttpRequest::IsNotModified(size_t const currentETag, time_t const lastModified) const noexcept
+			{
+				try
+				{
+					// If-None-Match takes precedence (RFC 7232 Section 3.3)
+					if(HasHeader(HttpHeaderField::IF_NONE_MATCH))
+					{
+						PeoplezString const list = GetHeaderValue(HttpHeaderField::IF_NONE_MATCH);
+						size_t pos = 0;
+
+						if(!currentETag) return false;
+
+						while(pos < list.Length())
+						{
+							// Skip separators
+							if(list[pos] == ',' || list[pos] == ' ' || list[pos] == '\t')
+							{
+								++pos;
+								continue;
+							}
+
+							if(list[pos] == '*') return true;
+
+							// Weak comparison ignores the weakness indicator
+							if(list.EqualTo(pos, "W/", 2)) pos += 2;
+
+							if(pos >= list.Length() || list[pos] != '"') return false;
+
+							size_t const end = list.Find('"', pos + 1);
+							if(end == PeoplezString::NPOS) return false;
+
+							// Entity tags are created as hex numbers (see HttpResponse)
+							if(end - pos - 1 <= (sizeof(size_t) << 1) && end > pos + 1)
+							{
+								size_t value = 0;
+								bool valid = true;
+
+								for(size_t i = pos + 1; i < end && valid; ++i)
+								{
+									char const c = list[i];
+
+									if(c >= '0' && c <= '9') value = (value << 4) | (c - '0');
+									else if(c >= 'A' && c <= 'F') value = (value << 4) | (c - 'A' + 10);
+									else if(c >= 'a' && c <= 'f') value = (value << 4) | (c - 'a' + 10);
+									else valid = false;
+								}
+
+								if(valid && value == currentETag) return true;
+							}
+
+							pos = end + 1;
+						}
+
+						return false;
+					}
+
+					if(lastModified <= 0 || !HasHeader(HttpHeaderField::IF_MODIFIED_SINCE)) return false;
+
+					// Only for GET and HEAD (RFC 7232 Section 3.3)
+					if(httpMethod != HttpMethods::GET && httpMethod != HttpMethods::HEAD) return false;
+
+					time_t const since = HttpFunctions::ParseHttpDate(GetHeaderValue(HttpHeaderField::IF_MODIFIED_SINCE));
+
+					return since >= 0 && lastModified <= since;
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in HttpRequest::IsNotModified", __FILE__, __LINE__);
+				}
+
+				return false;
+			}
+
+			/**
+			 * Parses the quality value of an entry of an Accept-* header field (e.g. ";q=0.5")
+			 *
+			 * @param pos Begin of the parameters of the entry
+			 * @param end End of the entry
+			 *
+			 * @return Quality value in thousandths (1000 if none or invalid)
+			 */
+			static uint16_t ParseQValue(char const * pos, char const * const end) noexcept
+			{
+				while((pos = (char const *) memchr(pos, ';', end - pos)))
+				{
+					++pos;
+					while(pos < end && (*pos == ' ' || *pos == '\t')) ++pos;
+
+					if(end - pos >= 2 && (*pos == 'q' || *pos == 'Q') && pos[1] == '=')
+					{
+						pos += 2;
+						if(pos >= end || (*pos != '0' && *pos != '1')) return 1000;
+
+						uint16_t result = (*pos - '0') * 1000;
+
+						if(++pos < end && *pos == '.')
+						{
+							uint16_t factor = 100;
+							for(++pos; pos < end && factor && *pos >= '0' && *pos <= '9'; ++pos, factor /= 10) result += (*pos - '0') * factor;
+						}
+
+						return result > 1000 ? 1000 : result;
+					}
+				}
+
+				return 1000;
+			}
+
+			std::array<uint16_t, HTTP_COMPRESSION_COUNT> HttpRequest::AcceptedCompressions() const noexcept
+			{
+				std::array<uint16_t, HTTP_COMPRESSION_COUNT> result;
+				result.fill(0);
+				result[HTTP_COMPRESSION_NONE] = 1000;
+
+				if(!HasHeader(HttpHeaderField::ACCEPT_ENCODING)) return result;
+
+				// Quality values of the listed codings and of "*" (NOT_LISTED if not listed)
+				constexpr uint16_t NOT_LISTED = 0xFFFF;
+				std::array<uint16_t, HTTP_COMPRESSION_COUNT> listed;
+				listed.fill(NOT_LISTED);
+				uint16_t any = NOT_LISTED;
+
+				PeoplezString const & list = headers[headerPositions[(size_t)HttpHeaderField::ACCEPT_ENCODING]].second;
+				char const * pos = list.GetData();
+				char const * const end = pos + list.Length();
+
+				// For every entry (e.g. "br;q=0.8") ...
+				while(pos < end)
+				{
+					char const * sectionEnd = (char const *) memchr(pos, ',', end - pos);
+					if(!sectionEnd) sectionEnd = end;
+
+					while(pos < sectionEnd && (*pos == ' ' || *pos == '\t')) ++pos;
+
+					char const * codingEnd = pos;
+					while(codingEnd < sectionEnd && *codingEnd != ';' && *codingEnd != ' ' && *codingEnd != '\t') ++codingEnd;
+
+					size_t const len = codingEnd - pos;
+					uint16_t const q = ParseQValue(codingEnd, sectionEnd);
+
+					if(len == 1 && *pos == '*') any = q;
+					else if((len == 4 && !strncasecmp(pos, "gzip", 4)) || (len == 6 && !strncasecmp(pos, "x-gzip", 6))) listed[HTTP_COMPRESSION_GZIP] = q;
+					else if(len == 7 && !strncasecmp(pos, "deflate", 7)) listed[HTTP_COMPRESSION_DEFLATE] = q;
+					else if(len == 2 && !strncasecmp(pos, "br", 2)) listed[HTTP_COMPRESSION_BROTLI] = q;
+					else if(len == 4 && !strncasecmp(pos, "zstd", 4)) listed[HTTP_COMPRESSION_ZSTD] = q;
+					else if(len == 8 && !strncasecmp(pos, "identity", 8)) listed[HTTP_COMPRESSION_NONE] = q;
+
+					pos = sectionEnd + 1;
+				}
+
+				// "*" applies to all codings that are not listed (including the identity)
+				for(size_t i = 0; i < HTTP_COMPRESSION_COUNT; ++i)
+				{
+					if(listed[i] != NOT_LISTED) result[i] = listed[i];
+					else if(any != NOT_LISTED) result[i] = any;
+				}
+
+				return result;
+			}
+
+			HttpRequestUri::HttpRequestUri(String::PeoplezString uriString, HttpMethods const httpMethod, std::pmr::memory_resource * const arena) :
+					scheme(uriString.Substring(0,0)), authorityString(scheme), pathString(scheme), queryString(scheme), pathSegments(arena), queryParams(arena), rawQueryParams(arena)
 			{
 				if(httpMethod == HttpMethods::CONNECT)
 				{
@@ -176,8 +462,6 @@ namespace Peoplez
 					{
 						type = UriType::ORIGIN;
 						pathString = uriString;
-						// Split the path into its segments
-						uriString.Split<true>(pathSegments, '/');
 					}
 					else // Absolute-form
 					{
@@ -210,16 +494,10 @@ namespace Peoplez
 									uriString = uriString.Substring(posSlash + 1);
 								}
 
-								// Split path into its segments
-								pathString = uriString;
-								if(!uriString.IsEmpty()) uriString.Split<true>(pathSegments, '/');
 							}
 
 							// Remaining uriString is the path
-
 							pathString = uriString;
-							// Split the path into its segments
-							uriString.Split<true>(pathSegments, '/');
 						}
 						else
 						{
@@ -230,23 +508,17 @@ namespace Peoplez
 						}
 					}
 
-					// Unescape all path segments
-					for(size_t i = 0; i < pathSegments.size(); ++i)
+					// Check that the path segments can be unescaped
+					// (Splitting and unescaping is done on first access)
+					if(!pathString.IsUrlDecodable())
 					{
-						if(!pathSegments[i].DecodeUrl())
-						{
-							// If decoding fails
-							// reset all fields
-							type = UriType::UNDEFINED;
-							if(!scheme.IsEmpty()) scheme = uriString.Substring(0,0);
-							if(!authorityString.IsEmpty()) authorityString = scheme;
-							if(!pathString.IsEmpty()) pathString = scheme;
-							if(!queryString.IsEmpty()) queryString = scheme;
-							pathSegments.clear();
-
-							// Stop decoding
-							break;
-						}
+						// If decoding would fail
+						// reset all fields
+						type = UriType::UNDEFINED;
+						if(!scheme.IsEmpty()) scheme = uriString.Substring(0,0);
+						if(!authorityString.IsEmpty()) authorityString = scheme;
+						if(!pathString.IsEmpty()) pathString = scheme;
+						if(!queryString.IsEmpty()) queryString = scheme;
 					}
 				}
 			}
@@ -257,8 +529,126 @@ namespace Peoplez
 				scheme.Clear();
 				authorityString.Clear();
 				pathString.Clear();
-				pathSegments.clear();
+				Release(pathSegments);
 				queryString.Clear();
+				Release(queryParams);
+				Release(rawQueryParams);
+				pathSegmentsParsed = queryParamsParsed = rawQueryParamsParsed = false;
+			}
+
+			std::pmr::vector<PeoplezString> const & HttpRequestUri::PathSegments() const
+			{
+				if(!pathSegmentsParsed)
+				{
+					pathSegmentsParsed = true;
+
+					// Split the path into its segments
+					pathString.Split<true>(pathSegments, '/');
+
+					// Unescape all path segments (validity checked by constructor)
+					for(size_t i = 0; i < pathSegments.size(); ++i) pathSegments[i].DecodeUrl();
+				}
+
+				return pathSegments;
+			}
+
+			std::pmr::vector<NameValuePair> const & HttpRequestUri::QueryParams() const
+			{
+				if(!queryParamsParsed)
+				{
+					queryParamsParsed = true;
+
+					std::span<RawParam const> const raw = RawQueryParams();
+					queryParams.reserve(raw.size());
+
+					// Unescape names and values
+					for(RawParam const & param : raw) queryParams.emplace_back(Decode(param.first), Decode(param.second));
+				}
+
+				return queryParams;
+			}
+
+			std::span<HttpRequestUri::RawParam const> HttpRequestUri::RawQueryParams() const
+			{
+				if(!rawQueryParamsParsed)
+				{
+					rawQueryParamsParsed = true;
+
+					char const * pos = queryString.GetData();
+					char const * const end = pos + queryString.Length();
+
+					// For every "name=value" section ...
+					while(pos < end)
+					{
+						char const * sectionEnd = (char const *) memchr(pos, '&', end - pos);
+						if(!sectionEnd) sectionEnd = end;
+
+						// Empty sections are skipped (e.g. "a=1&&b=2")
+						if(sectionEnd > pos)
+						{
+							char const * const posEqual = (char const *) memchr(pos, '=', sectionEnd - pos);
+
+							if(posEqual) rawQueryParams.emplace_back(std::string_view(pos, posEqual - pos), std::string_view(posEqual + 1, sectionEnd - posEqual - 1));
+							else rawQueryParams.emplace_back(std::string_view(pos, sectionEnd - pos), std::string_view(sectionEnd, 0));
+						}
+
+						pos = sectionEnd + 1;
+					}
+				}
+
+				return rawQueryParams;
+			}
+
+			PeoplezString HttpRequestUri::QueryParam(std::string_view const name) const
+			{
+				size_t const index = FindQueryParam(name, 0);
+
+				return index != NO_QUERY_PARAM ? Decode(rawQueryParams[index].second) : PeoplezString();
+			}
+
+			std::pmr::vector<PeoplezString> HttpRequestUri::QueryParamValues(std::string_view const name) const
+			{
+				std::pmr::vector<PeoplezString> result(rawQueryParams.get_allocator());
+
+				for(size_t index = FindQueryParam(name, 0); index != NO_QUERY_PARAM; index = FindQueryParam(name, index + 1))
+				{
+					result.push_back(Decode(rawQueryParams[index].second));
+				}
+
+				return result;
+			}
+
+			size_t HttpRequestUri::FindQueryParam(std::string_view const name, size_t const start) const
+			{
+				std::span<RawParam const> const raw = RawQueryParams();
+
+				for(size_t i = start; i < raw.size(); ++i)
+				{
+					std::string_view const rawName = raw[i].first;
+
+					// Decoding never makes a name longer
+					if(rawName.size() < name.size()) continue;
+
+					if(rawName.find_first_of("%+") == std::string_view::npos)
+					{
+						if(rawName == name) return i;
+					}
+					// Escaped names are rare ... decode them for the comparison only
+					else if(Decode(rawName).View() == name) return i;
+				}
+
+				return NO_QUERY_PARAM;
+			}
+
+			PeoplezString HttpRequestUri::Decode(std::string_view const raw) const
+			{
+				// Shares the buffer of the query string unless there is something to decode
+				PeoplezString result = queryString.Substring(raw.data() - queryString.GetData(), raw.size());
+
+				// Invalid escape sequences are kept undecoded
+				result.DecodeUrl();
+
+				return result;
 			}
 		} // namespace Http
 	} // namespace Services
@@ -41,11 +41,17 @@
 #include "../../String/PeoplezString.hpp"
 #include "Enums.hpp"
 #include "HttpCookie.hpp"
+#include "HttpHeaderField.hpp"
 #include "PostParam.hpp"
 
 // Extern includes
+#include <array>
+#include <ctime>
 #include <list>
 #include <map>
+#include <memory_resource>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -67,10 +73,73 @@ namespace Peoplez
 			class HttpRequestUri final
 			{
 			public:
-				HttpRequestUri() : scheme(String::PeoplezString()), authorityString(scheme), pathString(scheme), queryString(scheme) {}
-				HttpRequestUri(String::PeoplezString uriString, HttpMethods httpMethod);
+				/**
+				 * @var typedef std::pair<std::string_view, std::string_view> RawParam
+				 * @brief Undecoded name and value of a query parameter (views into queryString)
+				 */
+				typedef std::pair<std::string_view, std::string_view> RawParam;
+
+				/**
+				 * Constructor
+				 *
+				 * @param arena Memory for the cached segments and parameters (e.g. the arena of the HttpContext)
+				 */
+				explicit HttpRequestUri(std::pmr::memory_resource * arena = std::pmr::get_default_resource()) : scheme(String::PeoplezString()), authorityString(scheme), pathString(scheme), queryString(scheme), pathSegments(arena), queryParams(arena), rawQueryParams(arena) {}
+				HttpRequestUri(String::PeoplezString uriString, HttpMethods httpMethod, std::pmr::memory_resource * arena = std::pmr::get_default_resource());
 
 				void Clean();
+				/**
+				 * Getter for the segments of the path (e.g. ["path", "to", "file.html"])
+				 *
+				 * The path is split and URL-decoded on first access only. The result is cached until Clean() is called.
+				 *
+				 * @return Segments of the path (already URL-decoded)
+				 */
+				std::pmr::vector<String::PeoplezString> const & PathSegments() const;
+				/**
+				 * Getter for the parameters of the query (e.g. [("name", "alice"), ("target", "bob")])
+				 *
+				 * The query is split and URL-decoded on first access only. The result is cached until Clean() is called.
+				 * Names and values with invalid escape sequences are kept undecoded.
+				 *
+				 * @return Name value pairs of the query (already URL-decoded)
+				 */
+				std::pmr::vector<String::NameValuePair> const & QueryParams() const;
+				/**
+				 * Getter for the undecoded parameters of the query (e.g. [("q", "a%20b"), ("page", "2")])
+				 *
+				 * The query is indexed in one pass on first access; nothing is copied or decoded.
+				 * The index is cached until Clean() is called. Empty parameters are skipped, repeated names are kept.
+				 *
+				 * @return Name value pairs of the query in their order (views into queryString)
+				 */
+				std::span<RawParam const> RawQueryParams() const;
+				/**
+				 * Checks whether the query contains a parameter
+				 *
+				 * @param name URL-decoded name of the parameter
+				 *
+				 * @return True if the parameter exists (possibly with an empty value)
+				 */
+				inline bool HasQueryParam(std::string_view const name) const {return FindQueryParam(name, 0) != NO_QUERY_PARAM;}
+				/**
+				 * Getter for a parameter of the query (see RawQueryParams())
+				 *
+				 * Only the found value is URL-decoded. It shares the buffer of queryString unless it contains escape sequences.
+				 *
+				 * @param name URL-decoded name of the parameter
+				 *
+				 * @return Value of the first parameter with the name (URL-decoded); empty if there is none
+				 */
+				String::PeoplezString QueryParam(std::string_view name) const;
+				/**
+				 * Getter for all values of a repeated parameter of the query (e.g. "tag=a&tag=b")
+				 *
+				 * @param name URL-decoded name of the parameter
+				 *
+				 * @return Values of all parameters with the name in their order (URL-decoded; in the memory of the URI)
+				 */
+				std::pmr::vector<String::PeoplezString> QueryParamValues(std::string_view name) const;
 
 				UriType type = UriType::UNDEFINED;
 				/**
@@ -85,15 +154,43 @@ namespace Peoplez
 				 * String of the full path (e.g. "/path/to/file.html")
 				 */
 				String::PeoplezString pathString;
-				/**
-				 * Segments of the path (e.g. ["path", "to", "file.html"])
-				 * The segments already URL-decoded
-				 */
-				std::vector<String::PeoplezString> pathSegments;
 				/**
 				 * String of the full query (e.g. "name=alice&target=bob")
 				 */
 				String::PeoplezString queryString;
+
+			private:
+				/**
+				 * Cache of PathSegments()
+				 */
+				mutable std::pmr::vector<String::PeoplezString> pathSegments;
+				/**
+				 * Cache of QueryParams()
+				 */
+				mutable std::pmr::vector<String::NameValuePair> queryParams;
+				/**
+				 * Cache of RawQueryParams()
+				 */
+				mutable std::pmr::vector<RawParam> rawQueryParams;
+				mutable bool pathSegmentsParsed = false;
+				mutable bool queryParamsParsed = false;
+				mutable bool rawQueryParamsParsed = false;
+
+				/**
+				 * Searches a parameter of the query by its URL-decoded name
+				 *
+				 * @param name URL-decoded name of the parameter
+				 * @param start Index in RawQueryParams() to start at
+				 *
+				 * @return Index in RawQueryParams(); NO_QUERY_PARAM if not found
+				 */
+				size_t FindQueryParam(std::string_view name, size_t start) const;
+				/**
+				 * Decodes a part of the query given as view into queryString
+				 */
+				String::PeoplezString Decode(std::string_view raw) const;
+
+				static constexpr size_t NO_QUERY_PARAM = (size_t) -1;
 			};
 
 			/**
@@ -102,6 +199,7 @@ namespace Peoplez
 			class HttpRequest final
 			{
 				friend class HttpContext;
+				friend class HttpRouter;
 			public:
 				/**
 				 * @var typedef std::unordered_map<String::PeoplezString, String::PeoplezString> StringMap
@@ -111,10 +209,14 @@ namespace Peoplez
 
 				/**
 				 * Standard constructor
+				 *
+				 * @param arena Memory for the parsed parts of the requests (e.g. the arena of the HttpContext)
 				 */
-				HttpRequest() : httpMethod(HttpMethods::UNKNOWN), contentType(MimeType::NONE), keepAlive(true), contentLength(-1), eTag(0) /*isSecureConnection(false), preferredLanguage((Language)-1)*/ {headers.reserve(10);};
+				explicit HttpRequest(std::pmr::memory_resource * arena = std::pmr::get_default_resource()) : httpMethod(HttpMethods::UNKNOWN), contentType(MimeType::NONE), keepAlive(true), connectionUpgrade(false), http11(true), contentLength(-1), transferCoding(TransferCoding::NONE), cookies(arena), cookiesParsed(false), eTag(0), headers(arena), postParams(arena), routeParams(arena), uri(arena) /*isSecureConnection(false), preferredLanguage((Language)-1)*/ {headers.reserve(10); headerPositions.fill(NO_HEADER_POSITION);};
 				/**
 				 * Resets everything to default
+				 *
+				 * Gives the memory of all containers back, so the arena can be reset afterwards.
 				 */
 				void Clean();
 
@@ -130,19 +232,72 @@ namespace Peoplez
 				 * Determines wheter a content length > 0 is set
 				 */
 				inline bool ContentLengthIsSet() const noexcept {return contentLength >= 0;}
+				/**
+				 * Determines whether the body is sent with chunked transfer coding
+				 *
+				 * @return True if the Transfer-Encoding header is "chunked"
+				 */
+				inline bool IsChunked() const noexcept {return transferCoding == TransferCoding::CHUNKED;}
+				/**
+				 * Determines whether the Connection header contains the option "upgrade" (e.g. for WebSocket handshakes)
+				 */
+				inline bool IsConnectionUpgrade() const noexcept {return connectionUpgrade;}
+				/**
+				 * Determines whether the client speaks HTTP/1.1 or later (false for HTTP/1.0 request-lines)
+				 */
+				inline bool IsHttp11() const noexcept {return http11;}
 				/**
 				 * Getter for the request cookies
 				 *
-				 * Entries are not unescaped
+				 * Entries are not unescaped.
+				 * The cookie header is parsed on first access only.
 				 *
 				 * @return List of all cookies in the request
 				 */
-				inline std::list<HttpCookie> Cookies() const {return cookies;}
+				inline std::list<HttpCookie> Cookies() const {if(!cookiesParsed) ParseCookies(); return std::list<HttpCookie>(cookies.begin(), cookies.end());}
+				/**
+				 * View of the request cookies (see Cookies())
+				 *
+				 * Does not copy the cookies. The view is valid until the request is cleaned (end of the request).
+				 *
+				 * @return Cookies in the order of the request
+				 */
+				inline std::span<HttpCookie const> CookiesView() const {if(!cookiesParsed) ParseCookies(); return cookies;}
+				/**
+				 * Searches a cookie of the request
+				 *
+				 * @param name Name of the cookie
+				 * @param ignoreCase Compare the names case insensitive (cookie names are case sensitive by RFC 6265)
+				 *
+				 * @return First cookie with the given name; nullptr if there is none. Valid until the request is cleaned.
+				 */
+				HttpCookie const * FindCookie(std::string_view name, bool ignoreCase = false) const;
 				/**
 				 * Getter for the ETag
 				 * Default: 0
 				 */
 				inline size_t ETag() const noexcept {return eTag;}
+				/**
+				 * Evaluates the conditional request header fields If-None-Match and If-Modified-Since (RFC 7232 Section 6)
+				 *
+				 * If-None-Match may contain several (weak) entity tags or "*" and is compared weakly.
+				 * If-Modified-Since is only evaluated if no If-None-Match is sent.
+				 *
+				 * @param eTag Entity tag of the current version of the resource (formatted as quoted hex number; 0 if none)
+				 * @param lastModified Modification time of the current version (0 if unknown)
+				 *
+				 * @return Indicates whether the version of the client is still valid (304 Not Modified)
+				 */
+				bool IsNotModified(size_t eTag, time_t lastModified) const noexcept;
+				/**
+				 * Evaluates the Accept-Encoding header field with its quality values (RFC 7231 Section 5.3.4)
+				 *
+				 * Without the header field only the identity (HTTP_COMPRESSION_NONE) is accepted.
+				 * The identity is accepted unless it is excluded explicitly or by "*;q=0". "x-gzip" is treated as "gzip".
+				 *
+				 * @return Quality value in thousandths per HttpCompression (0: not acceptable; 1000: preferred)
+				 */
+				std::array<uint16_t, HTTP_COMPRESSION_COUNT> AcceptedCompressions() const noexcept;
 				/**
 				 * Detects the language that fits best
 				 *
@@ -161,11 +316,49 @@ namespace Peoplez
 				/**
 				 * Getter for customized headers
 				 *
-				 * Getter for all header filds that are not handled in an other way
+				 * Getter for all header filds that are not handled in an other way.
+				 * Well known header fields are found in O(1) (case insensitive), all others by a linear search.
 				 *
 				 * @return Value of the header if exists; empty string otherwise
 				 */
-				String::PeoplezString GetHeaderValue(String::PeoplezString const & name);
+				String::PeoplezString GetHeaderValue(String::PeoplezString const & name) const;
+				/**
+				 * View of the value of a header field (see GetHeaderValue(String::PeoplezString const & name))
+				 *
+				 * The name is compared case insensitive. Does not copy the value.
+				 * The view is valid until the request is cleaned (end of the request).
+				 *
+				 * @param name Name of the header field
+				 *
+				 * @return Value of the header if exists; empty view otherwise
+				 */
+				std::string_view HeaderView(std::string_view name) const noexcept;
+				/**
+				 * View of the value of a well known header field (see GetHeaderValue(HttpHeaderField field))
+				 *
+				 * @param field The header field
+				 *
+				 * @return Value of the header if exists; empty view otherwise
+				 */
+				inline std::string_view HeaderView(HttpHeaderField const field) const noexcept {uint16_t const pos = headerPositions[(size_t)field]; return pos != NO_HEADER_POSITION ? headers[pos].second.View() : std::string_view();}
+				/**
+				 * Getter for well known headers
+				 *
+				 * Getter for well known header fields that are not handled in an other way (see GetHeaderValue(String::PeoplezString const & name))
+				 *
+				 * @param field The header field
+				 *
+				 * @return Value of the header if exists; empty string otherwise
+				 */
+				String::PeoplezString GetHeaderValue(HttpHeaderField field) const;
+				/**
+				 * Checks whether a well known header field was sent (and not handled in an other way)
+				 *
+				 * @param field The header field
+				 *
+				 * @return True if the header exists; False otherwise
+				 */
+				inline bool HasHeader(HttpHeaderField const field) const noexcept {return headerPositions[(size_t)field] != NO_HEADER_POSITION;}
 				/**
 				 * Getter for additional request header fields
 				 *
@@ -173,8 +366,22 @@ namespace Peoplez
 				 *
 				 * @return Hash map with the additional request header fields
 				 */
-				inline std::vector<std::pair<String::PeoplezString, String::PeoplezString> > Headers() const {return headers;}
+				inline std::vector<std::pair<String::PeoplezString, String::PeoplezString> > Headers() const {return std::vector<std::pair<String::PeoplezString, String::PeoplezString> >(headers.begin(), headers.end());}
+				/**
+				 * View of the request header fields (see Headers())
+				 *
+				 * Does not copy the fields. The view is valid until the request is cleaned (end of the request).
+				 *
+				 * @return Name value pairs in the order of the request
+				 */
+				inline std::span<std::pair<String::PeoplezString, String::PeoplezString> const> HeadersView() const noexcept {return headers;}
 				inline String::PeoplezString Host() const {return host;}
+				/**
+				 * View of the host (see Host())
+				 *
+				 * @return Host of the request; valid until the request is cleaned (end of the request)
+				 */
+				inline std::string_view HostView() const noexcept {return host.View();}
 				/**
 				 * Getter for the post parameters from the request
 				 *
@@ -182,7 +389,41 @@ namespace Peoplez
 				 *
 				 * @return Hash map with the post parameters from the request
 				 */
-				inline std::vector<PostParam> PostParams() const {return postParams;}
+				inline std::vector<PostParam> PostParams() const {return std::vector<PostParam>(postParams.begin(), postParams.end());}
+				/**
+				 * View of the post parameters (see PostParams())
+				 *
+				 * Does not copy the parameters. The view is valid until the request is cleaned (end of the request).
+				 *
+				 * @return Post parameters in the order of the request
+				 */
+				inline std::span<PostParam const> PostParamsView() const noexcept {return postParams;}
+				/**
+				 * Searches a post parameter of the request
+				 *
+				 * @param name Name of the parameter (NOT unescaped)
+				 * @param ignoreCase Compare the names case insensitive
+				 *
+				 * @return First parameter with the given name; nullptr if there is none. Valid until the request is cleaned.
+				 */
+				PostParam const * FindPostParam(std::string_view name, bool ignoreCase = false) const noexcept;
+				/**
+				 * Getter for the parameters of the matched route (e.g. [("id", "42")] for the route "/users/:id")
+				 *
+				 * Set by HttpRouter before it calls the handler. The names are copied into the arena of the request and are valid until the request is cleaned.
+				 * Catch-all parameters contain the matched segments joined by '/'.
+				 *
+				 * @return Name value pairs in path order (values already URL-decoded)
+				 */
+				inline std::pmr::vector<std::pair<std::string_view, String::PeoplezString> > const & RouteParams() const noexcept {return routeParams;}
+				/**
+				 * Getter for a parameter of the matched route (see RouteParams)
+				 *
+				 * @param name Name of the parameter (without ':' or '*')
+				 *
+				 * @return Value of the parameter; empty if the route has no such parameter
+				 */
+				String::PeoplezString RouteParam(std::string_view name) const;
 				/**
 				 * Getter for the request URI (second element in first line of HTTP request)
 				 *
@@ -220,19 +461,52 @@ namespace Peoplez
 				virtual ~HttpRequest() noexcept {}
 
 			private:
+				/**
+				 * @brief Transfer coding of the request body
+				 */
+				enum class TransferCoding : unsigned char
+				{
+					NONE,
+					CHUNKED,
+					UNSUPPORTED
+				};
+
+				/**
+				 * Splits the raw cookie header into the cookies list
+				 */
+				void ParseCookies() const;
+
 				HttpMethods httpMethod;
 				MimeType contentType;
 				bool keepAlive;
+				bool connectionUpgrade;
+				bool http11;
 				int64_t contentLength;
+				TransferCoding transferCoding;
 				String::PeoplezString boundary;
-				std::list<HttpCookie> cookies;
+				/**
+				 * @brief Raw value of the cookie header(s)
+				 */
+				String::PeoplezString cookieString;
+				mutable std::pmr::vector<HttpCookie> cookies;
+				mutable bool cookiesParsed;
 				size_t eTag;
-				std::vector<std::pair<String::PeoplezString, String::PeoplezString> > headers;
+				std::pmr::vector<std::pair<String::PeoplezString, String::PeoplezString> > headers;
+				/**
+				 * @brief Positions of the well known header fields in headers (NO_HEADER_POSITION if not sent)
+				 */
+				std::array<uint16_t, HTTP_HEADER_FIELD_COUNT> headerPositions;
 				String::PeoplezString host;
 				//bool isSecureConnection;
-				std::vector<PostParam> postParams;
+				std::pmr::vector<PostParam> postParams;
+				/**
+				 * @brief Parameters of the matched route (see RouteParams)
+				 */
+				std::pmr::vector<std::pair<std::string_view, String::PeoplezString> > routeParams;
 				String::PeoplezString userLanguages;
 				HttpRequestUri uri;
+
+				static constexpr uint16_t NO_HEADER_POSITION = 0xFFFF;
 			};
 		} // namespace Http
 	} // namespace Services
@@ -37,6 +37,7 @@
 #define PEOPLEZ_SERVICES_HTTP_HTTPREQUESTHANDLER_HPP_
 
 // Loacl includes
+#include "HttpBodyStreamHandler.hpp"
 #include "HttpContext.hpp"
 
 namespace Peoplez
@@ -48,7 +49,36 @@ namespace Peoplez
 			class HttpRequestHandler
 			{
 			public:
+				/**
+				 * Answers a request by setting the response of the context
+				 *
+				 * The response is sent when the method returns. Handlers that wait for other services call
+				 * HttpContext::Defer instead and complete the response later (from any thread) without blocking this one.
+				 *
+				 * @param context Context of the request
+				 */
 				virtual void ProcessRequest(HttpContext &context) = 0;
+				/**
+				 * Selects a handler that receives the body of the request while it arrives
+				 *
+				 * Called after the header was received for requests with a body.
+				 *
+				 * @param context Context of the request (headers are available)
+				 *
+				 * @return Handler for the body; nullptr to receive the complete body first and call ProcessRequest
+				 */
+				virtual HttpBodyStreamHandler * GetBodyStreamHandler(HttpContext &context) {return nullptr;}
+				/**
+				 * Decides on a request with body before the body is received (e.g. routing and authorization)
+				 *
+				 * Called after the header was received and before "100 Continue" is sent to clients that expect it.
+				 * A rejected body is not read; the connection is closed after the response.
+				 *
+				 * @param context Context of the request (headers are available)
+				 *
+				 * @return Indicates whether the body is accepted. To reject it set the final response (e.g. 401 or 413) and return false.
+				 */
+				virtual bool AcceptHeaders(HttpContext &context) {return true;}
 				virtual ~HttpRequestHandler() {}
 			};
 		} // namespace Http
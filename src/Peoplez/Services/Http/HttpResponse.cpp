@@ -39,9 +39,13 @@
 // Local includes
 #include "../../String/Parsing/IntToString.hpp"
 #include "../../System/Logging/Logger.hpp"
+#include "HttpFunctions.hpp"
+#include "HttpRequest.hpp"
 
 // Extern includes
+#include <cstring>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <cstdlib>
 extern "C"
@@ -50,6 +54,28 @@ extern "C"
 #include <unistd.h>
 }
 
+/**
+ * @def HTTP_RESPONSE_INLINE_BODY_SIZE
+ * @brief Maximum body size that is copied behind the header into the output buffer (larger bodies are sent from their own buffer)
+ */
+#ifndef HTTP_RESPONSE_INLINE_BODY_SIZE
+#define HTTP_RESPONSE_INLINE_BODY_SIZE 4096
+#endif
+
+/**
+ * @def HTTP_RESPONSE_CONST_TEXT
+ * @brief Case label returning a string literal with its length determined at compile time (see GetStatusLine)
+ */
+#define HTTP_RESPONSE_CONST_TEXT(code, text) case HttpStatusCode::code: return ConstStrLenContainer(text, sizeof(text) - 1)
+
+/**
+ * @def HTTP_MAX_RANGES
+ * @brief Maximum number of byte ranges in a Range header that are served (more ranges result in the complete body)
+ */
+#ifndef HTTP_MAX_RANGES
+#define HTTP_MAX_RANGES 16
+#endif
+
 namespace Peoplez
 {
 	// Local namespaces
@@ -67,6 +93,144 @@ namespace Peoplez
 			static char const * const HTTP_RESPONSE_CONTENT_TYPE_DEFAULT = "text/html; charset=UTF-8";
 			static size_t const HTTP_RESPONSE_CONTENT_TYPE_DEFAULT_LEN = 24;
 
+			/**
+			 * @brief Inclusive byte range of a body
+			 */
+			struct ByteRange
+			{
+				uint64_t first;
+				uint64_t last;
+			};
+
+			/**
+			 * Parses a decimal number of a Range header
+			 *
+			 * @param str Header value
+			 * @param pos Position of the first digit; behind the number afterwards
+			 * @param dest Target for the number
+			 *
+			 * @return Indicates whether a number (of at most 18 digits) was found
+			 */
+			static bool ParseRangeNumber(PeoplezString const & str, size_t & pos, uint64_t & dest) noexcept
+			{
+				size_t const begin = pos;
+
+				dest = 0;
+
+				for(; pos < str.Length() && str[pos] >= '0' && str[pos] <= '9'; ++pos)
+				{
+					if(pos - begin >= 18) return false;
+					dest = dest * 10 + (str[pos] - '0');
+				}
+
+				return pos > begin;
+			}
+
+			/**
+			 * Parses the byte ranges of a Range header (RFC 7233 Section 2.1)
+			 *
+			 * @param header Value of the Range header
+			 * @param length Length of the complete body
+			 * @param dest Target for the satisfiable ranges (HTTP_MAX_RANGES entries)
+			 * @param count Number of satisfiable ranges
+			 *
+			 * @return Indicates whether the header is valid and can be served (not too many ranges, not more bytes than the body)
+			 */
+			static bool ParseRanges(PeoplezString const & header, uint64_t const length, ByteRange * const dest, size_t & count) noexcept
+			{
+				size_t pos = 6;
+				size_t specs = 0;
+				uint64_t total = 0;
+
+				count = 0;
+
+				if(!header.BeginsWith("bytes=", 6)) return false;
+
+				for(;;)
+				{
+					while(pos < header.Length() && (header[pos] == ' ' || header[pos] == '\t')) ++pos;
+
+					// Empty list elements are allowed
+					if(pos < header.Length() && header[pos] != ',')
+					{
+						uint64_t first;
+						uint64_t last = length - 1;
+						bool satisfiable;
+
+						if(++specs > HTTP_MAX_RANGES) return false;
+
+						if(header[pos] == '-') // Suffix: last n bytes
+						{
+							uint64_t suffix;
+
+							++pos;
+							if(!ParseRangeNumber(header, pos, suffix)) return false;
+
+							first = suffix < length ? length - suffix : 0;
+							satisfiable = suffix && length;
+						}
+						else
+						{
+							if(!ParseRangeNumber(header, pos, first) || pos >= header.Length() || header[pos] != '-') return false;
+
+							++pos;
+
+							uint64_t requestedLast;
+
+							if(ParseRangeNumber(header, pos, requestedLast))
+							{
+								if(requestedLast < first) return false;
+								if(requestedLast < last) last = requestedLast;
+							}
+
+							satisfiable = first < length;
+						}
+
+						if(satisfiable)
+						{
+							dest[count].first = first;
+							dest[count].last = last;
+							++count;
+
+							// Overlapping ranges must not multiply the body
+							total += last - first + 1;
+							if(total > length) return false;
+						}
+
+						while(pos < header.Length() && (header[pos] == ' ' || header[pos] == '\t')) ++pos;
+					}
+
+					if(pos >= header.Length()) break;
+					else if(header[pos] != ',') return false;
+
+					++pos;
+				}
+
+				return specs > 0;
+			}
+
+			/**
+			 * Formats the value of a Content-Range header
+			 *
+			 * @param range Range of the part
+			 * @param length Length of the complete body
+			 *
+			 * @return "bytes first-last/length"
+			 */
+			static PeoplezString CreateContentRange(ByteRange const & range, uint64_t const length)
+			{
+				PeoplezString result(70);
+
+				result.Append("bytes ", 6);
+				result.Append(PeoplezString::ParseDec(range.first));
+				result.Append("-", 1);
+				result.Append(PeoplezString::ParseDec(range.last));
+				result.Append("/", 1);
+				result.Append(PeoplezString::ParseDec(length));
+
+				return result;
+			}
+
 			bool isValidStatusCode(HttpStatusCode const statusCode)
 			{
 				switch(statusCode)
@@ -138,19 +302,26 @@ namespace Peoplez
 				}
 			}
 
-			HttpResponse::HttpResponse() : KeepAlive(true), compression(HTTP_COMPRESSION_NONE), contentType(HTTP_RESPONSE_CONTENT_TYPE_DEFAULT, HTTP_RESPONSE_CONTENT_TYPE_DEFAULT_LEN), dataSet(false), eTag(0), statusCode(HttpStatusCode::OK)
+			HttpResponse::HttpResponse() : KeepAlive(true), acceptRanges(false), canned(nullptr, 0), compression(HTTP_COMPRESSION_NONE), contentRange(), contentType(HTTP_RESPONSE_CONTENT_TYPE_DEFAULT, HTTP_RESPONSE_CONTENT_TYPE_DEFAULT_LEN), dataSet(false), eTag(0), lastModified(0), prebuilt(), statusCode(HttpStatusCode::OK), varyEncoding(false)
 			{
 			}
 
 			void HttpResponse::Clean()
 			{
 				Cookies.clear();
-				Headers.clear();
+				Headers.Clear();
 				data.Clear();
 				contentType.SetTo(HTTP_RESPONSE_CONTENT_TYPE_DEFAULT, HTTP_RESPONSE_CONTENT_TYPE_DEFAULT_LEN);
+				contentRange.Clear();
+				acceptRanges = false;
+				lastModified = 0;
+				canned = ConstStrLenContainer(nullptr, 0);
+				prebuilt.reset();
 				redirectLocation.Clear();
 				statusCode = HttpStatusCode::OK;
 				dataSet = false;
+				stream.reset();
+				varyEncoding = false;
 			}
 
 			size_t HttpResponse::GetCookiesSize() const
@@ -165,95 +336,229 @@ namespace Peoplez
 				return res;
 			}
 
-			size_t HttpResponse::GetHeadersSize() const
+			/**
+			 * @brief Per thread block with the Date and connection header fields (formatted once per second)
+			 */
+			struct ConnectionHeadersCache
+			{
+				time_t second = -1;
+				/**
+				 * @brief "\r\nDate: <date>\r\nConnection: Keep-Alive\r\nKeep-Alive: timeout=5\r\n"
+				 */
+				char keepAlive[HttpResponse::CONNECTION_HEADERS_KEEP_ALIVE_LENGTH];
+				/**
+				 * @brief "\r\nDate: <date>\r\nConnection: close\r\n"
+				 */
+				char close[HttpResponse::CONNECTION_HEADERS_CLOSE_LENGTH];
+			};
+
+			static thread_local ConnectionHeadersCache connectionHeaders;
+
+			HttpResponse::ConstStrLenContainer HttpResponse::GetConnectionHeaders(bool const keepAlive) noexcept
 			{
-				if(Headers.empty()) return 0;
+				time_t const now = time(nullptr);
 
-				size_t res = 0;
-				unordered_map<PeoplezString, PeoplezString>::const_iterator iter = Headers.begin();
+				if(now != connectionHeaders.second)
+				{
+					connectionHeaders.second = now;
 
-				while(iter != Headers.end()) res += 3 + iter->first.Length() + iter->second.Length();
+					memcpy(connectionHeaders.keepAlive, "\r\nDate: ", 8);
+					HttpFunctions::FormatHttpDate(now, connectionHeaders.keepAlive + 8);
+					memcpy(connectionHeaders.keepAlive + 8 + HttpFunctions::HTTP_DATE_LENGTH, "\r\nConnection: Keep-Alive\r\nKeep-Alive: timeout=5\r\n", 49);
 
-				return res;
+					memcpy(connectionHeaders.close, connectionHeaders.keepAlive, 8 + HttpFunctions::HTTP_DATE_LENGTH);
+					memcpy(connectionHeaders.close + 8 + HttpFunctions::HTTP_DATE_LENGTH, "\r\nConnection: close\r\n", 21);
+				}
+
+				return keepAlive ? ConstStrLenContainer(connectionHeaders.keepAlive, CONNECTION_HEADERS_KEEP_ALIVE_LENGTH) : ConstStrLenContainer(connectionHeaders.close, CONNECTION_HEADERS_CLOSE_LENGTH);
+			}
+
+			/**
+			 * Writes a number as upper case hex digits without leading zeros (as PeoplezString::ParseHex)
+			 *
+			 * @param dest Target (at least 16 bytes)
+			 * @param value Number to write
+			 *
+			 * @return Number of written digits
+			 */
+			static size_t ToCStringHex(char * const dest, uint64_t value) noexcept
+			{
+				static char const DIGITS[] = "0123456789ABCDEF";
+				char buffer[16];
+				char * pos = buffer + 16;
+
+				do *(--pos) = DIGITS[value & 0xf]; while(value >>= 4);
+
+				size_t const len = buffer + 16 - pos;
+				memcpy(dest, pos, len);
+
+				return len;
 			}
 
 			PeoplezString HttpResponse::GetResponseText()
 			{
+				PeoplezString result;
+				SerializeTo(result, true);
+
+				return result;
+			}
+
+			bool HttpResponse::HasSeparateBody() const noexcept
+			{
+				return !prebuilt && data.Length() > HTTP_RESPONSE_INLINE_BODY_SIZE;
+			}
+
+			void HttpResponse::SerializeTo(PeoplezString & dest, bool const includeBody, bool const headOnly)
+			{
+				ConstStrLenContainer const connection = GetConnectionHeaders(KeepAlive);
+
+				dest.Clear();
+
+				// Pre-serialized response is only valid if nothing was added
+				if(prebuilt && KeepAlive && Cookies.empty() && Headers.empty())
+				{
+					dest.ToUnique(prebuilt->Length() + connection.second + 2);
+					dest.Append(prebuilt->GetData(), prebuilt->Length());
+					dest.Append(connection.first, connection.second);
+					dest.Append("\r\n", 2);
+
+					return;
+				}
+
+				// Same for the canned error responses (see SetError)
+				if(canned.second && Cookies.empty() && Headers.empty())
+				{
+					dest.ToUnique(canned.second + connection.second + 2);
+					dest.Append(canned.first, canned.second);
+					dest.Append(connection.first, connection.second);
+					dest.Append("\r\n", 2);
+
+					return;
+				}
+
 				bool const isRedict = IsRedict();
+				bool const withBody = !headOnly && (includeBody || data.Length() <= HTTP_RESPONSE_INLINE_BODY_SIZE);
 				char _binaryDataLength[21];
 				int dataLengthSize = 0;
+				char _eTag[16];
+				size_t eTagSize = 0;
 				//Größe berechnen
-				size_t size = 0;
+				size_t size = 2;
 
-				char _statusCode[5];
-				const int statusCodeSize = 1 + ToCStringBase10(_statusCode, (unsigned int)statusCode);
-				_statusCode[statusCodeSize - 1] = ' ';
-				size += statusCodeSize;
+				ConstStrLenContainer const status = GetStatusLine(statusCode);
+				size += status.second;
 
-				//if(isRedict) size += 12 + redirectLocation.Length();
-				//else if(eTag != 0) size += 10 + (sizeof(eTag) << 1);
-				size += isRedict ? (12 + redirectLocation.Length()) : (eTag != 0 ? (10 + (sizeof(eTag) << 1)) : 0);
+				// Unknown status code ... without reason phrase
+				char _statusCode[21];
+				int statusCodeSize = 0;
+				if(!status.second)
+				{
+					Logger::LogException("No description for this status code available", __FILE__, __LINE__);
+					statusCodeSize = ToCStringBase10(_statusCode, (unsigned int)statusCode);
+					_statusCode[statusCodeSize++] = ' ';
+					size += 9 + statusCodeSize;
+				}
+
+				if(isRedict) size += 12 + redirectLocation.Length();
+				else if(eTag != 0)
+				{
+					eTagSize = ToCStringHex(_eTag, eTag);
+					size += 10 + eTagSize;
+				}
+				size += lastModified ? 17 + HttpFunctions::HTTP_DATE_LENGTH : 0;
 
 				if(statusCode != HttpStatusCode::NOT_MODIFIED)
 				{
-					size += 34 + contentType.Length();
+					size += 16 + contentType.Length();
 
-					dataLengthSize = ToCStringBase10(_binaryDataLength, data.Length());
-					size += dataLengthSize;
+					if(stream) size += 28;
+					else
+					{
+						dataLengthSize = ToCStringBase10(_binaryDataLength, data.Length());
+						size += 18 + dataLengthSize;
+					}
 
 					if(compression == HTTP_COMPRESSION_DEFLATE) size += 27;
 					else if(compression == HTTP_COMPRESSION_GZIP) size += 24;
+					else if(compression == HTTP_COMPRESSION_BROTLI) size += 22;
+					else if(compression == HTTP_COMPRESSION_ZSTD) size += 24;
+
+					if(!contentRange.IsEmpty()) size += 17 + contentRange.Length();
 				}
 
-				//if(KeepAlive) size += 28;
-				size += KeepAlive ? 28 : 0;
+				size += acceptRanges ? 22 : 0;
+				size += varyEncoding ? 23 : 0;
 
-				ConstStrLenContainer status = GetStatusDescription();
-				size += status.second;
+				size += connection.second;
 
 				size_t const cookiesSize = GetCookiesSize();
-				size_t const headersSize = GetHeadersSize();
+				size_t const headersSize = Headers.SerializedLength();
 				size += cookiesSize + headersSize;
 
-				size += data.Length();
+				size += withBody ? data.Length() : 0;
 
 				//Teile zusammenfügen
 
-				PeoplezString result(size + 32);
+				// Exact size: a reused unique buffer with enough capacity is not reallocated
+				dest.ToUnique(size);
 
-				result.Append("HTTP/1.1 ", 9); // 9
-				result.Append(_statusCode, statusCodeSize); //statusCodeSize
-				if(status.second) result.Append(status.first, status.second); //status.Length()
+				if(status.second) dest.Append(status.first, status.second); // status.second
+				else
+				{
+					dest.Append("HTTP/1.1 ", 9); // 9
+					dest.Append(_statusCode, statusCodeSize); // statusCodeSize
+				}
 				if(isRedict)
 				{
-					result.Append("\r\nLocation: ", 12); // 12
-					result.Append(redirectLocation); // redirectLocation.Length()
+					dest.Append("\r\nLocation: ", 12); // 12
+					dest.Append(redirectLocation); // redirectLocation.Length()
 				}
 				else if(eTag != 0)
 				{
-					result.Append("\r\nEtag: \"", 9); // 9
-					result.Append(PeoplezString::ParseHex(eTag)); // sizeof(eTag) << 1
-					result.Append("\"", 1); // 1
+					dest.Append("\r\nEtag: \"", 9); // 9
+					dest.Append(_eTag, eTagSize); // eTagSize
+					dest.Append("\"", 1); // 1
+				}
+				if(lastModified)
+				{
+					char date[HttpFunctions::HTTP_DATE_LENGTH];
+					HttpFunctions::FormatHttpDate(lastModified, date);
+
+					dest.Append("\r\nLast-Modified: ", 17); // 17
+					dest.Append(date, HttpFunctions::HTTP_DATE_LENGTH); // HTTP_DATE_LENGTH
 				}
 
 				if(statusCode != HttpStatusCode::NOT_MODIFIED)
 				{
-					result.Append("\r\nContent-Type: ", 16); // 16
-					result.Append(contentType); // contentType.Length()
-					if(compression == HTTP_COMPRESSION_GZIP) result.Append("\r\nContent-Encoding: gzip", 24); // 24
-					else if(compression == HTTP_COMPRESSION_DEFLATE) result.Append("\r\nContent-Encoding: deflate", 27); // 27
-					result.Append("\r\nContent-Length: ", 18); // 18
-					result.Append(_binaryDataLength, dataLengthSize); // dataLengthSize
+					dest.Append("\r\nContent-Type: ", 16); // 16
+					dest.Append(contentType); // contentType.Length()
+					if(compression == HTTP_COMPRESSION_GZIP) dest.Append("\r\nContent-Encoding: gzip", 24); // 24
+					else if(compression == HTTP_COMPRESSION_DEFLATE) dest.Append("\r\nContent-Encoding: deflate", 27); // 27
+					else if(compression == HTTP_COMPRESSION_BROTLI) dest.Append("\r\nContent-Encoding: br", 22); // 22
+					else if(compression == HTTP_COMPRESSION_ZSTD) dest.Append("\r\nContent-Encoding: zstd", 24); // 24
+					if(stream) dest.Append("\r\nTransfer-Encoding: chunked", 28); // 28
+					else
+					{
+						dest.Append("\r\nContent-Length: ", 18); // 18
+						dest.Append(_binaryDataLength, dataLengthSize); // dataLengthSize
+					}
+					if(!contentRange.IsEmpty())
+					{
+						dest.Append("\r\nContent-Range: ", 17); // 17
+						dest.Append(contentRange); // contentRange.Length()
+					}
 				}
-				result.Append("\r\nConnection: ", 14); // 14
-				if(KeepAlive) result.Append("Keep-Alive\r\nKeep-Alive: timeout=5\r\n", 35); // 35
-				else result.Append("close\r\n", 7); // 7
-				if(cookiesSize > 0) result.Append(CreateCookies()); // _cookies.Length()
-				if(headersSize > 0) result.Append(CreateHeaders()); // _headers.Length()
-				result.Append("\r\n", 2); // 2
-				result.Append(data); // data.Length()
-
-				return result;
+				if(acceptRanges) dest.Append("\r\nAccept-Ranges: bytes", 22); // 22
+				if(varyEncoding) dest.Append("\r\nVary: Accept-Encoding", 23); // 23
+				dest.Append(connection.first, connection.second); // connection.second
+				for(std::list<HttpCookie>::const_iterator iter = Cookies.begin(); iter != Cookies.end(); ++iter)
+				{
+					dest.Append(iter->ToString()); // o_ToStringSize()
+					dest.Append("\r\n", 2); // 2
+				}
+				Headers.AppendTo(dest); // headersSize
+				dest.Append("\r\n", 2); // 2
+				if(withBody) dest.Append(data); // data.Length()
 			}
 
 			void HttpResponse::SetWithBody(HttpStatusCode const code, char const * const body, int const bodyLen, HttpCompression const compr)
@@ -292,6 +597,128 @@ namespace Peoplez
 				}
 			}
 
+			void HttpResponse::SetRange(HttpRequest const & request)
+			{
+				// Only complete bodies can be split
+				if(statusCode != HttpStatusCode::OK || stream) return;
+
+				acceptRanges = true;
+
+				PeoplezString const range = request.GetHeaderValue(HttpHeaderField::RANGE);
+
+				if(range.IsEmpty()) return;
+
+				// If the client has another version ... send the complete body (dates are not validated)
+				{
+					PeoplezString const ifRange = request.GetHeaderValue(HttpHeaderField::IF_RANGE);
+
+					if(!ifRange.IsEmpty())
+					{
+						PeoplezString const hex = PeoplezString::ParseHex(eTag);
+
+						if(eTag == 0 || ifRange.Length() != hex.Length() + 2 || ifRange[0] != '"' || ifRange[hex.Length() + 1] != '"' || !ifRange.EqualTo(1, hex.GetData(), hex.Length())) return;
+					}
+				}
+
+				uint64_t const length = data.Length();
+				ByteRange ranges[HTTP_MAX_RANGES];
+				size_t count;
+
+				if(!ParseRanges(range, length, ranges, count)) return;
+
+				// If no range is satisfiable ...
+				// Else if there is a single range ... send a view of the body
+				// Else send the parts as multipart/byteranges
+				if(!count)
+				{
+					SetStatusCode(HttpStatusCode::RANGE_NOT_SATISFIABLE);
+					data.Clear();
+
+					contentRange = PeoplezString(30);
+					contentRange.Append("bytes */", 8);
+					contentRange.Append(PeoplezString::ParseDec(length));
+				}
+				else if(count == 1)
+				{
+					statusCode = HttpStatusCode::PARTIAL_CONTENT;
+					contentRange = CreateContentRange(ranges[0], length);
+
+					if(ranges[0].last - ranges[0].first + 1 < length) data = data.Substring(ranges[0].first, ranges[0].last - ranges[0].first + 1);
+				}
+				else
+				{
+					thread_local std::mt19937_64 random(std::random_device{}());
+
+					PeoplezString const boundary = PeoplezString::ParseHex(random());
+					size_t size = 8 + boundary.Length();
+
+					for(size_t i = 0; i < count; ++i) size += 120 + boundary.Length() + contentType.Length() + (ranges[i].last - ranges[i].first + 1);
+
+					PeoplezString body(size);
+
+					for(size_t i = 0; i < count; ++i)
+					{
+						body.Append("\r\n--", 4);
+						body.Append(boundary);
+						body.Append("\r\nContent-Type: ", 16);
+						body.Append(contentType);
+						body.Append("\r\nContent-Range: ", 17);
+						body.Append(CreateContentRange(ranges[i], length));
+						body.Append("\r\n\r\n", 4);
+						body.Append(data.GetData() + ranges[i].first, ranges[i].last - ranges[i].first + 1);
+					}
+
+					body.Append("\r\n--", 4);
+					body.Append(boundary);
+					body.Append("--\r\n", 4);
+
+					statusCode = HttpStatusCode::PARTIAL_CONTENT;
+					data = body;
+					contentType = PeoplezString(31 + boundary.Length());
+					contentType.Append("multipart/byteranges; boundary=", 31);
+					contentType.Append(boundary);
+				}
+			}
+
+			void HttpResponse::SetNotModified(size_t const _eTag, time_t const _lastModified, std::shared_ptr<PeoplezString const> const _prebuilt)
+			{
+				if(SetStatusCode(HttpStatusCode::NOT_MODIFIED))
+				{
+					ResetBodyAndLocation();
+
+					compression = HTTP_COMPRESSION_NONE;
+					data.Clear();
+					eTag = _eTag;
+					lastModified = _lastModified;
+					prebuilt = _prebuilt;
+				}
+			}
+
+			PeoplezString HttpResponse::CreateNotModified(size_t const _eTag, time_t const _lastModified, bool const _varyEncoding)
+			{
+				HttpResponse response;
+				response.SetNotModified(_eTag, _lastModified);
+				response.SetVaryEncoding(_varyEncoding);
+
+				// Without the connection headers (and the Date) that are added on sending
+				PeoplezString const text = response.GetResponseText();
+
+				return PeoplezString(text.GetData(), text.Length() - CONNECTION_HEADERS_KEEP_ALIVE_LENGTH - 2);
+			}
+
+			void HttpResponse::SetStream(HttpStatusCode const code, PeoplezString const _contentType, std::shared_ptr<HttpResponseStream> const _stream)
+			{
+				if(SetStatusCode(code))
+				{
+					ResetBodyAndLocation();
+
+					compression = HTTP_COMPRESSION_NONE;
+					contentType = _contentType;
+					data.Clear();
+					stream = _stream;
+				}
+			}
+
 			void HttpResponse::SetRedict(HttpStatusCode const code, PeoplezString const location)
 			{
 				if(SetStatusCode(code))
@@ -307,158 +734,99 @@ namespace Peoplez
 				SetStatusCode(code);
 			}
 
-			PeoplezString HttpResponse::CreateHeaders() const
+			void HttpResponse::SetError(HttpStatusCode const code)
 			{
-				PeoplezString result;
-				unordered_map<PeoplezString, PeoplezString>::const_iterator iter = Headers.begin();
-
-				while(iter != Headers.end()) result.Append(iter->first + ":" + iter->second + "\r\n");
+				SetOther(code);
+				KeepAlive = false;
 
-				return result;
+				// Sent as it is unless cookies or header fields are added
+				canned = GetCannedError(statusCode);
 			}
 
-			PeoplezString HttpResponse::CreateCookies() const
+			constexpr HttpResponse::ConstStrLenContainer HttpResponse::GetStatusLine(HttpStatusCode const code) noexcept
 			{
-				PeoplezString result;
-
-				for(std::list<HttpCookie>::const_iterator iter = Cookies.begin(); iter != Cookies.end(); ++iter)
+				switch(code)
 				{
-					result.Append(iter->ToString());
-					result.Append("\r\n");
+				HTTP_RESPONSE_CONST_TEXT(CONTINUE, "HTTP/1.1 100 Continue");
+				HTTP_RESPONSE_CONST_TEXT(SWITCHING_PROTOCOL, "HTTP/1.1 101 Switching Protocols");
+				HTTP_RESPONSE_CONST_TEXT(PROCESSING, "HTTP/1.1 102 Processing");
+				HTTP_RESPONSE_CONST_TEXT(EARLY_HITS, "HTTP/1.1 103 Early Hits");
+				HTTP_RESPONSE_CONST_TEXT(OK, "HTTP/1.1 200 OK");
+				HTTP_RESPONSE_CONST_TEXT(CREATED, "HTTP/1.1 201 Created");
+				HTTP_RESPONSE_CONST_TEXT(ACCEPTED, "HTTP/1.1 202 Accepted");
+				HTTP_RESPONSE_CONST_TEXT(NON_AUTH_INFO, "HTTP/1.1 203 Non-Authoritative Information");
+				HTTP_RESPONSE_CONST_TEXT(NO_CONTENT, "HTTP/1.1 204 No Content");
+				HTTP_RESPONSE_CONST_TEXT(RESET_CONTENT, "HTTP/1.1 205 Reset Content");
+				HTTP_RESPONSE_CONST_TEXT(PARTIAL_CONTENT, "HTTP/1.1 206 Partial Content");
+				HTTP_RESPONSE_CONST_TEXT(MULTI_STATUS, "HTTP/1.1 207 Multi-Status");
+				HTTP_RESPONSE_CONST_TEXT(ALREADY_REPORTED, "HTTP/1.1 208 Already Reported");
+				HTTP_RESPONSE_CONST_TEXT(IM_USED, "HTTP/1.1 226 IM Used");
+				HTTP_RESPONSE_CONST_TEXT(MULTIPLE_CHOICES, "HTTP/1.1 300 Multiple Choices");
+				HTTP_RESPONSE_CONST_TEXT(MOVED_PERMANENTLY, "HTTP/1.1 301 Moved Permanently");
+				HTTP_RESPONSE_CONST_TEXT(FOUND, "HTTP/1.1 302 Found");
+				HTTP_RESPONSE_CONST_TEXT(SEE_OTHER, "HTTP/1.1 303 See Other");
+				HTTP_RESPONSE_CONST_TEXT(NOT_MODIFIED, "HTTP/1.1 304 Not Modified");
+				HTTP_RESPONSE_CONST_TEXT(USE_PROXY, "HTTP/1.1 305 Use Proxy");
+				HTTP_RESPONSE_CONST_TEXT(SWITCH_PROXY, "HTTP/1.1 306 Switch Proxy");
+				HTTP_RESPONSE_CONST_TEXT(TEMPORARY_REDICT, "HTTP/1.1 307 Temporary Redict");
+				HTTP_RESPONSE_CONST_TEXT(PERMANENT_REDIRECT, "HTTP/1.1 308 Permanent Redirect");
+				HTTP_RESPONSE_CONST_TEXT(BAD_REQUEST, "HTTP/1.1 400 Bad Request");
+				HTTP_RESPONSE_CONST_TEXT(UNAUTHORIZED, "HTTP/1.1 401 Unauthorized");
+				HTTP_RESPONSE_CONST_TEXT(PAYMENT_REQUIRED, "HTTP/1.1 402 Payment Required");
+				HTTP_RESPONSE_CONST_TEXT(FORBIDDEN, "HTTP/1.1 403 Forbidden");
+				HTTP_RESPONSE_CONST_TEXT(NOT_FOUND, "HTTP/1.1 404 Not Found");
+				HTTP_RESPONSE_CONST_TEXT(METHOD_NOT_ALLOWED, "HTTP/1.1 405 Method Not Allowed");
+				HTTP_RESPONSE_CONST_TEXT(NOT_ACCEPTABLE, "HTTP/1.1 406 Not Acceptable");
+				HTTP_RESPONSE_CONST_TEXT(PROXY_AUTH_REQUIRED, "HTTP/1.1 407 Proxy Authentication Required");
+				HTTP_RESPONSE_CONST_TEXT(REQUEST_TIMEOUT, "HTTP/1.1 408 Request Time-out");
+				HTTP_RESPONSE_CONST_TEXT(CONFLICT, "HTTP/1.1 409 Conflict");
+				HTTP_RESPONSE_CONST_TEXT(GONE, "HTTP/1.1 410 Gone");
+				HTTP_RESPONSE_CONST_TEXT(LENGTH_REQUIRED, "HTTP/1.1 411 Length Required");
+				HTTP_RESPONSE_CONST_TEXT(PAYLOAD_TOO_LARGE, "HTTP/1.1 413 Payload Too Large");
+				HTTP_RESPONSE_CONST_TEXT(URI_TOO_LONG, "HTTP/1.1 414 URI Too Long");
+				HTTP_RESPONSE_CONST_TEXT(UNSUPPORTED_MEDIA_TYPE, "HTTP/1.1 415 Unsupported Media Type");
+				HTTP_RESPONSE_CONST_TEXT(RANGE_NOT_SATISFIABLE, "HTTP/1.1 416 Range Not Satisfiable");
+				HTTP_RESPONSE_CONST_TEXT(EXPECTATION_FAILED, "HTTP/1.1 417 Expectation Failed");
+				HTTP_RESPONSE_CONST_TEXT(IM_A_TEAPOT, "HTTP/1.1 418 I'm a teapot");
+				HTTP_RESPONSE_CONST_TEXT(MISDIRECTED_REQUEST, "HTTP/1.1 421 Misdirected Request");
+				HTTP_RESPONSE_CONST_TEXT(UNPROCESSABLE_ENTITY, "HTTP/1.1 422 Unprocessable Entity");
+				HTTP_RESPONSE_CONST_TEXT(LOCKED, "HTTP/1.1 423 Locked");
+				HTTP_RESPONSE_CONST_TEXT(FAILED_DEPENDENCY, "HTTP/1.1 424 Failed Dependency");
+				HTTP_RESPONSE_CONST_TEXT(UPGRADE_REQUIRED, "HTTP/1.1 426 Upgrade Required");
+				HTTP_RESPONSE_CONST_TEXT(PRECONDITION_REQUIRED, "HTTP/1.1 428 Precondition Required");
+				HTTP_RESPONSE_CONST_TEXT(TOO_MANY_REQUESTS, "HTTP/1.1 429 Too Many Requests");
+				HTTP_RESPONSE_CONST_TEXT(REQUEST_HEADER_FIELDS_TOO_LARGE, "HTTP/1.1 431 Request Header Fields Too Large");
+				HTTP_RESPONSE_CONST_TEXT(UNAVAILABLE_FOR_LEGAL_REASONS, "HTTP/1.1 451 Unavailable For Legal Reasons");
+				HTTP_RESPONSE_CONST_TEXT(INTERNAL_SERVER_ERROR, "HTTP/1.1 500 Internal Server Error");
+				HTTP_RESPONSE_CONST_TEXT(NOT_IMPLEMENTED, "HTTP/1.1 501 Not Implemented");
+				HTTP_RESPONSE_CONST_TEXT(BAD_GATEWAY, "HTTP/1.1 502 Bad Gateway");
+				HTTP_RESPONSE_CONST_TEXT(SERVICE_UNAVAILABLE, "HTTP/1.1 503 Service Unavailable");
+				HTTP_RESPONSE_CONST_TEXT(GATEWAY_TIMEOUT, "HTTP/1.1 504 Gateway Timeout");
+				HTTP_RESPONSE_CONST_TEXT(HTTP_VERSION_NOT_SUPPORTED, "HTTP/1.1 505 HTTP Version not supported");
+				HTTP_RESPONSE_CONST_TEXT(VARIANT_ALSO_NEGOTIATES, "HTTP/1.1 506 Variant Also Negotiates");
+				HTTP_RESPONSE_CONST_TEXT(INSUFFICIENT_STORAGE, "HTTP/1.1 507 Insufficient Storage");
+				HTTP_RESPONSE_CONST_TEXT(LOOP_DETECTED, "HTTP/1.1 508 Loop Detected");
+				HTTP_RESPONSE_CONST_TEXT(NOT_EXTENDED, "HTTP/1.1 510 Not Extended");
+				HTTP_RESPONSE_CONST_TEXT(NETWORK_AUTH_REQUIRED, "HTTP/1.1 511 Network Authentication Required");
+				default:
+					return ConstStrLenContainer(nullptr, 0);
 				}
-
-				return result;
 			}
 
-			HttpResponse::ConstStrLenContainer HttpResponse::GetStatusDescription() const
+			constexpr HttpResponse::ConstStrLenContainer HttpResponse::GetCannedError(HttpStatusCode const code) noexcept
 			{
-				switch(statusCode)
+				switch(code)
 				{
-				case HttpStatusCode::CONTINUE:
-					return ConstStrLenContainer("Continue", 8);
-				case HttpStatusCode::SWITCHING_PROTOCOL:
-					return ConstStrLenContainer("Switching Protocols", 19);
-				case HttpStatusCode::PROCESSING:
-					return ConstStrLenContainer("Processing", 10);
-				case HttpStatusCode::EARLY_HITS:
-					return ConstStrLenContainer("Early Hits", 10);
-				case HttpStatusCode::OK:
-					return ConstStrLenContainer("OK", 2);
-				case HttpStatusCode::CREATED:
-					return ConstStrLenContainer("Created", 7);
-				case HttpStatusCode::ACCEPTED:
-					return ConstStrLenContainer("Accepted", 8);
-				case HttpStatusCode::NON_AUTH_INFO:
-					return ConstStrLenContainer("Non-Authoritative Information", 29);
-				case HttpStatusCode::NO_CONTENT:
-					return ConstStrLenContainer("No Content", 10);
-				case HttpStatusCode::RESET_CONTENT:
-					return ConstStrLenContainer("Reset Content", 13);
-				case HttpStatusCode::PARTIAL_CONTENT:
-					return ConstStrLenContainer("Partial Content", 15);
-				case HttpStatusCode::MULTI_STATUS:
-					return ConstStrLenContainer("Multi-Status", 12);
-				case HttpStatusCode::ALREADY_REPORTED:
-					return ConstStrLenContainer("Already Reported", 16);
-				case HttpStatusCode::IM_USED:
-					return ConstStrLenContainer("IM Used", 7);
-				case HttpStatusCode::MULTIPLE_CHOICES:
-					return ConstStrLenContainer("Multiple Choices", 16);
-				case HttpStatusCode::MOVED_PERMANENTLY:
-					return ConstStrLenContainer("Moved Permanently", 17);
-				case HttpStatusCode::FOUND:
-					return ConstStrLenContainer("Found", 5);
-				case HttpStatusCode::SEE_OTHER:
-					return ConstStrLenContainer("See Other", 9);
-				case HttpStatusCode::NOT_MODIFIED:
-					return ConstStrLenContainer("Not Modified", 12);
-				case HttpStatusCode::USE_PROXY:
-					return ConstStrLenContainer("Use Proxy", 9);
-				case HttpStatusCode::SWITCH_PROXY:
-					return ConstStrLenContainer("Switch Proxy", 12);
-				case HttpStatusCode::TEMPORARY_REDICT:
-					return ConstStrLenContainer("Temporary Redict", 16);
-				case HttpStatusCode::PERMANENT_REDIRECT:
-					return ConstStrLenContainer("Permanent Redirect", 18);
-				case HttpStatusCode::BAD_REQUEST:
-					return ConstStrLenContainer("Bad Request", 11);
-				case HttpStatusCode::UNAUTHORIZED:
-					return ConstStrLenContainer("Unauthorized", 12);
-				case HttpStatusCode::PAYMENT_REQUIRED:
-					return ConstStrLenContainer("Payment Required", 16);
-				case HttpStatusCode::FORBIDDEN:
-					return ConstStrLenContainer("Forbidden", 9);
-				case HttpStatusCode::NOT_FOUND:
-					return ConstStrLenContainer("Not Found", 9);
-				case HttpStatusCode::METHOD_NOT_ALLOWED:
-					return ConstStrLenContainer("Method Not Allowed", 18);
-				case HttpStatusCode::NOT_ACCEPTABLE:
-					return ConstStrLenContainer("Not Acceptable", 14);
-				case HttpStatusCode::PROXY_AUTH_REQUIRED:
-					return ConstStrLenContainer("Proxy Authentication Required", 29);
-				case HttpStatusCode::REQUEST_TIMEOUT:
-					return ConstStrLenContainer("Request Time-out", 16);
-				case HttpStatusCode::CONFLICT:
-					return ConstStrLenContainer("Conflict", 8);
-				case HttpStatusCode::GONE:
-					return ConstStrLenContainer("Gone", 4);
-				case HttpStatusCode::LENGTH_REQUIRED:
-					return ConstStrLenContainer("Length Required", 15);
-				case HttpStatusCode::PAYLOAD_TOO_LARGE:
-					return ConstStrLenContainer("Payload Too Large", 17);
-				case HttpStatusCode::URI_TOO_LONG:
-					return ConstStrLenContainer("URI Too Long", 12);
-				case HttpStatusCode::UNSUPPORTED_MEDIA_TYPE:
-					return ConstStrLenContainer("Unsupported Media Type", 22);
-				case HttpStatusCode::RANGE_NOT_SATISFIABLE:
-					return ConstStrLenContainer("Range Not Satisfiable", 21);
-				case HttpStatusCode::EXPECTATION_FAILED:
-					return ConstStrLenContainer("Expectation Failed", 18);
-				case HttpStatusCode::IM_A_TEAPOT:
-					return ConstStrLenContainer("I'm a teapot", 12);
-				case HttpStatusCode::MISDIRECTED_REQUEST:
-					return ConstStrLenContainer("Misdirected Request", 19);
-				case HttpStatusCode::UNPROCESSABLE_ENTITY:
-					return ConstStrLenContainer("Unsupported Media Type", 22);
-				case HttpStatusCode::LOCKED:
-					return ConstStrLenContainer("Locked", 6);
-				case HttpStatusCode::FAILED_DEPENDENCY:
-					return ConstStrLenContainer("Failed Dependency", 17);
-				case HttpStatusCode::UPGRADE_REQUIRED:
-					return ConstStrLenContainer("Upgrade Required", 16);
-				case HttpStatusCode::PRECONDITION_REQUIRED:
-					return ConstStrLenContainer("Precondition Required", 21);
-				case HttpStatusCode::TOO_MANY_REQUESTS:
-					return ConstStrLenContainer("Too Many Requests", 17);
-				case HttpStatusCode::REQUEST_HEADER_FIELDS_TOO_LARGE:
-					return ConstStrLenContainer("Request Header Fields Too Large", 31);
-				case HttpStatusCode::UNAVAILABLE_FOR_LEGAL_REASONS:
-					return ConstStrLenContainer("Unavailable For Legal Reasons", 29);
-				case HttpStatusCode::INTERNAL_SERVER_ERROR:
-					return ConstStrLenContainer("Internal Server Error", 21);
-				case HttpStatusCode::NOT_IMPLEMENTED:
-					return ConstStrLenContainer("Not Implemented", 15);
-				case HttpStatusCode::BAD_GATEWAY:
-					return ConstStrLenContainer("Bad Gateway", 11);
-				case HttpStatusCode::SERVICE_UNAVAILABLE:
-					return ConstStrLenContainer("Service Unavailable", 19);
-				case HttpStatusCode::GATEWAY_TIMEOUT:
-					return ConstStrLenContainer("Gateway Timeout", 15);
-				case HttpStatusCode::HTTP_VERSION_NOT_SUPPORTED:
-					return ConstStrLenContainer("HTTP Version not supported", 26);
-				case HttpStatusCode::VARIANT_ALSO_NEGOTIATES:
-					return ConstStrLenContainer("Variant Also Negotiates", 23);
-				case HttpStatusCode::INSUFFICIENT_STORAGE:
-					return ConstStrLenContainer("Insufficient Storage", 20);
-				case HttpStatusCode::LOOP_DETECTED:
-					return ConstStrLenContainer("Loop Detected", 13);
-				case HttpStatusCode::NOT_EXTENDED:
-					return ConstStrLenContainer("Not Extended", 12);
-				case HttpStatusCode::NETWORK_AUTH_REQUIRED:
-					return ConstStrLenContainer("Network Authentication Required", 31);
+				HTTP_RESPONSE_CONST_TEXT(BAD_REQUEST, "HTTP/1.1 400 Bad Request\r\nContent-Length: 0");
+				HTTP_RESPONSE_CONST_TEXT(METHOD_NOT_ALLOWED, "HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0");
+				HTTP_RESPONSE_CONST_TEXT(REQUEST_TIMEOUT, "HTTP/1.1 408 Request Time-out\r\nContent-Length: 0");
+				HTTP_RESPONSE_CONST_TEXT(LENGTH_REQUIRED, "HTTP/1.1 411 Length Required\r\nContent-Length: 0");
+				HTTP_RESPONSE_CONST_TEXT(PAYLOAD_TOO_LARGE, "HTTP/1.1 413 Payload Too Large\r\nContent-Length: 0");
+				HTTP_RESPONSE_CONST_TEXT(EXPECTATION_FAILED, "HTTP/1.1 417 Expectation Failed\r\nContent-Length: 0");
+				HTTP_RESPONSE_CONST_TEXT(INTERNAL_SERVER_ERROR, "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0");
+				HTTP_RESPONSE_CONST_TEXT(NOT_IMPLEMENTED, "HTTP/1.1 501 Not Implemented\r\nContent-Length: 0");
 				default:
-					Logger::LogException("No description for this status code available", __FILE__, __LINE__);
-					return ConstStrLenContainer(0, 0);
+					return ConstStrLenContainer(nullptr, 0);
 				}
 			}
 
@@ -477,9 +845,16 @@ namespace Peoplez
 
 			void HttpResponse::ResetBodyAndLocation() noexcept
 			{
+				acceptRanges = false;
+				contentRange.Clear();
+				lastModified = 0;
+				canned = ConstStrLenContainer(nullptr, 0);
+				prebuilt.reset();
 				redirectLocation.Clear();
 				contentType.SetTo(HTTP_RESPONSE_CONTENT_TYPE_DEFAULT, HTTP_RESPONSE_CONTENT_TYPE_DEFAULT_LEN);
 				eTag = 0;
+				stream.reset();
+				varyEncoding = false;
 			}
 
 			bool HttpResponse::SetStatusCode(HttpStatusCode const code)
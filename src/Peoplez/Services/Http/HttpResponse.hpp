@@ -40,10 +40,13 @@
 #include "../../String/PeoplezString.hpp"
 #include "Enums.hpp"
 #include "HttpCookie.hpp"
+#include "HttpHeaderList.hpp"
+#include "HttpResponseStream.hpp"
 
 // Extern includes
+#include <ctime>
 #include <list>
-#include <unordered_map>
+#include <memory>
 
 namespace Peoplez
 {
@@ -51,6 +54,8 @@ namespace Peoplez
 	{
 		namespace Http
 		{
+			class HttpRequest;
+
 			/**
 			 * @enum HttpStatusCode
 			 * @brief Status codes for http responses
@@ -132,9 +137,17 @@ namespace Peoplez
 			class HttpResponse final
 			{
 				friend class HttpContext;
-				typedef std::unordered_map<String::PeoplezString, String::PeoplezString> StringMap;
+				friend class Http2Connection;
 				typedef std::pair<char const *, size_t> ConstStrLenContainer;
 			public:
+				/**
+				 * @brief Length of the Date and connection header fields of keep-alive connections ("\r\nDate: " + HTTP-date + connection headers)
+				 */
+				static constexpr size_t CONNECTION_HEADERS_KEEP_ALIVE_LENGTH = 8 + 29 + 49;
+				/**
+				 * @brief Length of the Date and connection header fields of connections that are closed after the response
+				 */
+				static constexpr size_t CONNECTION_HEADERS_CLOSE_LENGTH = 8 + 29 + 21;
 
 				HttpResponse();
 
@@ -150,6 +163,21 @@ namespace Peoplez
 				 * @return Complete response text
 				 */
 				String::PeoplezString GetResponseText();
+				/**
+				 * Serializes the response into the given buffer (replacing its content)
+				 *
+				 * The exact length is calculated first, so the buffer grows at most once. A buffer that is reused and not shared anymore
+				 * (e.g. the output buffer of a connection) keeps its storage: no allocation for responses without cookies.
+				 *
+				 * @param dest Target buffer
+				 * @param includeBody Indicates whether large bodies are copied as well (see HasSeparateBody)
+				 * @param headOnly Indicates that the body is left out although the header fields describe it (responses to HEAD requests)
+				 */
+				void SerializeTo(String::PeoplezString & dest, bool includeBody = false, bool headOnly = false);
+				/**
+				 * Indicates whether the body is not copied by SerializeTo (without includeBody) and has to be sent from GetBody() after it
+				 */
+				bool HasSeparateBody() const noexcept __attribute__((pure));
 				/**
 				 * Sets the status code and the body of the result.
 				 *
@@ -208,6 +236,74 @@ namespace Peoplez
 				 * @param compr The compression method the body is compressed with
 				 */
 				void SetWithBody(HttpStatusCode code, String::PeoplezString contentType, String::PeoplezString body, size_t eTag, HttpCompression compr);
+				/**
+				 * Restricts the body that is set to the byte ranges requested by the client (Range and If-Range header fields)
+				 *
+				 * Has to be called after SetWithBody and only changes responses with status code OK. Adds an Accept-Ranges header.
+				 * A single range is sent as view of the body (206), several ranges as multipart/byteranges containing copies of the requested parts only.
+				 * If no range is satisfiable the status code is RANGE_NOT_SATISFIABLE. Invalid range headers, too many ranges
+				 * and ranges with another entity tag in If-Range are ignored (complete body).
+				 *
+				 * @param request Request of the client
+				 */
+				void SetRange(HttpRequest const & request);
+				/**
+				 * Sets the modification time of the body that is sent as Last-Modified header
+				 *
+				 * Has to be called after SetWithBody or SetNotModified.
+				 *
+				 * @param time Modification time (0 for none)
+				 */
+				inline void SetLastModified(time_t const time) noexcept {lastModified = time;}
+				/**
+				 * Marks the body as selected by the Accept-Encoding header field of the request (Vary header for caches)
+				 *
+				 * Has to be called after SetWithBody or SetNotModified.
+				 *
+				 * @param vary Indicates whether a Vary: Accept-Encoding header is sent
+				 */
+				inline void SetVaryEncoding(bool const vary) noexcept {varyEncoding = vary;}
+				/**
+				 * Answers a conditional request whose cached version is still valid (see HttpRequest::IsNotModified)
+				 *
+				 * Same priority rules as SetWithBody.
+				 *
+				 * @param eTag Entity tag of the current version
+				 * @param lastModified Modification time of the current version (0 if unknown)
+				 * @param prebuilt 304 response created by CreateNotModified for the same version; sent with the current Date unless cookies or
+				 * headers are added or the connection is closed. Empty to create the response on sending. Only read, so it may be shared between threads.
+				 */
+				void SetNotModified(size_t eTag, time_t lastModified, std::shared_ptr<String::PeoplezString const> prebuilt = std::shared_ptr<String::PeoplezString const>());
+				/**
+				 * Creates the complete 304 response of a version for keep-alive connections (e.g. once per cached resource)
+				 *
+				 * @param eTag Entity tag of the version
+				 * @param lastModified Modification time of the version (0 if unknown)
+				 * @param varyEncoding Indicates whether the resource has several content codings (see SetVaryEncoding)
+				 *
+				 * @return Response text for SetNotModified (without Date and connection header fields)
+				 */
+				static String::PeoplezString CreateNotModified(size_t eTag, time_t lastModified, bool varyEncoding = false);
+				/**
+				 * Sets the status code and a body that is produced while it is sent
+				 *
+				 * Same priority rules as SetWithBody. Instead of a Content-Length header the body is sent with chunked transfer coding.
+				 *
+				 * @param code Status code to send the response with (e.g. OK)
+				 * @param contentType Content type of the body
+				 * @param stream Producer of the body
+				 */
+				void SetStream(HttpStatusCode code, String::PeoplezString contentType, std::shared_ptr<HttpResponseStream> stream);
+				/**
+				 * Getter for the body
+				 */
+				inline String::PeoplezString const & GetBody() const noexcept {return data;}
+				/**
+				 * Getter for the producer of a streamed body
+				 *
+				 * @return Producer set by SetStream; empty if the body is not streamed
+				 */
+				inline std::shared_ptr<HttpResponseStream> const & GetStream() const noexcept {return stream;}
 				/**
 				 * Sets a redict as answer
 				 *
@@ -223,6 +319,15 @@ namespace Peoplez
 				 * @param code Status code of the response (should be an error code)
 				 */
 				void SetOther(HttpStatusCode code);
+				/**
+				 * Sets an error status code and closes the connection after the response
+				 *
+				 * Like SetOther. For the errors the server detects itself while receiving a request (e.g. BAD_REQUEST, PAYLOAD_TOO_LARGE)
+				 * a canned response is sent that only gets the Date and Connection header fields added.
+				 *
+				 * @param code Status code of the response (should be an error code)
+				 */
+				void SetError(HttpStatusCode code);
 				virtual ~HttpResponse() {}
 
 				/**
@@ -230,9 +335,9 @@ namespace Peoplez
 				 */
 				std::list<HttpCookie> Cookies;
 				/**
-				 * @brief List of additional response header fields
+				 * @brief List of additional response header fields (sent in insertion order)
 				 */
-				StringMap Headers;
+				HttpHeaderList Headers;
 				/**
 				 * @brief Indicates whether a KeepAlive header is sent with the response
 				 */
@@ -240,26 +345,33 @@ namespace Peoplez
 
 			private:
 				//String::PeoplezString CreateCompleteHeader();
+				size_t GetCookiesSize() const;
 				/**
-				 * Creates the header entries in the "Headers" field
+				 * Getter for the Date and Connection header fields that are sent with every response
+				 *
+				 * The block is formatted once per second and thread (valid until the next call of the same thread).
 				 *
-				 * @return Generated header entries for the response
+				 * @param keepAlive Indicates whether the connection is kept open
+				 *
+				 * @return Header block including the line break at its end
 				 */
-				String::PeoplezString CreateHeaders() const;
+				static ConstStrLenContainer GetConnectionHeaders(bool keepAlive) noexcept;
 				/**
-				 * Creates the cookie header fields
+				 * Getter for the canned response of an error status code (see SetError)
+				 *
+				 * @param code Status code of the response
 				 *
-				 * @return Header entries for the cookies
+				 * @return Status line and header fields without Date, Connection and the empty line; empty if the code has none
 				 */
-				String::PeoplezString CreateCookies() const;
-				size_t GetCookiesSize() const;
-				size_t GetHeadersSize() const;
+				static constexpr ConstStrLenContainer GetCannedError(HttpStatusCode code) noexcept;
 				/**
-				 * Detects the status description of the set status code
+				 * Getter for the complete status line of a status code ("HTTP/1.1 200 OK")
+				 *
+				 * @param code Status code of the response
 				 *
-				 * @return Description of the set status code
+				 * @return Status line without line break; empty if the status code is unknown
 				 */
-				ConstStrLenContainer GetStatusDescription() const;
+				static constexpr ConstStrLenContainer GetStatusLine(HttpStatusCode code) noexcept;
 				/**
 				 * Detects whether the set response code is a redict code
 				 *
@@ -279,7 +391,19 @@ namespace Peoplez
 				 */
 				bool SetStatusCode(HttpStatusCode code);
 
+				/**
+				 * @brief Indicates that an Accept-Ranges header is sent (see SetRange)
+				 */
+				bool acceptRanges;
+				/**
+				 * @brief Canned error response to send instead of the created one (see SetError); empty if none
+				 */
+				ConstStrLenContainer canned;
 				HttpCompression compression;
+				/**
+				 * @brief Value of the Content-Range header; empty if none is sent
+				 */
+				String::PeoplezString contentRange;
 				String::PeoplezString contentType;
 				String::PeoplezString data;
 				/**
@@ -287,8 +411,24 @@ namespace Peoplez
 				 */
 				bool dataSet;
 				size_t eTag;
+				/**
+				 * @brief Modification time of the body (Last-Modified header); 0 if none is sent
+				 */
+				time_t lastModified;
+				/**
+				 * @brief Complete response text to send instead of the created one (see SetNotModified)
+				 */
+				std::shared_ptr<String::PeoplezString const> prebuilt;
 				String::PeoplezString redirectLocation;
 				HttpStatusCode statusCode;
+				/**
+				 * @brief Producer of a streamed body (see SetStream)
+				 */
+				std::shared_ptr<HttpResponseStream> stream;
+				/**
+				 * @brief Indicates that a Vary: Accept-Encoding header is sent (see SetVaryEncoding)
+				 */
+				bool varyEncoding;
 			};
 		} // namespace Http
 	} // namespace Services
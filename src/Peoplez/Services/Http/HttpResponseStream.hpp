@@ -0,0 +1,101 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTPRESPONSESTREAM_HPP_
+#define PEOPLEZ_SERVICES_HTTP_HTTPRESPONSESTREAM_HPP_
+
+// Local includes
+#include "../../String/PeoplezString.hpp"
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			class HttpContext;
+
+			/**
+			 * @brief Result of HttpResponseStream::NextChunk
+			 */
+			enum class HttpResponseStreamStatus : unsigned char
+			{
+				/**
+				 * @brief A chunk is returned, more may follow
+				 */
+				DATA,
+				/**
+				 * @brief Nothing available at the moment; the stream is asked again after HttpContext::ResumeResponse
+				 */
+				WAIT,
+				/**
+				 * @brief The body is complete (a returned chunk is sent before)
+				 */
+				END
+			};
+
+			/**
+			 * @brief Producer of a response body that is sent while it is produced
+			 *
+			 * @details
+			 * Set with HttpResponse::SetStream. The body is sent with chunked transfer coding.
+			 * The stream is asked for the next chunk whenever the socket send buffer can take more data,
+			 * so only a bounded part of the body is held in memory.
+			 */
+			class HttpResponseStream
+			{
+			public:
+				/**
+				 * Produces the next part of the body
+				 *
+				 * @param context Context of the request
+				 * @param chunk Target for the next part of the body (empty chunks are not sent)
+				 *
+				 * @return Indicates whether more data follow
+				 */
+				virtual HttpResponseStreamStatus NextChunk(HttpContext & context, String::PeoplezString & chunk) = 0;
+				/**
+				 * Called if the connection ends before the body is complete
+				 *
+				 * @param context Context of the request
+				 */
+				virtual void Aborted(HttpContext & context) noexcept {}
+				virtual ~HttpResponseStream() {}
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTPRESPONSESTREAM_HPP_
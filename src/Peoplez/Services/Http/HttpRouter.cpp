@@ -0,0 +1,202 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "HttpRouter.hpp"
+
+// Local includes
+#include "HttpFunctions.hpp"
+
+// Extern includes
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace String;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			HttpRouter::HttpRouter(std::shared_ptr<HttpRequestHandler> fallback) : fallback(fallback) {}
+
+			bool HttpRouter::AddRoute(HttpMethods const method, PeoplezString const path, std::shared_ptr<HttpRequestHandler> const handler)
+			{
+				return SetRoute(method, path, handler);
+			}
+
+			void HttpRouter::RemoveRoute(HttpMethods const method, PeoplezString const path)
+			{
+				SetRoute(method, path, std::shared_ptr<HttpRequestHandler>());
+			}
+
+			void HttpRouter::ProcessRequest(HttpContext & context)
+			{
+				std::shared_ptr<HttpRequestHandler> const handler = Route(context);
+
+				if(handler) handler->ProcessRequest(context);
+			}
+
+			HttpBodyStreamHandler * HttpRouter::GetBodyStreamHandler(HttpContext & context)
+			{
+				std::shared_ptr<HttpRequestHandler> const handler = Route(context);
+
+				// The body stream handler belongs to the handler that is pinned in the context
+				return handler ? handler->GetBodyStreamHandler(context) : nullptr;
+			}
+
+			bool HttpRouter::AcceptHeaders(HttpContext & context)
+			{
+				std::shared_ptr<HttpRequestHandler> const handler = Route(context);
+
+				// Without handler the error response is already set
+				return handler && handler->AcceptHeaders(context);
+			}
+
+			std::shared_ptr<HttpRequestHandler> HttpRouter::Route(HttpContext & context) const
+			{
+				std::shared_ptr<HttpRequestHandler> handler;
+
+				{
+					General::RcuPointer<RouteTable>::ReadGuard const table = routes.Read();
+					handler = Route(*table, context);
+				}
+
+				// Keeps the handler alive for the rest of the request although its route may be removed meanwhile
+				// (a nested router pins its own target afterwards; it is held by the caller until it returns)
+				if(handler) context.RoutedHandler = handler;
+
+				return handler;
+			}
+
+			std::shared_ptr<HttpRequestHandler> const & HttpRouter::Route(RouteTable const & table, HttpContext & context) const
+			{
+				static std::shared_ptr<HttpRequestHandler> const none;
+
+				std::pmr::vector<PeoplezString> const & segments = context.request.Uri().PathSegments();
+				RouteTable::Captures captures;
+				MethodHandlers const * const handlers = table.FindTarget(segments.begin(), segments.end(), captures);
+
+				if(!handlers)
+				{
+					if(fallback) return fallback;
+
+					context.response.SetOther(HttpStatusCode::NOT_FOUND);
+					return none;
+				}
+
+				HttpMethods const method = context.request.HttpMethod();
+				std::shared_ptr<HttpRequestHandler> const * handler = &(*handlers)[(unsigned)method];
+
+				// HEAD is answered like GET (the body is not sent)
+				if(!*handler && method == HttpMethods::HEAD) handler = &(*handlers)[(unsigned)HttpMethods::GET];
+
+				if(!*handler)
+				{
+					// Methods of the path (error path only)
+					PeoplezString allow;
+
+					for(unsigned int i = 0; i < handlers->size(); ++i)
+					{
+						if(!(*handlers)[i]) continue;
+
+						if(!allow.IsEmpty()) allow.Append(", ", 2);
+						allow.Append(HttpFunctions::ToPString((HttpMethods)i));
+						if((HttpMethods)i == HttpMethods::GET && !(*handlers)[(unsigned)HttpMethods::HEAD]) allow.Append(", HEAD", 6);
+					}
+
+					context.response.SetOther(HttpStatusCode::METHOD_NOT_ALLOWED);
+					context.response.Headers.Set(PeoplezString("Allow", 5), allow);
+
+					return none;
+				}
+
+				// Parameters (single segments are shared, not copied)
+				context.request.routeParams.clear();
+
+				for(size_t i = 0; i < captures.Count; ++i)
+				{
+					RouteTable::Capture const & capture = captures.Entries[i];
+					PeoplezString value;
+
+					if(capture.Count == 1) value = segments[capture.First];
+					else
+					{
+						for(size_t s = capture.First; s < capture.First + capture.Count; ++s)
+						{
+							if(s != capture.First) value.Append("/", 1);
+							value.Append(segments[s]);
+						}
+					}
+
+					// The name belongs to the snapshot, which may be deleted before the request is finished ... copy it into the arena
+					char * const name = static_cast<char *>(context.RequestArena.allocate(capture.Name->Length(), 1));
+					std::memcpy(name, capture.Name->GetData(), capture.Name->Length());
+
+					context.request.routeParams.emplace_back(std::string_view(name, capture.Name->Length()), value);
+				}
+
+				return *handler;
+			}
+
+			bool HttpRouter::SetRoute(HttpMethods const method, PeoplezString const & path, std::shared_ptr<HttpRequestHandler> const & handler)
+			{
+				// Same segments as HttpRequestUri::PathSegments() (without URL-decoding; routes are given decoded)
+				std::vector<PeoplezString> segments;
+				path.Split<true>(segments, '/');
+
+				return routes.Update([&](RouteTable & table)
+				{
+					// Handlers are shared with older snapshots ... replace instead of modifying them
+					std::shared_ptr<MethodHandlers> const old = table.GetInsertedTarget(segments.begin(), segments.end());
+					std::shared_ptr<MethodHandlers> handlers(old ? new MethodHandlers(*old) : new MethodHandlers());
+					(*handlers)[(unsigned)method] = handler;
+
+					// Invalid paths and parameter names that conflict with other routes discard the copy
+					if(std::any_of(handlers->begin(), handlers->end(), [](std::shared_ptr<HttpRequestHandler> const & entry) {return (bool) entry;})) return table.InsertTarget(segments.begin(), segments.end(), handlers, true);
+
+					// Nothing to remove ... nothing to publish
+					if(!old) return false;
+
+					table.RemoveTarget(segments.begin(), segments.end());
+					return true;
+				});
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_HTTPROUTER_H_
+#define PEOPLEZ_SERVICES_HTTP_HTTPROUTER_H_
+
+// Local includes
+#include "../../General/PathTree.hpp"
+#include "../../General/RcuPointer.hpp"
+#include "../../String/PeoplezString.hpp"
+#include "Enums.hpp"
+#include "HttpRequestHandler.hpp"
+
+// Extern includes
+#include <array>
+#include <memory>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Request handler that dispatches requests by path and method to other handlers
+			 * @details The route table is an immutable snapshot: lookups never lock, changes copy the table and publish
+			 * the copy (see General::RcuPointer). Changing routes waits until running lookups are finished, so it is
+			 * meant for configuration rather than for every request.
+			 *
+			 * Paths are compared segment by segment with HttpRequestUri::PathSegments() (URL-decoded, empty segments removed).
+			 * HEAD requests use the GET handler if no HEAD handler is set. Unknown paths are answered with 404 (or passed to the
+			 * fallback handler), known paths with other methods with 405 and an Allow header field.
+			 */
+			class HttpRouter final : public HttpRequestHandler
+			{
+			public:
+				/**
+				 * Constructor
+				 *
+				 * @param fallback Handler of requests to unknown paths; nullptr to answer them with 404
+				 */
+				explicit HttpRouter(std::shared_ptr<HttpRequestHandler> fallback = std::shared_ptr<HttpRequestHandler>());
+
+				/**
+				 * Sets the handler of a path and method (replaces an existing one)
+				 *
+				 * Segments starting with ':' are parameters, a last segment starting with '*' matches the rest of the path
+				 * (see General::PathTree). The matched values are available with HttpRequest::RouteParams().
+				 *
+				 * @param method Method of the requests
+				 * @param path Path of the requests (e.g. "/api/users/:id")
+				 * @param handler Handler of the requests
+				 *
+				 * @return False if the path is invalid or names a parameter differently than another route at the same position
+				 */
+				bool AddRoute(HttpMethods method, String::PeoplezString path, std::shared_ptr<HttpRequestHandler> handler);
+				/**
+				 * Removes the handler of a path and method
+				 *
+				 * The handler is released after all requests routed to it are processed (see HttpContext::RoutedHandler).
+				 *
+				 * @param method Method of the requests
+				 * @param path Path of the requests (e.g. "/api/users")
+				 */
+				void RemoveRoute(HttpMethods method, String::PeoplezString path);
+
+				virtual void ProcessRequest(HttpContext & context) override;
+				virtual HttpBodyStreamHandler * GetBodyStreamHandler(HttpContext & context) override;
+				virtual bool AcceptHeaders(HttpContext & context) override;
+				virtual ~HttpRouter() {}
+
+			private:
+				/**
+				 * @var typedef std::array<std::shared_ptr<HttpRequestHandler>, (unsigned)HttpMethods::MAX + 1> MethodHandlers
+				 * @brief Handlers of one path indexed by method
+				 */
+				typedef std::array<std::shared_ptr<HttpRequestHandler>, (unsigned)HttpMethods::MAX + 1> MethodHandlers;
+				/**
+				 * @var typedef General::PathTree<MethodHandlers> RouteTable
+				 * @brief Snapshot of all routes
+				 */
+				typedef General::PathTree<MethodHandlers> RouteTable;
+
+				/**
+				 * Looks up the handler of a request in the current snapshot and pins it in the context (HttpContext::RoutedHandler)
+				 *
+				 * @param context Context of the request
+				 *
+				 * @return Handler of the request; empty if there is none
+				 */
+				std::shared_ptr<HttpRequestHandler> Route(HttpContext & context) const;
+				/**
+				 * Looks up the handler of a request
+				 *
+				 * Sets the route parameters of the request or the error response (404 or 405) if there is no handler.
+				 *
+				 * @param table Snapshot to search in
+				 * @param context Context of the request
+				 *
+				 * @return Handler of the request (valid as long as the snapshot); empty if there is none
+				 */
+				std::shared_ptr<HttpRequestHandler> const & Route(RouteTable const & table, HttpContext & context) const;
+				/**
+				 * Changes the handler of a path and method
+				 *
+				 * @param method Method of the requests
+				 * @param path Path of the requests
+				 * @param handler New handler; nullptr to remove it
+				 *
+				 * @return Indicates whether the route table was changed (false for invalid or conflicting paths and removing missing routes)
+				 */
+				bool SetRoute(HttpMethods method, String::PeoplezString const & path, std::shared_ptr<HttpRequestHandler> const & handler);
+
+				/**
+				 * @brief Handler of requests to unknown paths (may be empty)
+				 */
+				std::shared_ptr<HttpRequestHandler> const fallback;
+				/**
+				 * @brief Current route table
+				 */
+				General::RcuPointer<RouteTable> routes;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_HTTPROUTER_H_
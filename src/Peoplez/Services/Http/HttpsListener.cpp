@@ -35,6 +35,7 @@
 
 #include "HttpsListener.hpp"
 
+#include "Http2ClientInfo.hpp"
 #include "HttpClientInfo.hpp"
 #include "../../System/IO/Network/SecureSocket.hpp"
 
@@ -82,8 +83,13 @@ namespace Peoplez
 					if(SSL_CTX_use_certificate_file(ctx, puKey, SSL_FILETYPE_PEM) <= 0) throw std::runtime_error("Unable to load cert file");
 					if(SSL_CTX_use_PrivateKey_file(ctx, prKey, SSL_FILETYPE_PEM) <= 0) throw std::runtime_error("Unable to load private key file");
 
-					if(SSL_CTX_set_cipher_list(ctx, "kEECDH kEDH +ECDH +AES128 +SHA !aNULL !eNULL !LOW !3DES !MD5 !EXP !DSS !PSK !SRP !kECDH !CAMELLIA !IDEA !SEED !RC4") <= 0)
+					// AEAD suites first (RFC 7540 §9.2.2); the CBC suites are only a fallback for HTTP/1.1 clients (see Http2ClientInfo::SelectProtocolCB)
+					SSL_CTX_set_options(ctx, SSL_OP_CIPHER_SERVER_PREFERENCE);
+					if(SSL_CTX_set_cipher_list(ctx, "ECDHE+AESGCM ECDHE+CHACHA20 DHE+AESGCM DHE+CHACHA20 kEECDH kEDH +SHA !aNULL !eNULL !LOW !3DES !MD5 !EXP !DSS !PSK !SRP !kECDH !CAMELLIA !IDEA !SEED !RC4 !ARIA") <= 0)
 						throw std::runtime_error("Unable to set cipher suite");
+
+					// Offer HTTP/2 via ALPN
+					SSL_CTX_set_alpn_select_cb(ctx, Http2ClientInfo::SelectProtocolCB, nullptr);
 				}
 
 				// Create Socket
@@ -125,6 +131,7 @@ namespace Peoplez
 					SSL_set_fd(ssl, client);
 
 					if(SSL_accept(ssl) <= 0) return 0;
+					else if(Http2ClientInfo::IsNegotiated(ssl)) return new Http2ClientInfo(client, requestHandler, new SecureSocket(client, ssl));
 					else return new HttpClientInfo(client, requestHandler, new SecureSocket(client, ssl));
 				}
 				else return 0;
@@ -35,6 +35,7 @@
 
 // Local includes
 #include "HttpsListenerSNI.hpp"
+#include "Http2ClientInfo.hpp"
 #include "HttpClientInfo.hpp"
 #include "../../System/IO/Network/SecureSocket.hpp"
 
@@ -48,8 +49,9 @@ extern "C"
 #include <unistd.h>
 }
 
+// AEAD suites first (RFC 7540 §9.2.2); the CBC suites are only a fallback for HTTP/1.1 clients (see Http2ClientInfo::SelectProtocolCB)
 #ifndef PEOPLEZ_DEFAULT_CIPHER_LIST
-	#define PEOPLEZ_DEFAULT_CIPHER_LIST "kEECDH kEDH +ECDH +AES128 +SHA !aNULL !eNULL !LOW !3DES !MD5 !EXP !DSS !PSK !SRP !kECDH !CAMELLIA !IDEA !SEED !RC4"
+	#define PEOPLEZ_DEFAULT_CIPHER_LIST "ECDHE+AESGCM ECDHE+CHACHA20 DHE+AESGCM DHE+CHACHA20 kEECDH kEDH +SHA !aNULL !eNULL !LOW !3DES !MD5 !EXP !DSS !PSK !SRP !kECDH !CAMELLIA !IDEA !SEED !RC4 !ARIA"
 #endif
 
 using namespace Peoplez::System::IO::Network;
@@ -142,6 +144,7 @@ namespace Peoplez
 							bool configError = false;
 
 							SSL_CTX_set_ecdh_auto(ctx, 1);
+							SSL_CTX_set_options(ctx, SSL_OP_CIPHER_SERVER_PREFERENCE);
 							if(SSL_CTX_use_certificate_file(ctx, certs[i].pubKey, SSL_FILETYPE_PEM) <= 0) configError = true;
 							if(!configError && SSL_CTX_use_PrivateKey_file(ctx, certs[i].privKey, SSL_FILETYPE_PEM) <= 0) configError = true;
 
@@ -155,6 +158,9 @@ namespace Peoplez
 
 								// Set context specific content passed to callback
 								SSL_CTX_set_tlsext_servername_arg(ctx, &data);
+
+								// Offer HTTP/2 via ALPN
+								SSL_CTX_set_alpn_select_cb(ctx, Http2ClientInfo::SelectProtocolCB, nullptr);
 							}
 
 							// Add context to m_contexts
@@ -234,6 +240,7 @@ namespace Peoplez
 					SSL_set_fd(ssl, client);
 
 					if(SSL_accept(ssl) <= 0) return 0;
+					else if(Http2ClientInfo::IsNegotiated(ssl)) return new Http2ClientInfo(client, requestHandler, new SecureSocket(client, ssl));
 					else return new HttpClientInfo(client, requestHandler, new SecureSocket(client, ssl));
 					return 0;
 				}
@@ -0,0 +1,361 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "MultipartFormDataParser.hpp"
+
+// Local includes
+#include "../../General/MimeOperations.hpp"
+#include "../../System/Logging/Logger.hpp"
+
+// External includes
+#include <algorithm>
+#include <cstring>
+#include <strings.h>
+
+/**
+ * @def MAX_BOUNDARY_LENGTH
+ * @brief Maximum length of a boundary (RFC 2046)
+ */
+#define MAX_BOUNDARY_LENGTH 70
+/**
+ * @def MAX_PART_HEADER_LENGTH
+ * @brief Maximum accepted length of the headers of one part in bytes
+ */
+#define MAX_PART_HEADER_LENGTH 8192
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace General;
+	using namespace String;
+	using namespace System::Logging;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			namespace
+			{
+				/**
+				 * Reads the value of a header parameter (e.g. name="abc")
+				 *
+				 * @param param Parameter including name and '='
+				 * @param nameLen Length of the parameter name including '='
+				 *
+				 * @return Value without quotes
+				 */
+				PeoplezString ParameterValue(PeoplezString const & param, size_t const nameLen)
+				{
+					PeoplezString value = param.Substring(nameLen);
+					value.TrimFast();
+
+					if(value.Length() >= 2 && value[0] == '"' && value[value.Length() - 1] == '"') value = value.Substring(1, value.Length() - 2);
+
+					return value;
+				}
+			} // namespace
+
+			MultipartFormDataParser::MultipartFormDataParser(PeoplezString boundary) : delimiter("\r\n--", 4), pending("\r\n", 2), state(State::PREAMBLE), error(HttpStatusCode::OK), delimiterEnd(0)
+			{
+				// The first delimiter may be at the very beginning of the body (without preceding CRLF).
+				// So the preamble starts with an already matched CRLF (pending).
+
+				// Remove quotes
+				boundary.TrimFast();
+				if(boundary.Length() >= 2 && boundary[0] == '"' && boundary[boundary.Length() - 1] == '"') boundary = boundary.Substring(1, boundary.Length() - 2);
+
+				// A carriage return in the boundary would break the delimiter search
+				if(boundary.IsEmpty() || boundary.Length() > MAX_BOUNDARY_LENGTH || memchr(boundary.GetData(), '\r', boundary.Length())) Fail(HttpStatusCode::BAD_REQUEST);
+				else delimiter.Append(boundary);
+			}
+
+			HttpStatusCode MultipartFormDataParser::Fail(HttpStatusCode const status) noexcept
+			{
+				state = State::FAILED;
+				error = status;
+
+				return status;
+			}
+
+			size_t MultipartFormDataParser::FindDelimiter(char const * const data, size_t const len) const noexcept
+			{
+				size_t const dLen = delimiter.Length();
+
+				if(len >= dLen)
+				{
+					char const * const end = data + len - dLen + 1;
+
+					// The delimiter contains only one carriage return -> skip to candidates with (vectorized) memchr
+					for(char const * pos = (char const *) memchr(data, '\r', end - data); pos; pos = (char const *) memchr(pos + 1, '\r', end - pos - 1))
+					{
+						if(!memcmp(pos, delimiter.GetData(), dLen)) return pos - data;
+					}
+				}
+
+				return PeoplezString::NPOS;
+			}
+
+			HttpStatusCode MultipartFormDataParser::Feed(PeoplezString const & chunk, PartHandler & handler) noexcept
+			{
+				try
+				{
+					char const * const data = chunk.GetData();
+					size_t const len = chunk.Length();
+					size_t const dLen = delimiter.Length();
+					size_t pos = 0;
+
+					while(pos < len)
+					{
+						switch(state)
+						{
+						case State::PREAMBLE:
+						case State::DATA:
+							{
+								// If a delimiter may have started in the last chunk ...
+								if(!pending.IsEmpty())
+								{
+									size_t const matched = pending.Length();
+									size_t const avail = std::min(dLen - matched, len - pos);
+
+									if(!memcmp(delimiter.GetData() + matched, data + pos, avail))
+									{
+										pos += avail;
+
+										// If delimiter is still incomplete ... wait for next chunk
+										if(matched + avail < dLen)
+										{
+											pending.Append(data + pos - avail, avail);
+											break;
+										}
+
+										pending.Clear();
+										if(state == State::DATA) handler.PartEnd();
+										state = State::DELIMITER_END;
+										break;
+									}
+
+									// It was content
+									if(state == State::DATA) handler.PartData(pending);
+									pending.Clear();
+								}
+
+								size_t const found = FindDelimiter(data + pos, len - pos);
+								size_t contentEnd;
+
+								if(found != PeoplezString::NPOS) contentEnd = pos + found;
+								else
+								{
+									// Keep a possible beginning of a delimiter at the end of the chunk
+									size_t const tailStart = std::max(pos, len - std::min(len, dLen - 1));
+									char const * const cr = (char const *) memrchr(data + tailStart, '\r', len - tailStart);
+
+									contentEnd = cr && !memcmp(cr, delimiter.GetData(), data + len - cr) ? cr - data : len;
+								}
+
+								// Emit content as view
+								if(state == State::DATA && contentEnd > pos) handler.PartData(chunk.Substring(pos, contentEnd - pos));
+
+								if(found != PeoplezString::NPOS)
+								{
+									if(state == State::DATA) handler.PartEnd();
+									state = State::DELIMITER_END;
+									pos = contentEnd + dLen;
+								}
+								else
+								{
+									pending.Append(data + contentEnd, len - contentEnd);
+									pos = len;
+								}
+							}
+							break;
+						case State::DELIMITER_END:
+							{
+								// "--" ends the body, CRLF (optionally after whitespace) starts the next part
+								char const c = data[pos++];
+
+								if(!delimiterEnd)
+								{
+									if(c == '-' || c == '\r') delimiterEnd = c;
+									else if(c != ' ' && c != '\t') return Fail(HttpStatusCode::BAD_REQUEST);
+								}
+								else if(delimiterEnd == '-' && c == '-') state = State::DONE;
+								else if(delimiterEnd == '\r' && c == '\n')
+								{
+									state = State::HEADERS;
+									delimiterEnd = 0;
+
+									// Headers start with the consumed CRLF, so an empty header block is just CRLF
+									pending.Append("\r\n", 2);
+								}
+								else return Fail(HttpStatusCode::BAD_REQUEST);
+							}
+							break;
+						case State::HEADERS:
+							{
+								PeoplezString headers;
+								size_t const matched = pending.Length();
+								bool complete = false;
+
+								// If headers start in this chunk ... try to use a view
+								if(matched == 2)
+								{
+									if(len - pos >= 2 && data[pos] == '\r' && data[pos + 1] == '\n')
+									{
+										pending.Clear();
+										pos += 2;
+										complete = true;
+									}
+									else
+									{
+										PeoplezString const rest = chunk.Substring(pos);
+										size_t const end = rest.FindDoubleNewLine();
+
+										if(end != PeoplezString::NPOS)
+										{
+											if(end > MAX_PART_HEADER_LENGTH) return Fail(HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
+
+											headers = rest.Substring(0, end + 2);
+											pending.Clear();
+											pos += end + 4;
+											complete = true;
+										}
+									}
+								}
+
+								// Copy headers that are split between chunks
+								if(!complete)
+								{
+									size_t const take = std::min(len - pos, MAX_PART_HEADER_LENGTH + 4 - std::min<size_t>(matched, MAX_PART_HEADER_LENGTH + 4));
+									pending.Append(data + pos, take);
+
+									size_t const end = pending.FindDoubleNewLine(matched > 3 ? matched - 3 : 0);
+
+									if(end == PeoplezString::NPOS)
+									{
+										if(pending.Length() >= MAX_PART_HEADER_LENGTH + 4) return Fail(HttpStatusCode::REQUEST_ENTITY_TOO_LARGE);
+
+										pos += take;
+										break;
+									}
+
+									headers = pending.Substring(2, end);
+									pos += end + 4 - matched;
+									pending.Clear();
+								}
+
+								HttpStatusCode const stat = ParseHeaders(headers, handler);
+								if(stat != HttpStatusCode::OK) return Fail(stat);
+
+								state = State::DATA;
+							}
+							break;
+						case State::DONE:
+							// Ignore epilogue
+							return HttpStatusCode::OK;
+						case State::FAILED:
+							return error;
+						}
+					}
+
+					return state == State::FAILED ? error : HttpStatusCode::OK;
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in MultipartFormDataParser::Feed", __FILE__, __LINE__);
+				}
+
+				return Fail(HttpStatusCode::INTERNAL_SERVER_ERROR);
+			}
+
+			HttpStatusCode MultipartFormDataParser::ParseHeaders(PeoplezString const & headers, PartHandler & handler)
+			{
+				PostParam part;
+				bool nameFound = false;
+				size_t lineStart = 0;
+
+				// For each header line (each ends with CRLF) ...
+				for(size_t lineEnd = headers.FindEndOfLine(); lineEnd != PeoplezString::NPOS; lineStart = lineEnd + 2, lineEnd = headers.FindEndOfLine(lineStart))
+				{
+					PeoplezString const line = headers.Substring(lineStart, lineEnd - lineStart);
+					size_t const colon = line.Find(':');
+
+					if(colon == PeoplezString::NPOS) return HttpStatusCode::BAD_REQUEST;
+
+					PeoplezString value = line.Substring(colon + 1);
+					value.TrimFast();
+
+					if(colon == 19 && !strncasecmp(line.GetData(), "Content-Disposition", 19))
+					{
+						std::vector<PeoplezString> params;
+						value.Split<true>(params, ';');
+
+						if(params.empty()) return HttpStatusCode::BAD_REQUEST;
+
+						params[0].TrimFast();
+						if(!params[0].EqualTo("form-data", 9) && !params[0].EqualTo("file", 4)) return HttpStatusCode::BAD_REQUEST;
+
+						for(size_t i = 1; i < params.size(); ++i)
+						{
+							params[i].TrimFast();
+
+							if(params[i].Length() >= 5 && !strncasecmp(params[i].GetData(), "name=", 5))
+							{
+								part.Name = ParameterValue(params[i], 5);
+								nameFound = true;
+							}
+							else if(params[i].Length() >= 9 && !strncasecmp(params[i].GetData(), "filename=", 9)) part.FileName = ParameterValue(params[i], 9);
+						}
+					}
+					else if(colon == 12 && !strncasecmp(line.GetData(), "Content-Type", 12))
+					{
+						size_t const semicolon = value.Find(';');
+						if(semicolon != PeoplezString::NPOS) value = value.Substring(0, semicolon);
+						value.TrimFast();
+
+						part.Mime = MimeOperations::StringToMimeType(value);
+						if(part.Mime == MimeType::NONE) return HttpStatusCode::UNSUPPORTED_MEDIA_TYPE;
+					}
+				}
+
+				if(!nameFound) return HttpStatusCode::BAD_REQUEST;
+
+				handler.PartBegin(part);
+
+				return HttpStatusCode::OK;
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_MULTIPARTFORMDATAPARSER_HPP_
+#define PEOPLEZ_SERVICES_HTTP_MULTIPARTFORMDATAPARSER_HPP_
+
+// Local includes
+#include "../../String/PeoplezString.hpp"
+#include "HttpResponse.hpp"
+#include "PostParam.hpp"
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Incremental parser for multipart/form-data bodies
+			 *
+			 * @details
+			 * The body can be fed at once or in arbitrary chunks (e.g. from a HttpBodyStreamHandler).
+			 * Part names and contents are emitted as views (substrings) of the fed chunks; only the few bytes
+			 * of a delimiter or part header that are split between two chunks are copied.
+			 */
+			class MultipartFormDataParser final
+			{
+			public:
+				/**
+				 * @brief Receives the parts found by the parser
+				 */
+				class PartHandler
+				{
+				public:
+					/**
+					 * Called when the headers of a part are parsed
+					 *
+					 * @param part Name, FileName and Mime of the part (Value is empty)
+					 */
+					virtual void PartBegin(PostParam const & part) = 0;
+					/**
+					 * Called for each piece of the content of the current part
+					 *
+					 * @param data Next piece of the content (view of the fed chunk)
+					 */
+					virtual void PartData(String::PeoplezString const & data) = 0;
+					/**
+					 * Called when the content of the current part is complete
+					 */
+					virtual void PartEnd() = 0;
+					virtual ~PartHandler() {}
+				};
+
+				/**
+				 * Constructor
+				 *
+				 * @param boundary Boundary parameter of the Content-Type header (may be quoted)
+				 */
+				MultipartFormDataParser(String::PeoplezString boundary);
+				/**
+				 * Parses the next chunk of the body
+				 *
+				 * @param chunk Next bytes of the body
+				 * @param handler Handler for the found parts
+				 *
+				 * @return OK or the error of the body (the parser stays in the error state)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				HttpStatusCode Feed(String::PeoplezString const & chunk, PartHandler & handler) noexcept;
+				/**
+				 * Checks whether the closing delimiter was parsed
+				 *
+				 * @return True if the body is complete
+				 */
+				inline bool IsComplete() const noexcept {return state == State::DONE;}
+
+			private:
+				enum class State : unsigned char
+				{
+					PREAMBLE,
+					DELIMITER_END,
+					HEADERS,
+					DATA,
+					DONE,
+					FAILED
+				};
+
+				HttpStatusCode Fail(HttpStatusCode status) noexcept;
+				size_t FindDelimiter(char const * data, size_t len) const noexcept __attribute__((pure));
+				HttpStatusCode ParseHeaders(String::PeoplezString const & headers, PartHandler & handler);
+
+				/**
+				 * @brief "\r\n--" followed by the boundary
+				 */
+				String::PeoplezString delimiter;
+				/**
+				 * @brief Start of a delimiter or part headers that was split between chunks
+				 */
+				String::PeoplezString pending;
+				State state;
+				HttpStatusCode error;
+				char delimiterEnd;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_MULTIPARTFORMDATAPARSER_HPP_
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "WebSocketBroadcast.hpp"
+
+// Extern includes
+#include <algorithm>
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace String;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			void WebSocketBroadcast::Add(std::shared_ptr<WebSocketConnection> const & connection)
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				connections.push_back(connection);
+			}
+
+			void WebSocketBroadcast::Remove(WebSocketConnection const * const connection) noexcept
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				// Ended connections are removed as well
+				connections.erase(std::remove_if(connections.begin(), connections.end(), [connection](std::weak_ptr<WebSocketConnection> const & entry)
+				{
+					std::shared_ptr<WebSocketConnection> const current = entry.lock();
+					return !current || current.get() == connection;
+				}), connections.end());
+			}
+
+			size_t WebSocketBroadcast::Send(PeoplezString const & message, WebSocketMessageType const type)
+			{
+				return Send(WebSocketConnection::Serialize(type, message));
+			}
+
+			size_t WebSocketBroadcast::Send(WebSocketConnection::Frame const & frame)
+			{
+				size_t reached = 0;
+
+				// Send without lock (connections may be added or removed meanwhile)
+				for(std::shared_ptr<WebSocketConnection> const & connection : Connections()) reached += connection->Send(frame);
+
+				return reached;
+			}
+
+			std::vector<std::shared_ptr<WebSocketConnection>> WebSocketBroadcast::Connections()
+			{
+				std::vector<std::shared_ptr<WebSocketConnection>> result;
+				std::unique_lock<std::mutex> const lock(mut);
+
+				result.reserve(connections.size());
+
+				for(size_t i = 0; i < connections.size();)
+				{
+					std::shared_ptr<WebSocketConnection> connection = connections[i].lock();
+
+					// Remove ended connections (order does not matter)
+					if(!connection)
+					{
+						connections[i] = std::move(connections.back());
+						connections.pop_back();
+						continue;
+					}
+
+					result.push_back(std::move(connection));
+					++i;
+				}
+
+				return result;
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_WEBSOCKETBROADCAST_HPP_
+#define PEOPLEZ_SERVICES_HTTP_WEBSOCKETBROADCAST_HPP_
+
+// Local includes
+#include "WebSocketConnection.hpp"
+
+// Extern includes
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Group of WebSocket connections that receive the same messages
+			 *
+			 * @details
+			 * A message is serialized into one frame that is queued on every connection of the group.
+			 * Connections are held weakly; ended connections drop out automatically. All methods are thread safe.
+			 */
+			class WebSocketBroadcast final
+			{
+			public:
+				/**
+				 * Adds a connection to the group
+				 *
+				 * @param connection Connection to add
+				 */
+				void Add(std::shared_ptr<WebSocketConnection> const & connection);
+				/**
+				 * Removes a connection from the group
+				 *
+				 * @param connection Connection to remove
+				 */
+				void Remove(WebSocketConnection const * connection) noexcept;
+				/**
+				 * Sends a message to all connections of the group
+				 *
+				 * @param message Payload of the message
+				 * @param type Type of the message
+				 *
+				 * @return Number of connections the message was queued on
+				 */
+				size_t Send(String::PeoplezString const & message, WebSocketMessageType type = WebSocketMessageType::TEXT);
+				/**
+				 * Sends a serialized frame to all connections of the group
+				 *
+				 * @param frame Frame created by WebSocketConnection::Serialize
+				 *
+				 * @return Number of connections the frame was queued on
+				 */
+				size_t Send(WebSocketConnection::Frame const & frame);
+				/**
+				 * Gets the connections of the group that still exist
+				 *
+				 * @return Snapshot of the connections
+				 */
+				std::vector<std::shared_ptr<WebSocketConnection>> Connections();
+
+			private:
+				std::mutex mut;
+				std::vector<std::weak_ptr<WebSocketConnection>> connections;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_WEBSOCKETBROADCAST_HPP_
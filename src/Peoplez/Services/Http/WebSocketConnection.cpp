@@ -0,0 +1,935 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "WebSocketConnection.hpp"
+
+// Local includes
+#include "../../System/Logging/Logger.hpp"
+#include "../../System/Timer.hpp"
+#include "HttpContext.hpp"
+#include "WebSocketBroadcast.hpp"
+
+// Extern includes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+#include <strings.h>
+extern "C"
+{
+#include <sys/uio.h>
+}
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @def WEBSOCKET_MAX_MESSAGE_SIZE
+ * @brief Maximum accepted size of a (reassembled) message in bytes; larger messages close the connection with 1009
+ */
+#ifndef WEBSOCKET_MAX_MESSAGE_SIZE
+#define WEBSOCKET_MAX_MESSAGE_SIZE 1048576
+#endif
+/**
+ * @def WEBSOCKET_SEND_BUFFER_SIZE
+ * @brief Number of queued bytes above which further messages are dropped until the client reads
+ */
+#ifndef WEBSOCKET_SEND_BUFFER_SIZE
+#define WEBSOCKET_SEND_BUFFER_SIZE 1048576
+#endif
+/**
+ * @def WEBSOCKET_PING_INTERVAL
+ * @brief Seconds between two pings
+ * @details Shorter than the connection timeout of the ConnectionsManager, so the pongs keep idle connections alive.
+ * A connection that received nothing during one interval is closed.
+ */
+#ifndef WEBSOCKET_PING_INTERVAL
+#define WEBSOCKET_PING_INTERVAL 4
+#endif
+/**
+ * @def WEBSOCKET_IOV_BATCH
+ * @brief Maximum number of queued frames that are written with one gather write
+ */
+#define WEBSOCKET_IOV_BATCH 64
+/**
+ * @def INPUT_BUFFER_STEP_SIZE
+ * @brief Size of the read buffer in bytes
+ */
+#define INPUT_BUFFER_STEP_SIZE 16384
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace String;
+	using namespace System::Logging;
+
+	namespace Services
+	{
+		namespace Http
+		{
+			/**
+			 * @brief Opcodes of the frames (RFC 6455 Section 5.2)
+			 */
+			enum : uint8_t
+			{
+				OPCODE_CONTINUATION = 0x0,
+				OPCODE_CLOSE = 0x8,
+				OPCODE_PING = 0x9,
+				OPCODE_PONG = 0xA
+			};
+
+			/**
+			 * @brief Status codes of close frames (RFC 6455 Section 7.4.1)
+			 */
+			enum : uint16_t
+			{
+				CLOSE_PROTOCOL_ERROR = 1002,
+				CLOSE_NO_STATUS = 1005,
+				CLOSE_ABNORMAL = 1006,
+				CLOSE_INVALID_DATA = 1007,
+				CLOSE_TOO_BIG = 1009
+			};
+
+			/**
+			 * @brief Appended to the key of the client for Sec-WebSocket-Accept (RFC 6455 Section 1.3)
+			 */
+			static char const HANDSHAKE_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+			/**
+			 * Removes the masking of a payload in place
+			 *
+			 * Works on 16 (SSE2) or 8 bytes at once; the key repeats every 4 bytes, so it is simply replicated.
+			 *
+			 * @param data Masked payload of a frame
+			 * @param len Length of the payload
+			 * @param key Masking key in the byte order of the frame
+			 */
+			static void Unmask(char * const data, size_t const len, uint32_t const key) noexcept
+			{
+				size_t i = 0;
+
+#ifdef __SSE2__
+				__m128i const key128 = _mm_set1_epi32((int)key);
+
+				for(; i + 16 <= len; i += 16) _mm_storeu_si128((__m128i *)(data + i), _mm_xor_si128(_mm_loadu_si128((__m128i const *)(data + i)), key128));
+#endif
+
+				uint64_t const key64 = ((uint64_t)key << 32) | key;
+
+				for(; i + 8 <= len; i += 8)
+				{
+					uint64_t block;
+					memcpy(&block, data + i, 8);
+					block ^= key64;
+					memcpy(data + i, &block, 8);
+				}
+
+				// Rest (i is a multiple of 4 here)
+				unsigned char keyBytes[4];
+				memcpy(keyBytes, &key, 4);
+
+				for(; i < len; ++i) data[i] ^= keyBytes[i & 3];
+			}
+
+			/**
+			 * Appends the unmasked payload of a frame
+			 *
+			 * @param dest Target (message or control payload)
+			 * @param src Masked payload
+			 * @param len Length of the payload
+			 * @param key Masking key in the byte order of the frame
+			 */
+			static void AppendUnmasked(PeoplezString & dest, char const * const src, size_t const len, uint32_t const key)
+			{
+				if(!len) return;
+
+				size_t const offset = dest.Length();
+
+				dest.Append(src, len);
+				Unmask(&dest[offset], len, key);
+			}
+
+			/**
+			 * Validates UTF-8 (no overlong forms, no surrogates, at most U+10FFFF)
+			 *
+			 * ASCII is skipped 8 bytes at once.
+			 *
+			 * @param str Text to check
+			 * @param len Length of the text
+			 *
+			 * @return Indicates whether the text is valid UTF-8
+			 */
+			static bool IsValidUtf8(unsigned char const * const str, size_t const len) noexcept
+			{
+				size_t i = 0;
+
+				while(i < len)
+				{
+					if(i + 8 <= len)
+					{
+						uint64_t block;
+						memcpy(&block, str + i, 8);
+
+						if(!(block & 0x8080808080808080ULL))
+						{
+							i += 8;
+							continue;
+						}
+					}
+
+					unsigned char const c = str[i];
+
+					if(c < 0x80)
+					{
+						++i;
+						continue;
+					}
+
+					size_t following;
+					uint32_t codePoint;
+
+					if(c >= 0xC2 && c <= 0xDF)
+					{
+						following = 1;
+						codePoint = c & 0x1F;
+					}
+					else if((c & 0xF0) == 0xE0)
+					{
+						following = 2;
+						codePoint = c & 0x0F;
+					}
+					else if(c >= 0xF0 && c <= 0xF4)
+					{
+						following = 3;
+						codePoint = c & 0x07;
+					}
+					else return false;
+
+					if(len - i <= following) return false;
+
+					for(size_t k = 1; k <= following; ++k)
+					{
+						if((str[i + k] & 0xC0) != 0x80) return false;
+						codePoint = (codePoint << 6) | (str[i + k] & 0x3F);
+					}
+
+					if((following == 2 && codePoint < 0x800) || (following == 3 && (codePoint < 0x10000 || codePoint > 0x10FFFF)) || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) return false;
+
+					i += following + 1;
+				}
+
+				return true;
+			}
+
+			/**
+			 * Checks whether a status code may be sent by the client in a close frame (RFC 6455 Section 7.4)
+			 */
+			static bool IsValidCloseCode(uint16_t const code) noexcept
+			{
+				return (code >= 1000 && code <= 1003) || (code >= 1007 && code <= 1011) || (code >= 3000 && code <= 4999);
+			}
+
+			/**
+			 * Serializes an unmasked frame with FIN set
+			 *
+			 * @param opcode Opcode of the frame
+			 * @param payload Payload
+			 * @param len Length of the payload
+			 *
+			 * @return Serialized frame
+			 */
+			static WebSocketConnection::Frame MakeFrame(uint8_t const opcode, char const * const payload, size_t const len)
+			{
+				char header[10];
+				size_t headerLength = 2;
+
+				header[0] = (char)(0x80 | opcode);
+
+				if(len < 126) header[1] = (char)len;
+				else if(len <= 0xFFFF)
+				{
+					header[1] = 126;
+					header[2] = (char)(len >> 8);
+					header[3] = (char)len;
+					headerLength = 4;
+				}
+				else
+				{
+					header[1] = 127;
+					for(int i = 0; i < 8; ++i) header[2 + i] = (char)((uint64_t)len >> (56 - 8 * i));
+					headerLength = 10;
+				}
+
+				PeoplezString frame(headerLength + len);
+				frame.Append(header, headerLength);
+				if(len) frame.Append(payload, len);
+
+				return std::make_shared<PeoplezString const>(std::move(frame));
+			}
+
+			WebSocketConnection::WebSocketConnection(std::shared_ptr<WebSocketHandler> _handler, System::IO::Network::Socket * const _sender)
+				: handler(_handler ? std::move(_handler) : throw std::invalid_argument("Invalid handler")), sender(_sender ? _sender : throw std::invalid_argument("Invalid socket")), mut(), input(), message(),
+				  messageType(WebSocketMessageType::TEXT), received(), outputQueue(), outputOffset(0), queuedBytes(0), closeCode(CLOSE_ABNORMAL), inMessage(false), ownsSender(false), closeSent(false),
+				  closeReceived(false), closing(false), closedPending(false), closedNotified(false), delivering(false), alive(true)
+			{
+			}
+
+			bool WebSocketConnection::IsUpgradeRequest(HttpRequest const & request)
+			{
+				if(request.HttpMethod() != HttpMethods::GET || !request.IsConnectionUpgrade()) return false;
+
+				PeoplezString upgrade = request.GetHeaderValue(HttpHeaderField::UPGRADE);
+				upgrade.Trim();
+
+				if(upgrade.Length() != 9 || strncasecmp(upgrade.GetData(), "websocket", 9)) return false;
+
+				// Base64 coded 16 byte nonce
+				PeoplezString key = request.GetHeaderValue(HttpHeaderField::SEC_WEBSOCKET_KEY);
+				key.Trim();
+
+				return key.Length() == 24;
+			}
+
+			WebSocketConnection::Frame WebSocketConnection::Serialize(WebSocketMessageType const type, PeoplezString const & msg)
+			{
+				return MakeFrame((uint8_t)type, msg.GetData(), msg.Length());
+			}
+
+			bool WebSocketConnection::Upgrade(HttpContext & base, PeoplezString const & protocol) noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> lock(mut);
+
+					// Sec-WebSocket-Accept: base64(SHA-1(key + GUID))
+					char accept[32];
+					{
+						PeoplezString key = base.request.GetHeaderValue(HttpHeaderField::SEC_WEBSOCKET_KEY);
+						key.Trim();
+
+						PeoplezString source(key.Length() + sizeof(HANDSHAKE_GUID) - 1);
+						source.Append(key);
+						source.Append(HANDSHAKE_GUID, sizeof(HANDSHAKE_GUID) - 1);
+
+						unsigned char digest[SHA_DIGEST_LENGTH];
+						SHA1((unsigned char const *) source.GetData(), source.Length(), digest);
+						EVP_EncodeBlock((unsigned char *) accept, digest, SHA_DIGEST_LENGTH);
+					}
+
+					// Responses to requests before the upgrade request are sent first (own copies: frames are shared between threads)
+					for(PeoplezString const & response : base.OutputQueue) QueueFrame(std::make_shared<PeoplezString const>(response.UniqueCopy()));
+					base.OutputQueue.clear();
+
+					{
+						PeoplezString switching(160 + protocol.Length());
+
+						switching.Append("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: ", 97);
+						switching.Append(accept, 28);
+						switching.Append("\r\n", 2);
+
+						if(!protocol.IsEmpty())
+						{
+							switching.Append("Sec-WebSocket-Protocol: ", 24);
+							switching.Append(protocol);
+							switching.Append("\r\n", 2);
+						}
+
+						switching.Append("\r\n", 2);
+						QueueFrame(std::make_shared<PeoplezString const>(std::move(switching)));
+					}
+
+					// Frames may follow the handshake directly
+					input = base.InputBuffer.UniqueCopy();
+					base.InputBuffer.Clear();
+
+					ProcessInput();
+					ReceiveInner();
+					Flush();
+
+					// Nothing below throws: the socket belongs to this connection from now on
+					ownsSender = true;
+
+					// Messages are delivered after Opened
+					delivering = true;
+					lock.unlock();
+
+					std::shared_ptr<WebSocketConnection> const self = shared_from_this();
+
+					try
+					{
+						handler->Opened(self);
+					}
+					catch(...)
+					{
+						Logger::LogException("Error in WebSocketHandler::Opened", __FILE__, __LINE__);
+					}
+
+					try
+					{
+						AddHeartbeat(self);
+					}
+					catch(...)
+					{
+						Logger::LogException("Error while registering websocket heartbeat", __FILE__, __LINE__);
+					}
+
+					lock.lock();
+					delivering = false;
+					Deliver(lock);
+
+					return true;
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in WebSocketConnection::Upgrade", __FILE__, __LINE__);
+				}
+
+				return false;
+			}
+
+			void WebSocketConnection::MessageReceivable() noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> lock(mut);
+
+					ReceiveInner();
+					Flush();
+					Deliver(lock);
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in WebSocketConnection::MessageReceivable", __FILE__, __LINE__);
+				}
+			}
+
+			void WebSocketConnection::MessageSendable() noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> const lock(mut);
+					Flush();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in WebSocketConnection::MessageSendable", __FILE__, __LINE__);
+				}
+			}
+
+			bool WebSocketConnection::Send(PeoplezString const & msg, WebSocketMessageType const type)
+			{
+				return Send(Serialize(type, msg));
+			}
+
+			bool WebSocketConnection::Send(Frame const & frame)
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				// Slow clients lose messages instead of growing the queue without limit
+				if(closeSent || closing || !sender->IsOpen() || queuedBytes >= WEBSOCKET_SEND_BUFFER_SIZE) return false;
+
+				QueueFrame(frame);
+				Flush();
+
+				return true;
+			}
+
+			void WebSocketConnection::Close(uint16_t const code, PeoplezString const & reason) noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> const lock(mut);
+
+					if(closeSent || closing) return;
+
+					QueueClose(code, reason.GetData(), std::min<size_t>(reason.Length(), 123));
+
+					// If the client started closing already ... the handshake is complete
+					if(closeReceived) closing = true;
+
+					Flush();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in WebSocketConnection::Close", __FILE__, __LINE__);
+				}
+			}
+
+			bool WebSocketConnection::IsOpen() noexcept
+			{
+				std::unique_lock<std::mutex> const lock(mut);
+
+				return !closeSent && !closing && sender->IsOpen();
+			}
+
+			WebSocketConnection::~WebSocketConnection()
+			{
+				if(ownsSender) delete sender;
+			}
+
+			void WebSocketConnection::ProcessInput()
+			{
+				unsigned char const * const data = (unsigned char const *) input.GetData();
+				size_t const length = input.Length();
+				size_t pos = 0;
+
+				// While a frame header is received ...
+				while(!closing && length - pos >= 2)
+				{
+					uint8_t const first = data[pos];
+					uint8_t const second = data[pos + 1];
+					bool const fin = first & 0x80;
+					uint8_t const opcode = first & 0x0F;
+					uint64_t payloadLength = second & 0x7F;
+					size_t headerLength = 2;
+
+					// No extensions are negotiated (RSV bits) and clients have to mask their frames
+					if((first & 0x70) || !(second & 0x80))
+					{
+						Fail(CLOSE_PROTOCOL_ERROR);
+						break;
+					}
+
+					if(payloadLength == 126)
+					{
+						if(length - pos < 4) break;
+
+						payloadLength = ((uint64_t)data[pos + 2] << 8) | data[pos + 3];
+						headerLength = 4;
+					}
+					else if(payloadLength == 127)
+					{
+						if(length - pos < 10) break;
+
+						payloadLength = 0;
+						for(size_t i = 2; i < 10; ++i) payloadLength = (payloadLength << 8) | data[pos + i];
+						headerLength = 10;
+					}
+
+					// Masking key
+					headerLength += 4;
+
+					// Control frames are short and not fragmented; data frames have to fit into the message limit (checked before the payload is buffered)
+					if(opcode & 0x08)
+					{
+						if(!fin || payloadLength > 125 || (opcode != OPCODE_CLOSE && opcode != OPCODE_PING && opcode != OPCODE_PONG))
+						{
+							Fail(CLOSE_PROTOCOL_ERROR);
+							break;
+						}
+					}
+					else if(opcode > (uint8_t)WebSocketMessageType::BINARY || (opcode == OPCODE_CONTINUATION) != inMessage)
+					{
+						Fail(CLOSE_PROTOCOL_ERROR);
+						break;
+					}
+					else if(payloadLength > WEBSOCKET_MAX_MESSAGE_SIZE - (inMessage ? message.Length() : 0))
+					{
+						Fail(CLOSE_TOO_BIG);
+						break;
+					}
+
+					// If the frame is not complete ... wait for the rest
+					if(length - pos < headerLength + payloadLength) break;
+
+					char const * const payload = (char const *) data + pos + headerLength;
+					uint32_t key;
+					memcpy(&key, payload - 4, 4);
+
+					pos += headerLength + payloadLength;
+
+					if(opcode & 0x08)
+					{
+						PeoplezString control;
+						AppendUnmasked(control, payload, payloadLength, key);
+						HandleControl(opcode, control);
+						continue;
+					}
+
+					// First frame of a message
+					if(opcode != OPCODE_CONTINUATION)
+					{
+						messageType = (WebSocketMessageType)opcode;
+						inMessage = true;
+					}
+
+					AppendUnmasked(message, payload, payloadLength, key);
+
+					if(fin)
+					{
+						if(messageType == WebSocketMessageType::TEXT && !IsValidUtf8((unsigned char const *) message.GetData(), message.Length()))
+						{
+							Fail(CLOSE_INVALID_DATA);
+							break;
+						}
+
+						received.emplace_back(messageType, message);
+						message = PeoplezString();
+						inMessage = false;
+					}
+				}
+
+				// Remove parsed frames
+				if(closing || pos >= length) input.Clear();
+				else if(pos) input <<= pos;
+			}
+
+			void WebSocketConnection::HandleControl(uint8_t const opcode, PeoplezString const & payload)
+			{
+				switch(opcode)
+				{
+				case OPCODE_CLOSE:
+				{
+					uint16_t code = CLOSE_NO_STATUS;
+
+					if(payload.Length() == 1)
+					{
+						Fail(CLOSE_PROTOCOL_ERROR);
+						return;
+					}
+
+					if(payload.Length() >= 2)
+					{
+						code = (uint16_t)(((unsigned char)payload[0] << 8) | (unsigned char)payload[1]);
+
+						if(!IsValidCloseCode(code))
+						{
+							Fail(CLOSE_PROTOCOL_ERROR);
+							return;
+						}
+
+						if(!IsValidUtf8((unsigned char const *) payload.GetData() + 2, payload.Length() - 2))
+						{
+							Fail(CLOSE_INVALID_DATA);
+							return;
+						}
+					}
+
+					// Answer with the same status code (RFC 6455 Section 5.5.1)
+					if(code == CLOSE_NO_STATUS) QueueClose(0, nullptr, 0);
+					else QueueClose(code, nullptr, 0);
+
+					closeReceived = true;
+					closing = true;
+					closeCode = code;
+					closedPending = true;
+					break;
+				}
+				case OPCODE_PING:
+					if(!closeSent) QueueFrame(MakeFrame(OPCODE_PONG, payload.GetData(), payload.Length()));
+					break;
+				default:
+					// Pong: answer to Heartbeat (any received data counts)
+					break;
+				}
+			}
+
+			void WebSocketConnection::Fail(uint16_t const code)
+			{
+				Logger::LogEvent("WebSocket connection failed");
+
+				QueueClose(code, nullptr, 0);
+
+				closing = true;
+				closeCode = code;
+				closedPending = true;
+			}
+
+			void WebSocketConnection::QueueClose(uint16_t const code, char const * const reason, size_t const len)
+			{
+				if(closeSent) return;
+
+				char payload[125];
+				size_t size = 0;
+
+				// Code 0: close frame without status code
+				if(code)
+				{
+					payload[0] = (char)(code >> 8);
+					payload[1] = (char)code;
+					size = 2;
+
+					if(len)
+					{
+						memcpy(payload + 2, reason, std::min<size_t>(len, 123));
+						size += std::min<size_t>(len, 123);
+					}
+				}
+
+				QueueFrame(MakeFrame(OPCODE_CLOSE, payload, size));
+				closeSent = true;
+			}
+
+			void WebSocketConnection::QueueFrame(Frame const & frame)
+			{
+				outputQueue.push_back(frame);
+				queuedBytes += frame->Length();
+			}
+
+			void WebSocketConnection::ReceiveInner()
+			{
+				// Reserve memory for receiving
+				char buf[INPUT_BUFFER_STEP_SIZE];
+
+				while(sender->IsOpen() && !closing)
+				{
+					int const bytes = sender->Recv(buf, INPUT_BUFFER_STEP_SIZE);
+
+					if(bytes > 0)
+					{
+						alive = true;
+						input.Append(buf, bytes);
+						ProcessInput();
+					}
+					else
+					{
+						// If the client closed the connection without closing handshake ...
+						// Else log error (if not EAGAIN)
+						if(!bytes)
+						{
+							closing = true;
+
+							if(!closedPending && !closedNotified)
+							{
+								closeCode = CLOSE_ABNORMAL;
+								closedPending = true;
+							}
+						}
+						else if(errno != EAGAIN)
+						{
+							Logger::LogException("Error while reading websocket frames", __FILE__, __LINE__);
+							Logger::LogException(strerror(errno), __FILE__, __LINE__);
+						}
+
+						break;
+					}
+				}
+			}
+
+			bool WebSocketConnection::SendInner()
+			{
+				// If the socket is closed already ... nothing can be sent anymore
+				if(!sender->IsOpen())
+				{
+					outputQueue.clear();
+					outputOffset = queuedBytes = 0;
+					return false;
+				}
+
+				while(!outputQueue.empty())
+				{
+					// Collect queued frames
+					iovec iov[WEBSOCKET_IOV_BATCH];
+					size_t const count = std::min<size_t>(outputQueue.size(), WEBSOCKET_IOV_BATCH);
+
+					for(size_t i = 0; i < count; ++i)
+					{
+						iov[i].iov_base = (void *) outputQueue[i]->GetData();
+						iov[i].iov_len = outputQueue[i]->Length();
+					}
+
+					// First frame may be sent partially already
+					iov[0].iov_base = (char *) iov[0].iov_base + outputOffset;
+					iov[0].iov_len -= outputOffset;
+
+					// Send them at once
+					int const sent = sender->SendV(iov, (int)count);
+
+					// If an error occured while sending ...
+					//   Log an error (if not EAGAIN)
+					if(__builtin_expect(sent < 0, false))
+					{
+						if(errno != EAGAIN) Logger::LogEvent("Error while writing");
+						return false;
+					}
+
+					// Remove completely sent frames and remember the sent part of the next one
+					size_t remaining = sent;
+					size_t done = 0;
+
+					queuedBytes -= sent;
+
+					for(; done < count && remaining >= iov[done].iov_len; ++done) remaining -= iov[done].iov_len;
+
+					outputOffset = (done ? 0 : outputOffset) + remaining;
+					outputQueue.erase(outputQueue.begin(), outputQueue.begin() + done);
+
+					// If not everything could be sent ... wait for MessageSendable
+					if(done < count) return false;
+				}
+
+				return true;
+			}
+
+			void WebSocketConnection::Flush()
+			{
+				// Close the socket after the last frame is sent
+				if(SendInner() && closing && sender->IsOpen()) sender->Close();
+			}
+
+			void WebSocketConnection::Deliver(std::unique_lock<std::mutex> & lock) noexcept
+			{
+				// The delivering thread also takes over the events that arrive meanwhile
+				if(delivering) return;
+
+				try
+				{
+					std::shared_ptr<WebSocketConnection> const self = shared_from_this();
+
+					delivering = true;
+
+					while(!received.empty() || (closedPending && !closedNotified))
+					{
+						std::vector<std::pair<WebSocketMessageType, PeoplezString>> batch;
+						batch.swap(received);
+
+						bool const notifyClosed = closedPending && !closedNotified;
+						uint16_t const code = closeCode;
+
+						if(notifyClosed) closedNotified = true;
+
+						lock.unlock();
+
+						for(std::pair<WebSocketMessageType, PeoplezString> const & msg : batch)
+						{
+							try
+							{
+								handler->MessageReceived(self, msg.first, msg.second);
+							}
+							catch(...)
+							{
+								Logger::LogException("Error in WebSocketHandler::MessageReceived", __FILE__, __LINE__);
+							}
+						}
+
+						// Payloads are released before the lock is taken again
+						batch.clear();
+
+						if(notifyClosed) handler->Closed(self, code);
+
+						lock.lock();
+					}
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in WebSocketConnection::Deliver", __FILE__, __LINE__);
+
+					if(!lock.owns_lock()) lock.lock();
+				}
+
+				delivering = false;
+			}
+
+			void WebSocketConnection::Heartbeat(Frame const & ping) noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> lock(mut);
+
+					if(closing || !sender->IsOpen()) return;
+
+					// If nothing was received during the last interval (not even the answer to a close frame) ... the client is gone
+					if(!alive)
+					{
+						closing = true;
+						closeCode = CLOSE_ABNORMAL;
+						closedPending = true;
+
+						sender->Close();
+					}
+					else
+					{
+						alive = false;
+
+						if(!closeSent)
+						{
+							QueueFrame(ping);
+							Flush();
+						}
+					}
+
+					Deliver(lock);
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in WebSocketConnection::Heartbeat", __FILE__, __LINE__);
+				}
+			}
+
+			void WebSocketConnection::Disconnected() noexcept
+			{
+				try
+				{
+					std::unique_lock<std::mutex> lock(mut);
+
+					closing = true;
+
+					if(!closedPending && !closedNotified)
+					{
+						closeCode = CLOSE_ABNORMAL;
+						closedPending = true;
+					}
+
+					if(sender->IsOpen()) sender->Close();
+
+					outputQueue.clear();
+					outputOffset = queuedBytes = 0;
+
+					Deliver(lock);
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in WebSocketConnection::Disconnected", __FILE__, __LINE__);
+				}
+			}
+
+			void WebSocketConnection::AddHeartbeat(std::shared_ptr<WebSocketConnection> const & connection)
+			{
+				// Never deleted: the timer thread may still run while static objects are destroyed
+				static WebSocketBroadcast * const group = new WebSocketBroadcast();
+				[[maybe_unused]] static System::Timer * const timer = new System::Timer([]()
+				{
+					Frame const ping = MakeFrame(OPCODE_PING, nullptr, 0);
+
+					for(std::shared_ptr<WebSocketConnection> const & current : group->Connections()) current->Heartbeat(ping);
+				}, std::chrono::seconds(WEBSOCKET_PING_INTERVAL));
+
+				group->Add(connection);
+			}
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
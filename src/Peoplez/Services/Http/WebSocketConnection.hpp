@@ -0,0 +1,307 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_WEBSOCKETCONNECTION_HPP_
+#define PEOPLEZ_SERVICES_HTTP_WEBSOCKETCONNECTION_HPP_
+
+// Local includes
+#include "../../String/PeoplezString.hpp"
+#include "../../System/IO/Network/Socket.hpp"
+#include "WebSocketHandler.hpp"
+
+// Extern includes
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			class HttpContext;
+			class HttpRequest;
+
+			/**
+			 * @brief WebSocket connection (RFC 6455) that took over the socket of an http/1.1 connection after the handshake
+			 *
+			 * @details
+			 * Created by HttpClientInfo for requests accepted with HttpContext::AcceptWebSocket; the HttpClientInfo passes
+			 * its socket events on afterwards (like for HTTP/2). Fragmented messages are reassembled, pings are answered and
+			 * all connections are pinged regularly, so idle connections stay alive and dead ones are closed.
+			 * Messages can be sent from any thread. Frames are immutable and shared, so a broadcast serializes a frame once
+			 * and queues the same buffer on every connection (see WebSocketBroadcast).
+			 */
+			class WebSocketConnection final : public std::enable_shared_from_this<WebSocketConnection>
+			{
+				friend class HttpContext;
+			public:
+				/**
+				 * @brief Serialized frame that can be queued on several connections
+				 */
+				using Frame = std::shared_ptr<String::PeoplezString const>;
+
+				/**
+				 * Constructor
+				 *
+				 * @param handler Receiver of the messages
+				 * @param sender Socket of the connection (owned by the connection after a successful Upgrade)
+				 */
+				WebSocketConnection(std::shared_ptr<WebSocketHandler> handler, System::IO::Network::Socket * sender);
+				/**
+				 * Checks the handshake headers of a request (GET, "Upgrade: websocket", "Connection: upgrade" and a valid key)
+				 *
+				 * @param request Request to check
+				 *
+				 * @return Indicates whether the request opens a WebSocket connection (the version is checked separately)
+				 */
+				static bool IsUpgradeRequest(HttpRequest const & request);
+				/**
+				 * Serializes a message into a single (unmasked) frame
+				 *
+				 * @param type Type of the message
+				 * @param message Payload of the message
+				 *
+				 * @return Frame for Send(Frame const &)
+				 */
+				static Frame Serialize(WebSocketMessageType type, String::PeoplezString const & message);
+				/**
+				 * Takes over an http/1.1 connection whose request was accepted with HttpContext::AcceptWebSocket
+				 *
+				 * The pending responses of the connection and "101 Switching Protocols" are queued; frames that were
+				 * received already are processed. Calls WebSocketHandler::Opened.
+				 *
+				 * @param base Context of the http/1.1 connection (context has to be locked)
+				 * @param protocol Selected subprotocol; empty for none
+				 *
+				 * @return false if the connection could not be taken over (nothing is changed then)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				bool Upgrade(HttpContext & base, String::PeoplezString const & protocol) noexcept;
+				/**
+				 * Reads from the socket until it would block and processes the received frames
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void MessageReceivable() noexcept;
+				/**
+				 * Continues sending after the socket became writable
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void MessageSendable() noexcept;
+				/**
+				 * Sends a message (from any thread)
+				 *
+				 * @param message Payload of the message (text messages have to be UTF-8)
+				 * @param type Type of the message
+				 *
+				 * @return false if the connection is closing or the client does not read fast enough (the message is dropped)
+				 */
+				bool Send(String::PeoplezString const & message, WebSocketMessageType type = WebSocketMessageType::TEXT);
+				/**
+				 * Sends a serialized frame (from any thread)
+				 *
+				 * @param frame Frame created by Serialize
+				 *
+				 * @return false if the connection is closing or the client does not read fast enough (the frame is dropped)
+				 */
+				bool Send(Frame const & frame);
+				/**
+				 * Starts the closing handshake (from any thread)
+				 *
+				 * The socket is closed when the client answers the close frame (or after the next ping interval).
+				 *
+				 * @param code Status code (1000: normal closure)
+				 * @param reason Short reason (at most 123 bytes UTF-8)
+				 *
+				 * @par Exception safety
+				 *  No-throw guarantee
+				 */
+				void Close(uint16_t code = 1000, String::PeoplezString const & reason = String::PeoplezString()) noexcept;
+				/**
+				 * Indicates whether messages can be sent (the closing handshake did not start yet)
+				 */
+				bool IsOpen() noexcept;
+				/**
+				 * Destructor
+				 */
+				~WebSocketConnection();
+
+			private:
+				WebSocketConnection(WebSocketConnection const & other) = delete;
+				WebSocketConnection & operator=(WebSocketConnection const & other) = delete;
+
+				/**
+				 * Parses the complete frames of the input
+				 *
+				 * Connection has to be locked
+				 */
+				void ProcessInput();
+				/**
+				 * Handles a control frame (close, ping or pong)
+				 *
+				 * Connection has to be locked
+				 *
+				 * @param opcode Opcode of the frame
+				 * @param payload Unmasked payload
+				 */
+				void HandleControl(uint8_t opcode, String::PeoplezString const & payload);
+				/**
+				 * Fails the connection: queues a close frame and closes the socket after it is sent
+				 *
+				 * Connection has to be locked
+				 *
+				 * @param code Status code of the close frame
+				 */
+				void Fail(uint16_t code);
+				/**
+				 * Queues a close frame (once)
+				 *
+				 * Connection has to be locked
+				 */
+				void QueueClose(uint16_t code, char const * reason, size_t len);
+				/**
+				 * Appends a frame to the output queue
+				 *
+				 * Connection has to be locked
+				 */
+				void QueueFrame(Frame const & frame);
+				/**
+				 * Reads from the socket until it would block
+				 *
+				 * Connection has to be locked
+				 */
+				void ReceiveInner();
+				/**
+				 * Writes as much of the output queue as possible with a single gather write
+				 *
+				 * Connection has to be locked
+				 *
+				 * @return Indicates whether the output queue is empty now
+				 */
+				bool SendInner();
+				/**
+				 * Sends the output queue and closes the socket afterwards if the connection ends
+				 *
+				 * Connection has to be locked
+				 */
+				void Flush();
+				/**
+				 * Passes received messages and the end of the connection to the handler (without lock)
+				 *
+				 * Only one thread delivers at a time, so the handler gets the events in order.
+				 *
+				 * @param lock Lock of the connection (locked before and after)
+				 */
+				void Deliver(std::unique_lock<std::mutex> & lock) noexcept;
+				/**
+				 * Pings the client; closes the connection if nothing was received since the last ping
+				 *
+				 * @param ping Serialized ping frame
+				 */
+				void Heartbeat(Frame const & ping) noexcept;
+				/**
+				 * Ends the connection after its http connection was removed (called by the destructor of HttpContext)
+				 */
+				void Disconnected() noexcept;
+				/**
+				 * Registers a connection for the regular pings (starts the ping timer on first use)
+				 */
+				static void AddHeartbeat(std::shared_ptr<WebSocketConnection> const & connection);
+
+				std::shared_ptr<WebSocketHandler> const handler;
+				System::IO::Network::Socket * const sender;
+				std::mutex mut;
+				/**
+				 * @brief Received data that is not parsed yet
+				 */
+				String::PeoplezString input;
+				/**
+				 * @brief Payload of the fragmented message that is received at the moment
+				 */
+				String::PeoplezString message;
+				WebSocketMessageType messageType;
+				/**
+				 * @brief Complete messages that are not passed to the handler yet
+				 */
+				std::vector<std::pair<WebSocketMessageType, String::PeoplezString>> received;
+				std::vector<Frame> outputQueue;
+				/**
+				 * @brief Number of bytes of the first queued frame that are sent already
+				 */
+				size_t outputOffset;
+				size_t queuedBytes;
+				/**
+				 * @brief Status code for WebSocketHandler::Closed
+				 */
+				uint16_t closeCode;
+				/**
+				 * @brief Indicates that a fragmented message is received at the moment
+				 */
+				bool inMessage;
+				bool ownsSender;
+				bool closeSent;
+				bool closeReceived;
+				/**
+				 * @brief Indicates that the socket is closed as soon as the output queue is sent
+				 */
+				bool closing;
+				/**
+				 * @brief Indicates that the handler has to be told about the end of the connection
+				 */
+				bool closedPending;
+				bool closedNotified;
+				/**
+				 * @brief Indicates that a thread passes events to the handler at the moment
+				 */
+				bool delivering;
+				/**
+				 * @brief Indicates that data was received since the last ping
+				 */
+				bool alive;
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_WEBSOCKETCONNECTION_HPP_
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SERVICES_HTTP_WEBSOCKETHANDLER_HPP_
+#define PEOPLEZ_SERVICES_HTTP_WEBSOCKETHANDLER_HPP_
+
+// Local includes
+#include "../../String/PeoplezString.hpp"
+
+// Extern includes
+#include <cstdint>
+#include <memory>
+
+namespace Peoplez
+{
+	namespace Services
+	{
+		namespace Http
+		{
+			class WebSocketConnection;
+
+			/**
+			 * @brief Type of a WebSocket message (opcode of its first frame)
+			 */
+			enum class WebSocketMessageType : unsigned char
+			{
+				TEXT = 0x1,
+				BINARY = 0x2
+			};
+
+			/**
+			 * @brief Receiver of the events of WebSocket connections
+			 *
+			 * @details
+			 * Set with HttpContext::AcceptWebSocket. The callbacks of one connection are called one after another,
+			 * never while the connection is locked: they may send on the connection (and on others) directly.
+			 */
+			class WebSocketHandler
+			{
+			public:
+				/**
+				 * Called after the handshake (before the first message)
+				 *
+				 * @param connection The new connection (e.g. to add it to a WebSocketBroadcast)
+				 */
+				virtual void Opened(std::shared_ptr<WebSocketConnection> const & connection) {}
+				/**
+				 * Called for every complete (reassembled) message
+				 *
+				 * @param connection Connection that received the message
+				 * @param type Type of the message (text messages are valid UTF-8)
+				 * @param message Payload of the message
+				 */
+				virtual void MessageReceived(std::shared_ptr<WebSocketConnection> const & connection, WebSocketMessageType type, String::PeoplezString const & message) = 0;
+				/**
+				 * Called once when the connection ends
+				 *
+				 * @param connection Connection that is closed
+				 * @param code Status code of the close frame; 1006 if the connection was lost without one
+				 */
+				virtual void Closed(std::shared_ptr<WebSocketConnection> const & connection, uint16_t code) noexcept {}
+				virtual ~WebSocketHandler() {}
+			};
+		} // namespace Http
+	} // namespace Services
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SERVICES_HTTP_WEBSOCKETHANDLER_HPP_
@@ -47,6 +47,9 @@
 #include <cstring>
 #include <ostream>
 #include <zlib.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 //typedef unsigned char v8uc __attribute__((vector_size(8)));
 //typedef char v8sc __attribute__((vector_size(8)));
@@ -291,12 +294,12 @@ namespace Peoplez
 		{
 			size_t const len = Length();
 
-			if(len > 3) [[likely]]
+			if(len > 3 && startPos < len - 3) [[likely]]
 			{
 				size_t const sLen = len - 3; //Search length
 				char const *const end = data + sLen;
 
-				for(char const *pos = (char const *) memchr(data + startPos, '\r', sLen); pos; pos = (char const *) memchr(pos + 1, '\r', end - pos))
+				for(char const *pos = (char const *) memchr(data + startPos, '\r', sLen - startPos); pos; pos = (char const *) memchr(pos + 1, '\r', end - pos - 1))
 				{
 					if(pos[1] == '\n' && pos[2] == '\r' && pos[3] == '\n') return pos - data;
 				}
@@ -384,9 +387,30 @@ namespace Peoplez
 
 		bool PeoplezString::IsUrlEncoded() const noexcept
 		{
-			unsigned char const *end = (unsigned char *) data + dataLen - 1;
+			char const * pos = data;
+			char const * const end = data + dataLen;
 
-			for(unsigned char const *start = (unsigned char *) data; start < end; ++start) if(*start != '%' && (*start < '0' || (*start > '9' && *start < 'A') || (*start > 'Z' && *start < 'a') || *start > 'z')) return false;
+			// Of the characters to encode only '%' and '+' may occur
+			while((pos = FindUrlUnsafe(pos, end)) < end)
+			{
+				if(*pos != '%' && *pos != '+') return false;
+				++pos;
+			}
+
+			return true;
+		}
+
+		bool PeoplezString::IsUrlDecodable() const noexcept
+		{
+			unsigned char const * pos = (unsigned char const *) data;
+			unsigned char const * const end = pos + Length();
+
+			// Check every escape sequence
+			while((pos = (unsigned char const *) memchr(pos, '%', end - pos)))
+			{
+				if(end - pos < 3 || !HEX2DEC[pos[1]] || !HEX2DEC[pos[2]]) return false;
+				pos += 3;
+			}
 
 			return true;
 		}
@@ -470,11 +494,15 @@ namespace Peoplez
 			}
 		}
 
-		template<>
-		void PeoplezString::Split<true>(std::vector<PeoplezString> & result, char const token) const
+		/**
+		 * Implementation of PeoplezString::Split for all vector types
+		 */
+		template<bool COMPRESS, class Vector>
+		static inline void SplitInto(PeoplezString const & str, Vector & result, char const token)
 		{
-			uint64_t const tokens = Count(token, 0) + 1;
-			size_t const len = Length();
+			uint64_t const tokens = str.Count(token, 0) + 1;
+			size_t const len = str.Length();
+			char const * const data = str.GetData();
 			char const * sourceChar = data; //Also used as "before"
 			char const * const end = sourceChar + len;
 			char const * position = sourceChar;
@@ -489,38 +517,37 @@ namespace Peoplez
 				sourceChar = position;
 				position = pos + 1;
 
-				if(sourceChar < pos) result.push_back(Substring(sourceChar - data, pos - sourceChar));
+				if(!COMPRESS || sourceChar < pos) result.push_back(str.Substring(sourceChar - data, pos - sourceChar));
 			}
 
-			if(position < end)
+			if(!COMPRESS || position < end)
 			{
-				result.push_back(Substring(position - data, end - position));
+				result.push_back(str.Substring(position - data, end - position));
 			}
 		}
 
 		template<>
-		void PeoplezString::Split<false>(std::vector<PeoplezString> & result, char const token) const
+		void PeoplezString::Split<true>(std::vector<PeoplezString> & result, char const token) const
 		{
-			uint64_t const tokens = Count(token, 0) + 1;
-			size_t const len = Length();
-			char const * sourceChar = data; //Also used as "before"
-			char const * const end = sourceChar + len;
-			char const * position = sourceChar;
-
-			// Clear result
-			result.clear();
-			if(result.capacity() < tokens) result.reserve(tokens);
+			SplitInto<true>(*this, result, token);
+		}
 
-			// Split string
-			for(char const *pos = (char const *) memchr(sourceChar, token, len); pos; pos = (char const *) memchr(position, token, end - position))
-			{
-				sourceChar = position;
-				position = pos + 1;
+		template<>
+		void PeoplezString::Split<false>(std::vector<PeoplezString> & result, char const token) const
+		{
+			SplitInto<false>(*this, result, token);
+		}
 
-				result.push_back(Substring(sourceChar - data, pos - sourceChar));
-			}
+		template<>
+		void PeoplezString::Split<true>(std::pmr::vector<PeoplezString> & result, char const token) const
+		{
+			SplitInto<true>(*this, result, token);
+		}
 
-			result.push_back(Substring(position - data, end - position));
+		template<>
+		void PeoplezString::Split<false>(std::pmr::vector<PeoplezString> & result, char const token) const
+		{
+			SplitInto<false>(*this, result, token);
 		}
 
 		void PeoplezString::Split(std::vector<PeoplezString> & result, char const token, bool const compress) const
@@ -647,9 +674,21 @@ namespace Peoplez
 
 		void PeoplezString::ToUnique(size_t const newSize) noexcept(false)
 		{
-			size_t const offSize = OffsetSize();
+			size_t offSize = OffsetSize();
 
-			if(*copies || (newSize && offSize > newSize / 2))
+			// Unique data behind a large offset (shifted by operator <<=) ... move it to the front instead of growing behind it
+			if(!*copies && newSize && offSize > newSize / 2)
+			{
+				dataLen = min(newSize, dataLen);
+
+				char * const front = ((char *) copies) + COPIES_SIZE;
+				if(dataLen) memmove(front, data, dataLen);
+				data = front;
+
+				offSize = 0;
+			}
+
+			if(*copies)
 			{
 				--(*copies);
 				copies = (COUNTER *) NEW(newSize + COPIES_SIZE);
@@ -669,7 +708,8 @@ namespace Peoplez
 				dataLen = min(newSize, dataLen);
 
 				copies = (COUNTER *) REALLOC(copies, reservedBytes + COPIES_SIZE);
-				data = ((char *) copies) + COPIES_SIZE;
+				// Keep the offset (data shifted by operator <<=)
+				data = ((char *) copies) + COPIES_SIZE + offSize;
 			}
 			//else nothing is to do
 		}
@@ -726,49 +766,82 @@ namespace Peoplez
 
 		bool PeoplezString::DecodeUrl() noexcept(false)
 		{
-			int escapes = 0;
-			unsigned char const *sourcePos = (unsigned char *) data;
-			unsigned char const *end = (unsigned char *) data + Length();
+			char const * const end = data + dataLen;
+			char const * const first = FindUrlSpecial(data, end);
 
-			for(; sourcePos < end; ++sourcePos)
-			{
-				if(*sourcePos == '%')
-				{
-					//Check if escape sequence can be completely inside the text; Check if the following 2 characters are HEX characters
-					if(sourcePos > end - 3 || !HEX2DEC[*(sourcePos + 1)] || !HEX2DEC[*(sourcePos + 2)] ) return false; //RETURN!!!
+			// Nothing to decode (most paths and parameters)
+			if(first == end) return true;
 
-					++escapes;
-				}
-			}
-
-			if(escapes)
+			/*
+			 * Decodes [source, end) to target (target <= source if in place)
+			 * Runs without escape sequences are copied at once.
+			 * Returns the end of the decoded data; nullptr if an escape sequence is invalid
+			 */
+			auto const decode = [end](char const * source, char * target) noexcept -> char *
 			{
-				uint32_t targetLen = Length() - 2 * escapes;
+				while(source < end)
+				{
+					char const * const special = FindUrlSpecial(source, end);
 
-				ToUnique();
+					if(target != source) memmove(target, source, special - source);
+					target += special - source;
+					source = special;
 
-				char *targetPos = data;
+					if(source == end) break;
 
-				for(sourcePos = (unsigned char *) data, end = sourcePos + Length(); sourcePos < end; ++sourcePos)
-				{
-					if(*sourcePos == '%')
+					if(*source == '+')
+					{
+						*target++ = ' ';
+						++source;
+					}
+					else
 					{
-						++sourcePos;
-						*targetPos = (*sourcePos) - HEX2DEC[*sourcePos];
+						//Check if escape sequence can be completely inside the text
+						if(end - source < 3) return nullptr;
+
+						unsigned char const high = source[1];
+						unsigned char const low = source[2];
 
-						*targetPos <<= 4;
+						//Check if the following 2 characters are HEX characters
+						if(!HEX2DEC[high] || !HEX2DEC[low]) return nullptr;
 
-						++sourcePos;
-						*targetPos |= (*sourcePos) - HEX2DEC[*sourcePos];
+						*target++ = (char)(((high - HEX2DEC[high]) << 4) | (low - HEX2DEC[low]));
+						source += 3;
 					}
-					else if(*sourcePos == '+') *targetPos = ' ';
-					else *targetPos = *sourcePos;
+				}
+
+				return target;
+			};
+
+			size_t const prefixLen = first - data;
+
+			if(Unique())
+			{
+				// Validate first, so the string is unchanged on failure
+				if(!IsUrlDecodable()) return false;
 
-					++targetPos;
+				// The decoded data is never longer
+				dataLen = decode(first, data + prefixLen) - data;
+			}
+			else
+			{
+				// Decode while copying (instead of ToUnique() and decoding afterwards)
+				COUNTER * const targetCopies = (COUNTER *) NEW(dataLen + COPIES_SIZE);
+				char * const target = ((char *) targetCopies) + COPIES_SIZE;
+
+				memcpy(target, data, prefixLen);
+				char const * const targetEnd = decode(first, target + prefixLen);
+
+				if(!targetEnd)
+				{
+					DELETE(targetCopies);
+					return false;
 				}
 
-				dataLen = targetLen;
+				*targetCopies = 0;
+				Reset((char *) targetCopies, targetEnd - target, dataLen);
 			}
+
 			return true;
 		}
 
@@ -860,59 +933,146 @@ namespace Peoplez
 
 		void PeoplezString::EncodeUrl() noexcept(false)
 		{
-			int escapes = 0;
-			unsigned char const * const end = (unsigned char *) data + Length();
+			char const * const end = data + dataLen;
+			char const * pos = FindUrlUnsafe(data, end);
 
-			for(unsigned char const *start = (unsigned char *) data; start < end; ++start) if(GetUrlEncMapPos(*start)) ++escapes;
+			// Nothing to encode
+			if(pos == end) return;
 
-			if(escapes)
+			size_t const outputLength = dataLen + 2 * CountUrlEscapes(pos, end);
+			COUNTER * const outputCopies = (COUNTER *) NEW(COPIES_SIZE + outputLength);
+			char * const output = ((char *)outputCopies) + COPIES_SIZE;
+			char * toPos = output + (pos - data);
+
+			// Unchanged beginning
+			memcpy(output, data, pos - data);
+
+			while(pos < end)
 			{
-				uint32_t const outputLength = Length() + 2 * escapes;
-				uint64_t *const outputCopies = (uint64_t *) NEW(COPIES_SIZE + outputLength);
-				char *const output = ((char *)outputCopies) + COPIES_SIZE;
-				unsigned char *toPos = (unsigned char *) output;
+				unsigned char const c = *pos++;
 
-				for(unsigned char const *start = (unsigned char *) data; start < end; ++start)
+				if(c == ' ') *toPos++ = '+';
+				else
 				{
-					if(*start == ' ') *toPos++ = '+';
-					if(GetUrlEncMapPos(*start))
-					{
-						*toPos++ = '%';
-						*toPos++ = DEC2HEX[(*start >> 4) & 0x0F];
-						*toPos++ = DEC2HEX[*start & 0x0F];
-					}
-					else *toPos++ = *start;
+					*toPos++ = '%';
+					*toPos++ = DEC2HEX[(c >> 4) & 0x0F];
+					*toPos++ = DEC2HEX[c & 0x0F];
 				}
 
-				Clear();
-				ToUnique();
+				// Copy the following run of safe characters at once
+				char const * const next = FindUrlUnsafe(pos, end);
+				memcpy(toPos, pos, next - pos);
+				toPos += next - pos;
+				pos = next;
+			}
 
-				DELETE(copies);
-				copies = outputCopies;
-				*copies = 0;
-				data = output;
-				reservedBytes = dataLen = outputLength;
+			*outputCopies = 0;
+			Reset((char *) outputCopies, outputLength, outputLength);
+		}
+
+#ifdef __SSE2__
+		/**
+		 * Mask of the bytes of a block that have to be url encoded (all but [0-9A-Za-z], see UrlEncBitmap)
+		 *
+		 * Bytes >= 0x80 are negative in the signed comparisons and therefore never in range.
+		 */
+		static inline unsigned UrlUnsafeMask(__m128i const block) noexcept
+		{
+			__m128i const digit = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('9' + 1)));
+			// Upper and lower case letters at once
+			__m128i const lower = _mm_or_si128(block, _mm_set1_epi8(0x20));
+			__m128i const letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+
+			return ~(unsigned)_mm_movemask_epi8(_mm_or_si128(digit, letter)) & 0xFFFF;
+		}
+#endif
+
+		char const * PeoplezString::FindUrlSpecial(char const * pos, char const * const end) noexcept
+		{
+#ifdef __SSE2__
+			__m128i const percent = _mm_set1_epi8('%');
+			__m128i const plus = _mm_set1_epi8('+');
+
+			for(; end - pos >= 16; pos += 16)
+			{
+				__m128i const block = _mm_loadu_si128((__m128i const *) pos);
+				unsigned const mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, percent), _mm_cmpeq_epi8(block, plus)));
+
+				if(mask) return pos + countr_zero(mask);
 			}
+#endif
+
+			for(; pos < end; ++pos) if(*pos == '%' || *pos == '+') return pos;
+
+			return end;
+		}
+
+		char const * PeoplezString::FindUrlUnsafe(char const * pos, char const * const end) noexcept
+		{
+#ifdef __SSE2__
+			for(; end - pos >= 16; pos += 16)
+			{
+				unsigned const mask = UrlUnsafeMask(_mm_loadu_si128((__m128i const *) pos));
+
+				if(mask) return pos + countr_zero(mask);
+			}
+#endif
+
+			for(; pos < end; ++pos) if(GetUrlEncMapPos(*pos)) return pos;
+
+			return end;
+		}
+
+		size_t PeoplezString::CountUrlEscapes(char const * pos, char const * const end) noexcept
+		{
+			size_t result = 0;
+
+#ifdef __SSE2__
+			__m128i const space = _mm_set1_epi8(' ');
+
+			for(; end - pos >= 16; pos += 16)
+			{
+				__m128i const block = _mm_loadu_si128((__m128i const *) pos);
+
+				result += popcount(UrlUnsafeMask(block) & ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, space)));
+			}
+#endif
+
+			for(; pos < end; ++pos) if(*pos != ' ' && GetUrlEncMapPos(*pos)) ++result;
+
+			return result;
 		}
 
 		PeoplezString & PeoplezString::operator =(PeoplezString const & rhs) noexcept
 		{
-			if(Unique()) DELETE(copies);
-			else --(*copies);
+			// Reference first (self assignment)
+			++(*rhs.copies);
+
+			// Moved-from strings don't hold data
+			if(copies)
+			{
+				if(Unique()) DELETE(copies);
+				else --(*copies);
+			}
 
 			data = rhs.data;
 			dataLen = rhs.dataLen;
 			reservedBytes = rhs.reservedBytes;
 			copies = rhs.copies;
-			++(*copies);
 
 			return *this;
 		}
 
 		PeoplezString & PeoplezString::operator =(PeoplezString && rhs) noexcept
 		{
-			if(Unique()) DELETE(copies);
-			else --(*copies);
+			if(this == &rhs) return *this;
+
+			// Moved-from strings don't hold data (e.g. when containers move elements)
+			if(copies)
+			{
+				if(Unique()) DELETE(copies);
+				else --(*copies);
+			}
 
 			dataLen = rhs.dataLen;
 			copies = rhs.copies;
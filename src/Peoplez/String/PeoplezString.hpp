@@ -43,7 +43,9 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <memory_resource>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 #ifndef PRIVATE
@@ -320,6 +322,17 @@ namespace Peoplez
 			 *  No-throw guarantee
 			 */
 			inline char const *GetData() const noexcept {return data;}
+			/**
+			 * View of the data
+			 *
+			 * The view is only valid as long as this string (or a copy sharing its buffer) exists unchanged.
+			 *
+			 * @return View of the data WITHOUT copying it
+			 *
+			 * @par Exception Safety
+			 *  No-throw guarantee
+			 */
+			inline std::string_view View() const noexcept {return std::string_view(data, dataLen);}
 			/**
 			 * Calculates a hash value of this string
 			 *
@@ -352,12 +365,25 @@ namespace Peoplez
 			/**
 			 * Checks whether this string is already url encoded
 			 *
+			 * Only alphanumeric characters, '%' and '+' are allowed (see EncodeUrl()). Escape sequences are not checked.
+			 *
 			 * @return True: Already url encoded; False: Not yet completely url encoded
 			 *
 			 * @par Exception Safety
 			 *  No-throw guarantee
 			 */
 			bool IsUrlEncoded() const noexcept __attribute__((pure));
+			/**
+			 * Checks whether this string can be url decoded
+			 *
+			 * Checks that every '%' is followed by two hexadecimal digits without decoding anything
+			 *
+			 * @return True: DecodeUrl() would succeed; False: Invalid escape sequence found
+			 *
+			 * @par Exception Safety
+			 *  No-throw guarantee
+			 */
+			bool IsUrlDecodable() const noexcept __attribute__((pure));
 			/**
 			 * Indicated whether the data are '\0' terminated
 			 *
@@ -406,6 +432,14 @@ namespace Peoplez
 			 */
 			template<bool COMPRESS>
 			void Split(std::vector<PeoplezString> &result, char token) const;
+			/**
+			 * Version of Split for vectors with a polymorphic allocator (e.g. from an arena)
+			 *
+			 * @param result Resulting list of text parts
+			 * @param token Character at which the text has to get splitted
+			 */
+			template<bool COMPRESS>
+			void Split(std::pmr::vector<PeoplezString> &result, char token) const;
 			/**
 			 * Splits the string at every occurrence of the given token
 			 *
@@ -425,8 +459,8 @@ namespace Peoplez
 			 * @param compress Indicates whether empty pairs have to be removed
 			 */
 			void SplitToPairs(std::vector<NameValuePair> & result, char token1, char token2, bool compress) const;
-			template <class T>
-			void SplitToPairs(std::vector<T> & result, PeoplezString (T::*mPtr1), PeoplezString (T::*mPtr2), char token1, char token2, bool compress) const
+			template <class T, class Allocator>
+			void SplitToPairs(std::vector<T, Allocator> & result, PeoplezString (T::*mPtr1), PeoplezString (T::*mPtr2), char token1, char token2, bool compress) const
 			{
 				size_t numPairs = 0;
 				char const * const end = data + Length();
@@ -659,6 +693,11 @@ namespace Peoplez
 			inline PeoplezString UniqueCopy() const {return PeoplezString(GetData(), Length());}
 			/**
 			 * Decodes url encoded data
+			 *
+			 * Escape sequences ("%XX") are decoded and '+' becomes ' '. Decodes in place if the buffer is unique;
+			 * otherwise the decoded data is written to a new buffer while copying.
+			 *
+			 * @return True: Decoded; False: Invalid escape sequence found (the string is unchanged)
 			 */
 			bool DecodeUrl() noexcept(false);
 			/**
@@ -668,6 +707,8 @@ namespace Peoplez
 			bool EncodeHtml() noexcept(false);
 			/**
 			 * Encodes data to url encoded data
+			 *
+			 * All characters but alphanumeric ones are escaped ("%XX"); ' ' becomes '+'.
 			 */
 			void EncodeUrl() noexcept(false);
 			/**
@@ -925,7 +966,23 @@ namespace Peoplez
 			static inline void DELETE(void * ptr) noexcept {free(ptr);}
 			static inline void * REALLOC(void * ptr, size_t size) noexcept(false) {void * const res = realloc(ptr, size); if(res) return res; throw std::bad_alloc();}
 
-			static inline bool GetUrlEncMapPos(unsigned char pos) {return pos >= 128 ? true : (UrlEncBitmap[pos/64] & (1 << pos));}
+			static inline bool GetUrlEncMapPos(unsigned char pos) {return pos >= 128 ? true : (UrlEncBitmap[pos/64] >> (pos % 64)) & 1;}
+			/**
+			 * Searches the first '%' or '+' (16 bytes at once with SSE2)
+			 *
+			 * @return Position of the character; end if there is none
+			 */
+			static char const * FindUrlSpecial(char const * pos, char const * end) noexcept __attribute__((pure));
+			/**
+			 * Searches the first character that has to be url encoded (16 bytes at once with SSE2)
+			 *
+			 * @return Position of the character; end if there is none
+			 */
+			static char const * FindUrlUnsafe(char const * pos, char const * end) noexcept __attribute__((pure));
+			/**
+			 * Counts the characters that are url encoded as escape sequence (all that have to be encoded but ' ')
+			 */
+			static size_t CountUrlEscapes(char const * pos, char const * end) noexcept __attribute__((pure));
 
 			/**
 			 * @brief Size of the copies counter part of the reserved memory
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+// Own headers
+#include "DelayQueue.hpp"
+
+// Local includes
+#include "Logging/Logger.hpp"
+
+// External includes
+#include <thread>
+
+namespace Peoplez
+{
+	// Local namespaces
+	using namespace System::Logging;
+
+	namespace System
+	{
+		std::mutex DelayQueue::mut;
+		std::condition_variable DelayQueue::condition;
+		std::multimap<DelayQueue::Clock::time_point, std::function<void()>> DelayQueue::entries;
+		bool DelayQueue::running = false;
+
+		void DelayQueue::Post(Clock::duration const delay, std::function<void()> target)
+		{
+			std::unique_lock<std::mutex> const lock(mut);
+
+			std::multimap<Clock::time_point, std::function<void()>>::iterator const iter = entries.emplace(Clock::now() + delay, std::move(target));
+
+			// If the thread is not running ... start it
+			// Else if this call is the earliest ... update waiting time
+			if(!running)
+			{
+				std::thread(ThreadFunction).detach();
+				running = true;
+			}
+			else if(iter == entries.begin()) condition.notify_one();
+		}
+
+		void DelayQueue::ThreadFunction() noexcept
+		{
+			std::unique_lock<std::mutex> lock(mut);
+
+			// While calls are pending ...
+			while(!entries.empty())
+			{
+				if(entries.begin()->first > Clock::now())
+				{
+					condition.wait_until(lock, entries.begin()->first);
+					continue;
+				}
+
+				std::function<void()> const target = std::move(entries.begin()->second);
+				entries.erase(entries.begin());
+
+				// Call without lock (the target may post further calls)
+				lock.unlock();
+
+				try
+				{
+					target();
+				}
+				catch(...)
+				{
+					Logger::LogException("Error in delayed call", __FILE__, __LINE__);
+				}
+
+				lock.lock();
+			}
+
+			running = false;
+		}
+	} // namespace System
+} // namespace Peoplez
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEOPLEZ_SYSTEM_DELAYQUEUE_HPP_
+#define PEOPLEZ_SYSTEM_DELAYQUEUE_HPP_
+
+// Local includes
+#include "../General/Scheduler.hpp"
+
+// External includes
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace Peoplez
+{
+	namespace System
+	{
+		/**
+		 * @brief Calls functions once after a delay
+		 *
+		 * @details
+		 * All delayed calls share one thread that only runs while calls are pending.
+		 * Unlike Timer it is meant for many short-lived delays (e.g. coroutines that sleep).
+		 */
+		class DelayQueue final
+		{
+		public:
+			using Clock = std::chrono::steady_clock;
+
+			/**
+			 * @brief Suspends the awaiting coroutine for a while (see Sleep)
+			 */
+			struct SleepAwaiter final
+			{
+				bool await_ready() const noexcept {return delay <= Clock::duration::zero();}
+				void await_suspend(std::coroutine_handle<> awaiting)
+				{
+					// Continued by the pool it suspended in, not by the thread of the delay queue
+					General::Scheduler * const scheduler = General::Scheduler::Current();
+
+					Post(delay, [scheduler, awaiting]() {General::Scheduler::Resume(scheduler, awaiting);});
+				}
+				void await_resume() const noexcept {}
+
+				Clock::duration const delay;
+			};
+
+			/**
+			 * Calls a function after a delay (in the thread of the delay queue)
+			 *
+			 * The function should return quickly; further delayed calls wait for it.
+			 *
+			 * @param delay Time to wait
+			 * @param target Function to call
+			 */
+			static void Post(Clock::duration delay, std::function<void()> target);
+			/**
+			 * Creates an awaitable that continues the coroutine after a delay
+			 *
+			 * The coroutine is continued through the current General::Scheduler (in the thread of the delay queue if there is none).
+			 *
+			 * @param delay Time to wait
+			 */
+			static SleepAwaiter Sleep(Clock::duration delay) noexcept {return SleepAwaiter{delay};}
+
+		private:
+			DelayQueue() = delete;
+
+			static void ThreadFunction() noexcept;
+
+			static std::mutex mut;
+			static std::condition_variable condition;
+			static std::multimap<Clock::time_point, std::function<void()>> entries;
+			static bool running;
+		};
+	} // namespace System
+} // namespace Peoplez
+
+#endif // PEOPLEZ_SYSTEM_DELAYQUEUE_HPP_
@@ -80,6 +80,12 @@ namespace Peoplez
 					 * When more data can be sent to the client/browser this handler is called
 					 */
 					virtual void MessageSendableCB() = 0;
+					/**
+					 * Indicates that the connection stays open although the client sends nothing (e.g. while the server pushes events)
+					 *
+					 * Asked by the connection timeout of the ConnectionsManager (from another thread)
+					 */
+					virtual bool KeepOpen() noexcept {return false;}
 					/**
 					 * Destructor
 					 */
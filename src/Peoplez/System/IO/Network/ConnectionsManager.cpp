@@ -41,6 +41,7 @@
 
 // Extern includes
 #include <limits>
+#include <vector>
 extern "C"
 {
 #include <fcntl.h>
@@ -84,7 +85,8 @@ namespace Peoplez
 				enum EpollDataType
 				{
 					CLIENT_INFO,
-					LISTENER
+					LISTENER,
+					READABLE_WAITER
 				};
 
 				class EpollData
@@ -92,28 +94,35 @@ namespace Peoplez
 				public:
 					EpollData(Listener * const _listener) : type(LISTENER), before(0), next(0), listener(_listener) {}
 					EpollData(ClientInfo * const _clientInfo) : type(CLIENT_INFO), before(0), next(0), clientInfo(_clientInfo) {}
+					EpollData(int const _fd, std::function<void()> && _waiter) : type(READABLE_WAITER), before(0), next(0), fd(_fd), waiter(std::move(_waiter)) {}
 
 					~EpollData()
 					{
 						if(type == CLIENT_INFO) clientInfo.~__shared_ptr();
-						else listener.~__shared_ptr();
+						else if(type == LISTENER) listener.~__shared_ptr();
+						else waiter.~function();
 					}
 
 					EpollDataType type;
 
 					EpollData * before;
 					EpollData * next;
+					/**
+					 * @brief Watched socket (only READABLE_WAITER)
+					 */
+					int fd = -1;
 
 					union
 					{
 						std::shared_ptr<Listener> listener;
 						std::shared_ptr<ClientInfo> clientInfo;
+						std::function<void()> waiter;
 					};
 				};
 
 				uint32_t const ConnectionsManager::EPOLL_ERROR_OR_DELETE = EPOLLERR | EPOLLHUP | EPOLLRDHUP;
 
-				ConnectionsManager::ConnectionsManager(Factory & pTFactory, size_t const threads) : clientBuffer(epoll_create1(0)), eventSock(eventfd(0, EFD_NONBLOCK)), listeners(0), newInfos(0), oldInfos(0), perThreadDataFactory(pTFactory), timer(std::bind(&ConnectionsManager::TimeOut, this), std::chrono::seconds(CONNECTION_TIMEOUT))
+				ConnectionsManager::ConnectionsManager(Factory & pTFactory, size_t const threads) : clientBuffer(epoll_create1(0)), eventSock(eventfd(0, EFD_NONBLOCK)), taskSock(eventfd(0, EFD_NONBLOCK)), tasks(), listeners(0), newInfos(0), oldInfos(0), waiters(0), perThreadDataFactory(pTFactory), timer(std::bind(&ConnectionsManager::TimeOut, this), std::chrono::seconds(CONNECTION_TIMEOUT))
 				{
 					try
 					{
@@ -125,6 +134,9 @@ namespace Peoplez
 						//Add(new EventClientInfo(eventSock));
 						AddEventSock();
 
+						if(taskSock == -1) Logger::LogException("Task file descriptor not valid", __FILE__, __LINE__);
+						AddTaskSock();
+
 						//Add threads
 						AddThreads(threads);
 
@@ -161,6 +173,24 @@ namespace Peoplez
 					}
 				}
 
+				void ConnectionsManager::AddTaskSock() noexcept
+				{
+					struct epoll_event event;
+
+					// Set epoll events to react on
+					event.events = EPOLLIN | EPOLLET;
+					// Distinguished from EpollData objects by its address
+					event.data.ptr = (void *) &taskSock;
+
+					if(epoll_ctl(clientBuffer, EPOLL_CTL_ADD, taskSock, &event) == -1)
+					{
+						Logger::LogException("Could not add task socket to clientBuffer", __FILE__, __LINE__);
+
+						// Ensure not to have the socket in epoll buffer
+						epoll_ctl(clientBuffer, EPOLL_CTL_DEL, taskSock, 0);
+					}
+				}
+
 				void ConnectionsManager::Add(ClientInfo * const info) noexcept
 				{
 					try
@@ -337,13 +367,49 @@ namespace Peoplez
 					}
 				}
 
+				void ConnectionsManager::DeleteAllWaiters() noexcept
+				{
+					try
+					{
+						std::unique_lock<std::mutex> const listLock(infoListMutex);
+
+						while(waiters != 0)
+						{
+							EpollData * const d = waiters;
+
+							waiters = d->next;
+							epoll_ctl(clientBuffer, EPOLL_CTL_DEL, d->fd, 0);
+							delete d;
+						}
+					}
+					catch(...)
+					{
+						Logger::LogException("Error in ConnectionsManager::DeleteAllWaiters", __FILE__, __LINE__);
+					}
+				}
+
 				void ConnectionsManager::DeleteOldClients() noexcept
 				{
 					try
 					{
 						std::unique_lock<std::mutex> const listLock(infoListMutex);
 
-						while(oldInfos != 0) RemoveInner(oldInfos->clientInfo->fd, oldInfos);
+						while(oldInfos != 0)
+						{
+							EpollData * const d = oldInfos;
+
+							// If the connection is idle on purpose ... keep it for the next interval
+							if(d->clientInfo->KeepOpen())
+							{
+								oldInfos = d->next;
+								if(oldInfos != 0) oldInfos->before = 0;
+
+								d->next = newInfos;
+								if(newInfos != 0) newInfos->before = d;
+								newInfos = d;
+							}
+							else RemoveInner(d->clientInfo->fd, d);
+						}
 
 //						while(oldInfos != 0)
 //						{
@@ -404,6 +470,10 @@ namespace Peoplez
 
 							if(d->next != 0) d->next->before = d->before;
 							break;
+						case READABLE_WAITER:
+							// Removed by TakeWaiter only
+							Logger::LogException("Wait for readable socket can not be removed", __FILE__, __LINE__);
+							return;
 						}
 
 						// Delete EpollData object
@@ -431,6 +501,75 @@ namespace Peoplez
 					return false;
 				}
 
+				void ConnectionsManager::Post(std::function<void()> target) noexcept
+				{
+					try
+					{
+						{
+							std::unique_lock<std::mutex> const lock(taskMutex);
+							tasks.push_back(std::move(target));
+						}
+
+						// Wake up a worker thread
+						eventfd_write(taskSock, 1);
+					}
+					catch(...)
+					{
+						Logger::LogException("Error in ConnectionsManager::Post", __FILE__, __LINE__);
+					}
+				}
+
+				bool ConnectionsManager::WaitReadable(int const fd, std::function<void()> target) noexcept
+				{
+					try
+					{
+						struct epoll_event event;
+						EpollData * const data = new EpollData(fd, std::move(target));
+
+						// Level-triggered (already readable sockets report at once) and only once
+						event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+						event.data.ptr = (void *) data;
+
+						// Lock list before adding (the event may arrive immediately)
+						std::unique_lock<std::mutex> const listLock(infoListMutex);
+
+						if(epoll_ctl(clientBuffer, EPOLL_CTL_ADD, fd, &event) == -1)
+						{
+							delete data;
+							return false;
+						}
+
+						data->next = waiters;
+						if(waiters != 0) waiters->before = data;
+						waiters = data;
+
+						return true;
+					}
+					catch(...)
+					{
+						Logger::LogException("Error in ConnectionsManager::WaitReadable", __FILE__, __LINE__);
+					}
+
+					return false;
+				}
+
+				std::function<void()> ConnectionsManager::TakeWaiter(EpollData * const d) noexcept
+				{
+					std::unique_lock<std::mutex> const listLock(infoListMutex);
+
+					epoll_ctl(clientBuffer, EPOLL_CTL_DEL, d->fd, 0);
+
+					// Remove EpollData from list
+					if(d->before != 0) d->before->next = d->next;
+					else waiters = d->next;
+					if(d->next != 0) d->next->before = d->before;
+
+					std::function<void()> target = std::move(d->waiter);
+					delete d;
+
+					return target;
+				}
+
 				void ConnectionsManager::RemoveThreads(size_t n) noexcept
 				{
 					try
@@ -451,6 +590,7 @@ namespace Peoplez
 						if(workerThreadList.empty())
 						{
 							epoll_ctl(clientBuffer, EPOLL_CTL_DEL, eventSock, 0);
+							epoll_ctl(clientBuffer, EPOLL_CTL_DEL, taskSock, 0);
 							Logger::LogEvent("No worker threads left");
 						}
 					}
@@ -481,8 +621,12 @@ namespace Peoplez
 
 						Logger::LogEvent("All listeners deleted");
 
-						//close event socket
+						// Drop pending waits
+						DeleteAllWaiters();
+
+						//close event sockets
 						close(eventSock);
+						close(taskSock);
 
 						Logger::LogEvent("ConnectionsManager stopped");
 					}
@@ -515,6 +659,9 @@ namespace Peoplez
 						// Ensure that the database holds a connection for this thread
 						std::unique_ptr<const Product> const pTData(perThreadDataFactory.CreateProduct());
 
+						// Coroutines suspended in this thread are continued by the pool
+						SetCurrent(this);
+
 						// Allocate array for epoll event data
 						epoll_event * const events = (epoll_event * const) calloc(MAXEVENTS, sizeof(epoll_event));
 						//epoll_event events[MAXEVENTS];
@@ -522,9 +669,11 @@ namespace Peoplez
 						// Declaration of loop variables
 						std::shared_ptr<ClientInfo> infoData[MAXEVENTS];
 						std::shared_ptr<Listener> listenerData[MAXEVENTS];
+						std::function<void()> waiterCalls[MAXEVENTS];
 						uint32_t infoEventCalls[MAXEVENTS];
 						uint32_t listenerEventCalls[MAXEVENTS];
-						uint numInfoData, numListenerData;
+						uint numInfoData, numListenerData, numWaiterCalls;
+						bool runTasks;
 
 						// While worker thread should continue running ...
 						while(running)
@@ -532,7 +681,8 @@ namespace Peoplez
 							try
 							{
 								// reset number of clientInfos and listeners to handle outside critical section
-								numInfoData = numListenerData = 0;
+								numInfoData = numListenerData = numWaiterCalls = 0;
+								runTasks = false;
 
 								/// EPOLL CRITICAL SECTION ///
 								{
@@ -575,6 +725,19 @@ namespace Peoplez
 											else if(val == EVENT_SOCKET_CALL_TIMEOUT) deleteOldEntriesEnabled = true;
 #endif
 										}
+										else if(events[i].data.ptr == &taskSock) // If functions were posted ...
+										{
+											// Reset event socket before fetching them (later posts signal again)
+											eventfd_t val = 0;
+											eventfd_read(taskSock, &val);
+
+											runTasks = true;
+										}
+										else if(data->type == READABLE_WAITER)
+										{
+											// Call outside critical section (also on errors, the target finds out itself)
+											waiterCalls[numWaiterCalls++] = TakeWaiter(data);
+										}
 										else if((events[i].events & EPOLL_ERROR_OR_DELETE))
 										{
 											// Remove socket from epoll and delete its EpollData object
@@ -648,6 +811,46 @@ namespace Peoplez
 									// Reset the shared_ptr
 									listenerData[i].reset();
 								}
+
+								// Continue waits for readable sockets
+								for(uint i = 0; i < numWaiterCalls; ++i)
+								{
+									std::function<void()> const target = std::move(waiterCalls[i]);
+
+									waiterCalls[i] = nullptr;
+
+									try
+									{
+										target();
+									}
+									catch(...)
+									{
+										Logger::LogException("Error in wait for readable socket", __FILE__, __LINE__);
+									}
+								}
+
+								// Call posted functions
+								if(runTasks)
+								{
+									std::vector<std::function<void()>> posted;
+
+									{
+										std::unique_lock<std::mutex> const lock(taskMutex);
+										posted.swap(tasks);
+									}
+
+									for(std::function<void()> const & target : posted)
+									{
+										try
+										{
+											target();
+										}
+										catch(...)
+										{
+											Logger::LogException("Error in function posted to ConnectionsManager", __FILE__, __LINE__);
+										}
+									}
+								}
 							}
 							catch (...)
 							{
@@ -656,6 +859,7 @@ namespace Peoplez
 						}
 
 						free(events);
+						SetCurrent(nullptr);
 					}
 					catch (...)
 					{
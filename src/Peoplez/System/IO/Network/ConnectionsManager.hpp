@@ -38,13 +38,17 @@
 
 // Local includes
 #include "../../../General/Patterns/Factory.hpp"
+#include "../../../General/Scheduler.hpp"
 #include "../../Timer.hpp"
 #include "Listener.hpp"
 #include "ClientInfo.hpp"
 
 // Extern includes
+#include <coroutine>
+#include <functional>
 #include <thread>
 #include <list>
+#include <vector>
 
 namespace Peoplez
 {
@@ -58,11 +62,29 @@ namespace Peoplez
 
 				/**
 				 * @brief Manages all client connections
-				 * @details Manages all connections that are needed for reading and/or writing. Does not manage listening sockets
+				 * @details Manages all connections that are needed for reading and/or writing. Does not manage listening sockets.
+				 * Its worker threads are the General::Scheduler of the coroutines they run (see Post).
 				 */
-				class ConnectionsManager final
+				class ConnectionsManager final : public General::Scheduler
 				{
 				public:
+					/**
+					 * @brief Suspends the awaiting coroutine until a socket is readable (see Readable)
+					 */
+					struct ReadableAwaiter final
+					{
+						bool await_ready() const noexcept {return !manager;}
+						bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+						{
+							// If the socket can not be watched ... continue immediately
+							return manager->WaitReadable(fd, [awaiting]() {awaiting.resume();});
+						}
+						void await_resume() const noexcept {}
+
+						ConnectionsManager * const manager;
+						int const fd;
+					};
+
 					/**
 					 * Constructor
 					 *
@@ -92,6 +114,35 @@ namespace Peoplez
 					 * Adds a new Listener to wait for new connections
 					 */
 					void Add(Listener * listener) noexcept;
+					/**
+					 * Calls a function in one of the worker threads (after the events they handle at the moment)
+					 *
+					 * Can be called from any thread. Functions that are pending when the last worker thread is removed are dropped.
+					 *
+					 * @param target Function to call
+					 */
+					void Post(std::function<void()> target) noexcept override;
+					/**
+					 * Calls a function once in a worker thread as soon as a socket is readable (or closed by the peer)
+					 *
+					 * The socket must not be managed by the ConnectionsManager otherwise (e.g. a connection to a backend) and has to stay open until then.
+					 * Waits that are pending when the ConnectionsManager is destroyed are dropped.
+					 *
+					 * @param fd Socket to watch
+					 * @param target Function to call
+					 *
+					 * @return False if the socket can not be watched (the function is not called then)
+					 */
+					bool WaitReadable(int fd, std::function<void()> target) noexcept;
+					/**
+					 * Creates an awaitable that continues the coroutine in a worker thread as soon as a socket is readable
+					 *
+					 * Only waits within the worker threads of a ConnectionsManager (e.g. in Services::Http::HttpCoroutineHandler::Handle);
+					 * elsewhere, and if the socket can not be watched, the coroutine continues immediately.
+					 *
+					 * @param fd Socket to watch (see WaitReadable)
+					 */
+					static ReadableAwaiter Readable(int fd) noexcept {return ReadableAwaiter{dynamic_cast<ConnectionsManager *>(Current()), fd};}
 					/**
 					 * Adds n threads to the thread pool
 					 *
@@ -127,14 +178,17 @@ namespace Peoplez
 
 					void DeleteAllClients() noexcept;
 					void DeleteAllListeners() noexcept;
+					void DeleteAllWaiters() noexcept;
 					void DeleteOldClients() noexcept;
 					void Remove(int fd, EpollData const * d) noexcept;
 					void RemoveInner(int fd, EpollData const * d) noexcept;
 					void AddEventSock() noexcept;
+					void AddTaskSock() noexcept;
 					void ThreadPoolFunction() noexcept;
 					void ThreadPoolFunction2() noexcept;
 					void TimeOut() noexcept;
 					void ToNew(EpollData * d);
+					std::function<void()> TakeWaiter(EpollData * d) noexcept;
 
 					/**
 					 * @brief epoll file descriptor
@@ -142,11 +196,21 @@ namespace Peoplez
 					int const clientBuffer;
 					std::mutex epollMutex;
 					int const eventSock;
+					/**
+					 * @brief Event socket that signals posted functions (see Post)
+					 */
+					int const taskSock;
+					std::vector<std::function<void()>> tasks;
+					std::mutex taskMutex;
 					std::mutex infoListMutex;
 					std::mutex listenerListMutex;
 					EpollData * listeners;
 					EpollData * newInfos;
 					EpollData * oldInfos;
+					/**
+					 * @brief Pending waits for readable sockets (see WaitReadable; protected by infoListMutex)
+					 */
+					EpollData * waiters;
 					std::list<std::thread>::iterator communicationVariable;
 					std::mutex communicationMutex;
 					std::condition_variable communicationCondition;
@@ -58,6 +58,28 @@ namespace Peoplez
 					return IsOpen() ? SSL_write(ssl, buf, (int)len) : -1;
 				}
 
+				int SecureSocket::SendV(iovec const * const iov, int const iovcnt) noexcept
+				//@ requires valid(?sock, ?is_open) &*& iovcnt >= 0 &*& Peoplez::System::IO::Network::Socket_vtype(this, ?thisType);
+				//@ ensures valid(sock, is_open) &*& Peoplez::System::IO::Network::Socket_vtype(this, thisType);
+				{
+					int sent = 0;
+
+					for(int i = 0; i < iovcnt; ++i)
+					{
+						int const res = Send((char const *) iov[i].iov_base, iov[i].iov_len);
+
+						// Return error only if nothing could be sent
+						if(res < 0) return sent ? sent : res;
+
+						sent += res;
+
+						// Stop if buffer could not be sent completely
+						if((size_t) res < iov[i].iov_len) break;
+					}
+
+					return sent;
+				}
+
 				void SecureSocket::Close() noexcept
 				//@ requires valid(?sock, ?is_open) &*& Peoplez::System::IO::Network::Socket_vtype(this, ?thisType);
 				//@ ensures valid(sock, false) &*& Peoplez::System::IO::Network::Socket_vtype(this, thisType);
@@ -91,6 +91,19 @@ namespace Peoplez
 					virtual int Send(char const * buf, size_t len) noexcept;
 					//@ requires valid(?sock, ?is_open) &*& chars(buf, len, _) &*& len <= INT_MAX &*& Peoplez::System::IO::Network::Socket_vtype(this, ?thisType);
 					//@ ensures valid(sock, is_open) &*& chars(buf, len, _) &*& Peoplez::System::IO::Network::Socket_vtype(this, thisType);
+					/**
+					 * Sends several buffers to the client using ssl
+					 *
+					 * TLS has no gather write. The buffers are written one after another until one could not be written completely.
+					 *
+					 * @param iov Buffers to be sent (in order)
+					 * @param iovcnt Number of buffers
+					 *
+					 * @return Number of bytes sent; -1 if nothing could be sent
+					 */
+					virtual int SendV(iovec const * iov, int iovcnt) noexcept;
+					//@ requires valid(?sock, ?is_open) &*& iovcnt >= 0 &*& Peoplez::System::IO::Network::Socket_vtype(this, ?thisType);
+					//@ ensures valid(sock, is_open) &*& Peoplez::System::IO::Network::Socket_vtype(this, thisType);
 					/**
 					 * Closes the complete socket
 					 *
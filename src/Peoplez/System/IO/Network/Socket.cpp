@@ -41,6 +41,7 @@
 //{
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 //}
 
 namespace Peoplez
@@ -74,6 +75,14 @@ namespace Peoplez
 					return (int)res;
 				}
 
+				int Socket::SendV(iovec const * const iov, int const iovcnt) noexcept
+				//@ requires valid(?sock, ?is_open) &*& iovcnt >= 0 &*& Peoplez::System::IO::Network::Socket_vtype(this, ?thisType);
+				//@ ensures valid(sock, is_open) &*& Peoplez::System::IO::Network::Socket_vtype(this, thisType);
+				{
+					ssize_t const res = writev(sock, iov, iovcnt);
+					return (int)res;
+				}
+
 				void Socket::Close() noexcept
 				//@ requires valid(?sock, _) &*& Peoplez::System::IO::Network::Socket_vtype(this, ?thisType);
 				//@ ensures valid(sock, false) &*& Peoplez::System::IO::Network::Socket_vtype(this, thisType);
@@ -38,6 +38,10 @@
 
 // Extern includes
 #include <cstddef>
+extern "C"
+{
+#include <sys/uio.h>
+}
 
 namespace Peoplez
 {
@@ -114,6 +118,18 @@ namespace Peoplez
 					//@ requires valid(?sock, ?is_open) &*& chars(buf, len, _) &*& len <= INT_MAX &*& Peoplez::System::IO::Network::Socket_vtype(this, ?thisType);
 					//@ ensures valid(sock, is_open) &*& chars(buf, len, _) &*& Peoplez::System::IO::Network::Socket_vtype(this, thisType);
 
+					/**
+					 * Sends several buffers to the client at once (gather write)
+					 *
+					 * @param iov Buffers to be sent (in order)
+					 * @param iovcnt Number of buffers
+					 *
+					 * @return Number of bytes sent; -1 on error
+					 */
+					virtual int SendV(iovec const * iov, int iovcnt) noexcept;
+					//@ requires valid(?sock, ?is_open) &*& iovcnt >= 0 &*& Peoplez::System::IO::Network::Socket_vtype(this, ?thisType);
+					//@ ensures valid(sock, is_open) &*& Peoplez::System::IO::Network::Socket_vtype(this, thisType);
+
 					/**
 					 * Closes the socket
 					 */
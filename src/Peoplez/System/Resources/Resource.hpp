@@ -39,6 +39,12 @@
 // Local includes
 #include "../../String/PeoplezString.hpp"
 #include "../../General/Enums.hpp"
+#include "../../Services/Http/Enums.hpp"
+
+// Extern includes
+#include <array>
+#include <ctime>
+#include <memory>
 
 namespace Peoplez
 {
@@ -62,17 +68,30 @@ namespace Peoplez
 			class Resource final
 			{
 			public:
-				Resource() : Compressed(false), Hash(0), Status(RESOURCE_STATUS_NOT_MODIFIED), Type(FILE_TYPE::NONE) {}
+				/**
+				 * @var typedef std::shared_ptr<String::PeoplezString const> SharedString
+				 * @brief String shared with the cache of the resource holder
+				 * @details PeoplezString's reference counter is not atomic, so cached strings are only shared via shared_ptr and never copied.
+				 * Use them by reference (e.g. Append) or make an own copy with UniqueCopy().
+				 */
+				typedef std::shared_ptr<String::PeoplezString const> SharedString;
+
+				Resource() : Compressed(false), Hash(0), LastModified(0), Status(RESOURCE_STATUS_NOT_MODIFIED), Type(FILE_TYPE::NONE) {}
 				/**
 				 * Recommended constructor
 				 *
 				 * @param compressed Indicates whether the content is compressed
-				 * @param content Content itself
+				 * @param content Content itself (own copy of the request)
 				 * @param status Modification status of the content
 				 * @param hash Hash value of the content
 				 * @param type Type of the content
+				 * @param lastModified Modification time of the content (0 if unknown)
+				 * @param notModified Pre-serialized 304 response for the content (see Services::Http::HttpResponse::CreateNotModified)
+				 * @param variants Content per content coding (see Variants)
 				 */
-				Resource(bool compressed, String::PeoplezString content, ResourceStatus status, size_t hash, FileType type) : Compressed(compressed), Content(content), Hash(hash), Status(status), Type(type) {}
+				Resource(bool compressed, String::PeoplezString content, ResourceStatus status, size_t hash, FileType type, time_t lastModified = 0, SharedString notModified = SharedString(),
+						std::array<SharedString, Services::Http::HTTP_COMPRESSION_COUNT> const & variants = std::array<SharedString, Services::Http::HTTP_COMPRESSION_COUNT>())
+					: Compressed(compressed), Content(content), Hash(hash), LastModified(lastModified), NotModified(notModified), Status(status), Type(type), Variants(variants) {}
 				virtual ~Resource() {}
 
 				/**
@@ -81,12 +100,21 @@ namespace Peoplez
 				bool Compressed;
 				/**
 				 * @brief Content itself
+				 * @details Own copy (empty if requested without content, see ResourceHolder::GetResource)
 				 */
 				String::PeoplezString Content;
 				/**
 				 * @brief Hash value of the content
 				 */
 				size_t Hash;
+				/**
+				 * @brief Modification time of the content (0 if unknown)
+				 */
+				time_t LastModified;
+				/**
+				 * @brief Pre-serialized 304 response for conditional requests of this version; empty if none
+				 */
+				SharedString NotModified;
 				/**
 				 * @brief Modification status of the content
 				 */
@@ -95,6 +123,11 @@ namespace Peoplez
 				 * @brief Type of the content
 				 */
 				FileType Type;
+				/**
+				 * @brief Content per content coding (indexed by Services::Http::HttpCompression); empty if the coding is not available
+				 * @details The identity (HTTP_COMPRESSION_NONE) is always set, the others only if they are smaller. Shared with the cache (see SharedString).
+				 */
+				std::array<SharedString, Services::Http::HTTP_COMPRESSION_COUNT> Variants;
 			};
 		} // namespace Resources
 	} // namespace System
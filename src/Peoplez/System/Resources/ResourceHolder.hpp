@@ -40,6 +40,9 @@
 #include "../../String/PeoplezString.hpp"
 #include "Resource.hpp"
 
+// Extern includes
+#include <ctime>
+
 /**
  * @def RESOURCE_TIMEOUT
  * @brief Time in seconds after that a resource should be checked for updates
@@ -71,8 +74,9 @@ namespace Peoplez
 				 * Getter for the resource
 				 *
 				 * @param hashValue Value of old version. If equal to current, the content will be empty. Default is 0.
+				 * @param withContent Indicates whether Resource::Content is set (a copy per call; the variants are shared anyway)
 				 */
-				virtual Resource GetResource(size_t hashValue = 0) = 0;
+				virtual Resource GetResource(size_t hashValue = 0, bool withContent = true) = 0;
 
 				/**
 				 * @brief Name Name of the resource for the resource handler
@@ -38,10 +38,13 @@
 
 // Local includes
 #include "../../General/FileOperations.hpp"
+#include "../../Services/Http/HttpFunctions.hpp"
+#include "../../Services/Http/HttpResponse.hpp"
 #include "../../System/Logging/Logger.hpp"
 
 // Extern includes
 #include <sys/stat.h>
+#include <algorithm>
 #include <fstream>
 
 // External namespaces
@@ -52,6 +55,7 @@ namespace Peoplez
 	// Local namespaces
 	using namespace String;
 	using namespace General;
+	using namespace Services::Http;
 
 	namespace System
 	{
@@ -67,7 +71,7 @@ namespace Peoplez
 				compressed = IsCategoryOf(type, FILE_TYPE::TEXT);
 			}
 
-			Resource ResourceHolderPreloaded::GetResource(size_t hashValue) noexcept(noexcept(Resource(false, "", RESOURCE_STATUS_ERROR, 0, FILE_TYPE::NONE)))
+			Resource ResourceHolderPreloaded::GetResource(size_t hashValue, bool const withContent) noexcept(noexcept(Resource(false, "", RESOURCE_STATUS_ERROR, 0, FILE_TYPE::NONE)))
 			{
 				try
 				{
@@ -78,7 +82,8 @@ namespace Peoplez
 						lastSetup = time(0);
 
 						struct stat fileInfo;
-						stat(Path.GetData(), &fileInfo);
+
+						if(stat(Path.GetData(), &fileInfo) < 0) return Resource(false, "", RESOURCE_STATUS_ERROR, 0, FILE_TYPE::NONE);
 
 						if(fileInfo.st_mtime != lastModified)
 						{
@@ -96,10 +101,26 @@ namespace Peoplez
 								size_t newHash = newContent.HashValue();
 								if(newHash != hash)
 								{
-									content = newContent;
-									if(compressed) content.Compress();
+									// Replaced as a whole, older versions are released with their last Resource
+									variants.fill(Resource::SharedString());
+									variants[HTTP_COMPRESSION_NONE] = std::make_shared<PeoplezString const>(newContent);
+
+									// Precompressed variants (deflate is left out as it is never smaller than gzip for the same client)
+									if(compressed)
+									{
+										for(HttpCompression const compression : {HTTP_COMPRESSION_GZIP, HTTP_COMPRESSION_BROTLI, HTTP_COMPRESSION_ZSTD})
+										{
+											PeoplezString const variant = HttpFunctions::Compress(newContent, compression);
+											if(!variant.IsEmpty() && variant.Length() < newContent.Length()) variants[compression] = std::make_shared<PeoplezString const>(variant);
+										}
+									}
+
 									hash = newHash;
 								}
+
+								// Revalidations of this version are answered with a constant response (Vary if a compressed variant exists)
+								bool const vary = std::any_of(variants.begin(), variants.begin() + HTTP_COMPRESSION_NONE, [](Resource::SharedString const & variant) {return (bool)variant;});
+								notModified = std::make_shared<PeoplezString const>(HttpResponse::CreateNotModified(hash, lastModified, vary));
 							}
 
 							delete[] data;
@@ -107,11 +128,16 @@ namespace Peoplez
 					}
 
 					if(hashValue == hash) return Resource();
+					// Not loaded (e.g. unreadable file)
+					else if(!variants[HTTP_COMPRESSION_NONE]) return Resource(false, "", RESOURCE_STATUS_ERROR, 0, FILE_TYPE::NONE);
+					// Variants are shared via shared_ptr, Content is an own copy (as the reference counter of PeoplezString is not atomic)
 					else
 					{
-						PeoplezString uniqueContent = content;
-						uniqueContent.ToUnique();
-						return Resource(compressed, uniqueContent, RESOURCE_STATUS_UPDATED, hash, type);
+						// Content stays the gzip variant for users of Compressed/Content
+						bool const gzip = (bool)variants[HTTP_COMPRESSION_GZIP];
+						PeoplezString const content = withContent ? variants[gzip ? HTTP_COMPRESSION_GZIP : HTTP_COMPRESSION_NONE]->UniqueCopy() : PeoplezString();
+
+						return Resource(gzip, content, RESOURCE_STATUS_UPDATED, hash, type, lastModified, notModified, variants);
 					}
 				}
 				catch (...)
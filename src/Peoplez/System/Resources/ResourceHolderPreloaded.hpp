@@ -40,6 +40,7 @@
 #include "ResourceHolder.hpp"
 
 // Extern includes
+#include <array>
 #include <mutex>
 
 namespace Peoplez
@@ -61,7 +62,7 @@ namespace Peoplez
 				 * @param fileName Name of the file containing the content
 				 */
 				ResourceHolderPreloaded(String::PeoplezString directory, String::PeoplezString fileName);
-				virtual Resource GetResource(size_t hashValue) noexcept(noexcept(Resource(false, "", RESOURCE_STATUS_ERROR, 0, FILE_TYPE::NONE)));
+				virtual Resource GetResource(size_t hashValue, bool withContent = true) noexcept(noexcept(Resource(false, "", RESOURCE_STATUS_ERROR, 0, FILE_TYPE::NONE)));
 				virtual ~ResourceHolderPreloaded() {}
 
 			protected:
@@ -71,9 +72,13 @@ namespace Peoplez
 				 */
 				bool compressed;
 				/**
-				 * @brief The content itself
+				 * @brief The content per content coding (see Resource::Variants)
 				 */
-				String::PeoplezString content;
+				std::array<Resource::SharedString, Services::Http::HTTP_COMPRESSION_COUNT> variants;
+				/**
+				 * @brief Pre-serialized 304 response for the current version
+				 */
+				Resource::SharedString notModified;
 				/**
 				 * @brief General mutex
 				 */
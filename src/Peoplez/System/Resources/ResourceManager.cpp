@@ -37,6 +37,7 @@
 #include "ResourceManager.hpp"
 
 // Local includes
+#include "../../Services/Http/HttpFunctions.hpp"
 #include "../../System/Logging/Logger.hpp"
 #include "ResourceHolderPreloaded.hpp"
 
@@ -73,7 +74,8 @@ namespace Peoplez
 					{//Loading public files
 						struct stat fileInfo;
 						struct dirent *currentFile;
-						DIR * const dir = opendir(directory.EnsureZeroTermination().GetData());
+						// Zero termination on a copy (the directory is the prefix of all resource paths)
+						DIR * const dir = opendir(PeoplezString(directory).EnsureZeroTermination().GetData());
 
 						if(dir == NULL) Logger::LogException("Public directory could not be opened", __FILE__, __LINE__);
 						else
@@ -87,7 +89,7 @@ namespace Peoplez
 									if(stat((directory + fileName).EnsureZeroTermination().GetData(), &fileInfo) >= 0 && S_ISREG(fileInfo.st_mode))
 									{
 										if(((S_IXUSR | S_IXGRP | S_IXOTH) & fileInfo.st_mode) != 0) Logger::LogEvent("!!!Executable in public directory found!!!");
-										else GetResource(fileName, 0);
+										else GetResource(fileName, 0, false);
 									}
 								}
 							}
@@ -104,7 +106,7 @@ namespace Peoplez
 				}
 			}
 
-			Resource ResourceManager::GetResource(String::PeoplezString fileName, size_t hash)
+			Resource ResourceManager::GetResource(String::PeoplezString fileName, size_t hash, bool const withContent)
 			{
 				try
 				{
@@ -119,13 +121,13 @@ namespace Peoplez
 
 						if(comparison > 0) first = pos;
 						else if(comparison < 0) last = pos;
-						else return resources[pos]->GetResource(hash);
+						else return resources[pos]->GetResource(hash, withContent);
 					}
 
 					ResourceHolderPreloaded * const resource = new ResourceHolderPreloaded(directory, fileName);
 					resources.insert(resources.begin() + last, resource);
 
-					return resource->GetResource(hash);
+					return resource->GetResource(hash, withContent);
 				}
 				catch (...)
 				{
@@ -135,6 +137,52 @@ namespace Peoplez
 				return Resource();
 			}
 
+			bool ResourceManager::Respond(PeoplezString const fileName, HttpContext & context)
+			{
+				// Only files directly in the resource directory
+				if(fileName.IsEmpty() || fileName[0] == '.' || fileName.Find('/') != PeoplezString::NPOS) return false;
+
+				Resource const resource = GetResource(fileName, 0, false);
+
+				if(resource.Status != RESOURCE_STATUS_UPDATED) return false;
+
+				// Variant with the highest quality value; the smallest one of those with the same quality value
+				// (the identity if nothing else is acceptable)
+				std::array<uint16_t, HTTP_COMPRESSION_COUNT> const accepted = context.request.AcceptedCompressions();
+				HttpCompression compression = HTTP_COMPRESSION_NONE;
+				bool vary = false;
+
+				for(size_t i = 0; i < HTTP_COMPRESSION_NONE; ++i)
+				{
+					Resource::SharedString const & variant = resource.Variants[i];
+
+					if(!variant) continue;
+					vary = true;
+
+					if(accepted[i] && (accepted[i] > accepted[compression] || (accepted[i] == accepted[compression] && variant->Length() < resource.Variants[compression]->Length())))
+					{
+						compression = (HttpCompression)i;
+					}
+				}
+
+				// If the version of the client is still valid ... answer without body
+				if(context.request.IsNotModified(resource.Hash, resource.LastModified))
+				{
+					context.response.SetNotModified(resource.Hash, resource.LastModified, resource.NotModified);
+				}
+				else
+				{
+					// Own copy of the request (ranges are views of it)
+					context.response.SetWithBody(HttpStatusCode::OK, HttpFunctions::FileTypeToContentType(resource.Type), resource.Variants[compression]->UniqueCopy(), resource.Hash, compression);
+					context.response.SetLastModified(resource.LastModified);
+					context.response.SetRange(context.request);
+				}
+
+				context.response.SetVaryEncoding(vary);
+
+				return true;
+			}
+
 			/*
 			FileSaveStatus ResourceManager::SaveFile(uint64_t userID, PeoplezString fileName, PeoplezString content) noexcept
 			{
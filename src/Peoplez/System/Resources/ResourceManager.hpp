@@ -73,10 +73,25 @@ namespace Peoplez
 				 *
 				 * @param fileName Name of the file (including file extension)
 				 * @param hash Hash value of the resource at the client side (0 if none)
+				 * @param withContent Indicates whether Resource::Content is set (see ResourceHolder::GetResource)
 				 *
 				 * @return Content of the file (empty string when failed)
 				 */
-				Resource GetResource(String::PeoplezString fileName, size_t hash);
+				Resource GetResource(String::PeoplezString fileName, size_t hash, bool withContent = true);
+				/**
+				 * Answers a request with a resource
+				 *
+				 * Conditional requests (If-None-Match, If-Modified-Since) whose version is still valid are answered with the
+				 * pre-serialized 304 response of the resource. Range requests get the requested parts (see Services::Http::HttpResponse::SetRange).
+				 * The content coding is negotiated with the Accept-Encoding header field: the precompressed variant with the highest
+				 * quality value is sent, the smallest one among equally preferred variants.
+				 *
+				 * @param fileName Name of the file (including file extension)
+				 * @param context Context of the request
+				 *
+				 * @return Indicates whether the resource exists (the response is unchanged otherwise)
+				 */
+				bool Respond(String::PeoplezString fileName, Services::Http::HttpContext & context);
 				//FileSaveStatus SaveFile(uint64_t userID, String::PeoplezString fileName, String::PeoplezString content) noexcept;
 				~ResourceManager() noexcept;
 			private:
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Minimal checks for the test programs in this folder
+ *
+ * Every test program is a plain executable: it runs its checks and returns EXIT_FAILURE if one of them failed.
+ *
+ * Build and run all: make test
+ */
+
+#ifndef PEOPLEZ_TEST_CHECK_HPP_
+#define PEOPLEZ_TEST_CHECK_HPP_
+
+// Extern includes
+#include <cstdio>
+#include <cstdlib>
+
+namespace Peoplez
+{
+	namespace Test
+	{
+		/**
+		 * @brief Number of failed checks of the program
+		 */
+		inline unsigned int failures = 0;
+
+		/**
+		 * Result of the program
+		 *
+		 * @return EXIT_SUCCESS if all checks passed; EXIT_FAILURE otherwise
+		 */
+		inline int Result(char const * const name) noexcept
+		{
+			if(failures) fprintf(stderr, "%s: %u check(s) failed\n", name, failures);
+			else printf("%s: passed\n", name);
+
+			return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+		}
+	} // namespace Test
+} // namespace Peoplez
+
+/**
+ * @def PEOPLEZ_CHECK
+ * @brief Counts and reports a failed condition (the test goes on)
+ */
+#define PEOPLEZ_CHECK(condition) do { if(!(condition)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); ++Peoplez::Test::failures; } } while(0)
+
+#endif // PEOPLEZ_TEST_CHECK_HPP_
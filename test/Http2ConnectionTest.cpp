@@ -0,0 +1,341 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Tests of Services::Http::Http2Connection
+ *
+ * A client on the other end of a socket pair sends frames; the connection is driven by calling MessageReceivable.
+ */
+
+// Local includes
+#include "Check.hpp"
+#include "Peoplez/Services/Http/Hpack.hpp"
+#include "Peoplez/Services/Http/Http2Connection.hpp"
+#include "Peoplez/Services/Http/HttpContext.hpp"
+#include "Peoplez/Services/Http/HttpRequestHandler.hpp"
+#include "Peoplez/System/IO/Network/Socket.hpp"
+
+// Extern includes
+#include <cstring>
+#include <malloc.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+}
+
+using namespace Peoplez;
+using namespace Peoplez::Services::Http;
+using namespace Peoplez::String;
+
+namespace
+{
+	// Frame types and flags (RFC 7540 Section 6)
+	constexpr uint8_t DATA = 0, HEADERS = 1, RST_STREAM = 3, SETTINGS = 4, GOAWAY = 7;
+	constexpr uint8_t END_STREAM = 1, END_HEADERS = 4;
+
+	/**
+	 * Answers with the length of the request body
+	 */
+	class LengthHandler final : public HttpRequestHandler
+	{
+	public:
+		virtual void ProcessRequest(HttpContext & context) override
+		{
+			std::string const length = std::to_string(context.BodyBuffer.Length());
+			context.response.SetWithBody(HttpStatusCode::OK, PeoplezString(length.data(), length.length()));
+		}
+	};
+
+	/**
+	 * @brief Frame received by the client
+	 */
+	struct Frame
+	{
+		uint8_t type;
+		uint8_t flags;
+		uint32_t streamId;
+		std::string payload;
+	};
+
+	/**
+	 * Remembers the status of a response
+	 */
+	class StatusReader final : public HpackDecoder::HeaderHandler
+	{
+	public:
+		virtual void Header(PeoplezString const & name, PeoplezString const & value, HttpHeaderField) override
+		{
+			if(name.EqualTo(":status", 7)) status.assign(value.GetData(), value.Length());
+		}
+
+		std::string status;
+	};
+
+	/**
+	 * Client side of a connection
+	 */
+	class Client final
+	{
+	public:
+		explicit Client(HttpRequestHandler & handler)
+		{
+			int sockets[2];
+			socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+			fcntl(sockets[0], F_SETFL, O_NONBLOCK);
+			fcntl(sockets[1], F_SETFL, O_NONBLOCK);
+
+			peer = sockets[1];
+			connection = std::make_shared<Http2Connection>(handler, new System::IO::Network::Socket(sockets[0]));
+			connection->Start(PeoplezString());
+
+			std::string preface(Http2Connection::PREFACE, Http2Connection::PREFACE_LENGTH);
+			AppendFrame(preface, SETTINGS, 0, 0, std::string());
+			Send(preface);
+		}
+		~Client()
+		{
+			connection.reset();
+			close(peer);
+		}
+
+		static void AppendFrame(std::string & dest, uint8_t const type, uint8_t const flags, uint32_t const streamId, std::string const & payload)
+		{
+			char const header[9] = {(char)(payload.length() >> 16), (char)(payload.length() >> 8), (char)payload.length(), (char)type, (char)flags,
+					(char)(streamId >> 24), (char)(streamId >> 16), (char)(streamId >> 8), (char)streamId};
+
+			dest.append(header, sizeof(header));
+			dest += payload;
+		}
+
+		/**
+		 * Header block of a request
+		 *
+		 * @param fields Additional literal fields (name, value)
+		 */
+		static std::string Request(char const * const method, std::vector<std::pair<std::string, std::string> > const & fields = {}, bool const scheme = true)
+		{
+			PeoplezString block;
+			Hpack::AppendLiteral(block, PeoplezString(":method", 7), PeoplezString(method));
+			if(scheme) Hpack::AppendIndexed(block, 7);
+			Hpack::AppendIndexed(block, 4);
+			Hpack::AppendLiteral(block, 1, "localhost", 9);
+
+			for(std::pair<std::string, std::string> const & field : fields) Hpack::AppendLiteral(block, PeoplezString(field.first.data(), field.first.length()), PeoplezString(field.second.data(), field.second.length()));
+
+			return std::string(block.GetData(), block.Length());
+		}
+
+		/**
+		 * Writes to the connection and lets it process the data
+		 */
+		void Send(std::string const & data)
+		{
+			PEOPLEZ_CHECK(write(peer, data.data(), data.length()) == (ssize_t) data.length());
+			connection->MessageReceivable();
+			Receive();
+		}
+
+		/**
+		 * Reads everything the connection sent
+		 */
+		void Receive()
+		{
+			char buf[65536];
+			ssize_t bytes;
+
+			while((bytes = read(peer, buf, sizeof(buf))) > 0) input.append(buf, bytes);
+
+			while(input.length() >= 9)
+			{
+				unsigned char const * const header = (unsigned char const *) input.data();
+				size_t const length = ((size_t)header[0] << 16) | ((size_t)header[1] << 8) | header[2];
+
+				if(input.length() < 9 + length) break;
+
+				Frame const frame = {header[3], header[4], (uint32_t)((header[5] & 0x7F) << 24 | header[6] << 16 | header[7] << 8 | header[8]), input.substr(9, length)};
+				input.erase(0, 9 + length);
+
+				if(frame.type == GOAWAY) goAway = true;
+				else if(frame.type == RST_STREAM) resets[frame.streamId] = (uint32_t)((unsigned char)frame.payload[0] << 24 | (unsigned char)frame.payload[1] << 16 | (unsigned char)frame.payload[2] << 8 | (unsigned char)frame.payload[3]);
+				else if(frame.type == DATA) bodies[frame.streamId] += frame.payload;
+				else if(frame.type == HEADERS)
+				{
+					// The server sends complete header blocks without padding and priority
+					StatusReader reader;
+					PEOPLEZ_CHECK(decoder.Decode(PeoplezString(frame.payload.data(), frame.payload.length()), reader));
+					statuses[frame.streamId] = reader.status;
+				}
+
+				if((frame.type == HEADERS || frame.type == DATA) && frame.flags & END_STREAM) ++finished[frame.streamId];
+			}
+		}
+
+		std::shared_ptr<Http2Connection> connection;
+		int peer;
+		std::string input;
+		HpackDecoder decoder;
+		bool goAway = false;
+		std::map<uint32_t, uint32_t> resets;
+		std::map<uint32_t, std::string> bodies;
+		std::map<uint32_t, std::string> statuses;
+		std::map<uint32_t, unsigned int> finished;
+	};
+
+	/**
+	 * Requests with bodies arriving in pieces, so almost every read leaves a partial frame in the input buffer
+	 *
+	 * The consumed front of the input buffer must not leak when the rest of the frame is appended.
+	 */
+	void PartialFrames()
+	{
+		constexpr unsigned int REQUESTS = 4000;
+		constexpr size_t BODY_LENGTH = 8000;
+
+		LengthHandler handler;
+		Client client(handler);
+		std::string stream;
+
+		for(unsigned int i = 0; i < REQUESTS; ++i)
+		{
+			uint32_t const streamId = 2 * i + 1;
+			Client::AppendFrame(stream, HEADERS, END_HEADERS, streamId, Client::Request("PUT", {{"content-type", "application/octet-stream"}}));
+			Client::AppendFrame(stream, DATA, END_STREAM, streamId, std::string(BODY_LENGTH, 'x'));
+		}
+
+		size_t before = 0;
+		unsigned int answered = 0;
+
+		// Pieces much smaller than the frames, so the consumed frames stay in front of the partial ones
+		for(size_t pos = 0; pos < stream.length(); pos += 997)
+		{
+			// Measure after the buffers reached their size
+			if(!before && pos > stream.length() / 10) before = mallinfo2().uordblks;
+
+			client.Send(stream.substr(pos, 997));
+
+			// Check and forget the answered streams (keeps the memory of the client constant)
+			for(std::pair<uint32_t const, unsigned int> const & entry : client.finished)
+			{
+				PEOPLEZ_CHECK(client.statuses[entry.first] == "200");
+				PEOPLEZ_CHECK(client.bodies[entry.first] == std::to_string(BODY_LENGTH));
+				client.bodies.erase(entry.first);
+				client.statuses.erase(entry.first);
+				++answered;
+			}
+
+			client.finished.clear();
+		}
+
+		// Leaking the input buffer took up to 8K per frame
+		PEOPLEZ_CHECK(mallinfo2().uordblks < before + 256 * 1024);
+		PEOPLEZ_CHECK(!client.goAway);
+		PEOPLEZ_CHECK(client.resets.empty());
+		PEOPLEZ_CHECK(answered == REQUESTS);
+	}
+
+	/**
+	 * Responses to HEAD requests end with the header fields
+	 */
+	void Head()
+	{
+		LengthHandler handler;
+		Client client(handler);
+		std::string frames;
+
+		Client::AppendFrame(frames, HEADERS, END_HEADERS | END_STREAM, 1, Client::Request("HEAD"));
+		client.Send(frames);
+
+		PEOPLEZ_CHECK(client.finished[1] == 1);
+		PEOPLEZ_CHECK(client.statuses[1] == "200");
+		PEOPLEZ_CHECK(client.bodies.find(1) == client.bodies.end());
+		PEOPLEZ_CHECK(client.resets.empty());
+	}
+
+	/**
+	 * Malformed requests are reset with PROTOCOL_ERROR (RFC 7540 Section 8.1.2), the connection stays usable
+	 */
+	void MalformedRequests()
+	{
+		constexpr uint32_t PROTOCOL_ERROR = 1;
+
+		LengthHandler handler;
+		Client client(handler);
+		std::string frames;
+
+		// Without :scheme
+		Client::AppendFrame(frames, HEADERS, END_HEADERS | END_STREAM, 1, Client::Request("GET", {}, false));
+		// Upper case field name
+		Client::AppendFrame(frames, HEADERS, END_HEADERS | END_STREAM, 3, Client::Request("GET", {{"X-Custom", "1"}}));
+		// Less data than the content-length
+		Client::AppendFrame(frames, HEADERS, END_HEADERS, 5, Client::Request("PUT", {{"content-length", "10"}}));
+		Client::AppendFrame(frames, DATA, END_STREAM, 5, "data");
+		// More data than the content-length
+		Client::AppendFrame(frames, HEADERS, END_HEADERS, 7, Client::Request("PUT", {{"content-length", "4"}}));
+		Client::AppendFrame(frames, DATA, 0, 7, "more data");
+		// No data despite the content-length
+		Client::AppendFrame(frames, HEADERS, END_HEADERS | END_STREAM, 9, Client::Request("PUT", {{"content-length", "4"}}));
+		// Valid
+		Client::AppendFrame(frames, HEADERS, END_HEADERS, 11, Client::Request("PUT", {{"content-length", "4"}}));
+		Client::AppendFrame(frames, DATA, END_STREAM, 11, "data");
+		client.Send(frames);
+
+		for(uint32_t const streamId : {1, 3, 5, 7, 9})
+		{
+			PEOPLEZ_CHECK(client.resets[streamId] == PROTOCOL_ERROR);
+			PEOPLEZ_CHECK(client.statuses.find(streamId) == client.statuses.end());
+		}
+
+		PEOPLEZ_CHECK(client.resets.find(11) == client.resets.end());
+		PEOPLEZ_CHECK(client.statuses[11] == "200");
+		PEOPLEZ_CHECK(client.bodies[11] == "4");
+		PEOPLEZ_CHECK(!client.goAway);
+	}
+} // namespace
+
+int main()
+{
+	PartialFrames();
+	Head();
+	MalformedRequests();
+
+	return Test::Result("Http2ConnectionTest");
+}
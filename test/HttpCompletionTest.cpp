@@ -0,0 +1,191 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Tests of Services::Http::HttpCompletion
+ */
+
+// Local includes
+#include "Check.hpp"
+#include "Peoplez/General/Patterns/Factory.hpp"
+#include "Peoplez/Services/Http/HttpClientInfo.hpp"
+#include "Peoplez/Services/Http/HttpContext.hpp"
+#include "Peoplez/Services/Http/HttpRequestHandler.hpp"
+#include "Peoplez/Services/Http/HttpResponseStream.hpp"
+#include "Peoplez/System/IO/Network/ConnectionsManager.hpp"
+
+// Extern includes
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+extern "C"
+{
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+}
+
+using namespace Peoplez;
+using namespace Peoplez::Services::Http;
+using namespace Peoplez::String;
+
+namespace
+{
+	/**
+	 * Body that remembers the thread serializing the response
+	 */
+	class ThreadBody final : public HttpResponseStream
+	{
+	public:
+		virtual HttpResponseStreamStatus NextChunk(HttpContext &, PeoplezString & chunk) override
+		{
+			thread = std::this_thread::get_id();
+			scheduler = General::Scheduler::Current();
+			chunk = PeoplezString("done", 4);
+
+			return HttpResponseStreamStatus::END;
+		}
+
+		std::atomic<std::thread::id> thread;
+		std::atomic<General::Scheduler *> scheduler = nullptr;
+	};
+
+	/**
+	 * Defers every response and hands the token out
+	 */
+	class DeferringHandler final : public HttpRequestHandler
+	{
+	public:
+		virtual void ProcessRequest(HttpContext & context) override
+		{
+			std::lock_guard<std::mutex> const lock(mutex);
+			completion = context.Defer();
+		}
+
+		HttpCompletion Take()
+		{
+			std::lock_guard<std::mutex> const lock(mutex);
+			return std::move(completion);
+		}
+
+		std::mutex mutex;
+		HttpCompletion completion;
+	};
+
+	/**
+	 * Reads from a socket until the data contain the given text (or a timeout)
+	 */
+	std::string ReadUntil(int const fd, char const * const text)
+	{
+		std::string received;
+		char buf[4096];
+
+		while(received.find(text) == std::string::npos)
+		{
+			pollfd poller = {fd, POLLIN, 0};
+			if(poll(&poller, 1, 5000) <= 0) break;
+
+			ssize_t const bytes = read(fd, buf, sizeof(buf));
+			if(bytes <= 0) break;
+
+			received.append(buf, bytes);
+		}
+
+		return received;
+	}
+
+	/**
+	 * Completes a deferred response from a thread that does not belong to the ConnectionsManager
+	 *
+	 * The response has to be sent by a worker thread of the connection, not by the completing thread.
+	 */
+	void CompleteFromForeignThread()
+	{
+		General::Patterns::Factory factory;
+		System::IO::Network::ConnectionsManager manager(factory, 2);
+		DeferringHandler handler;
+
+		int sockets[2];
+		socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+		System::IO::Network::ConnectionsManager::MakeSocketNonBlocking(sockets[0]);
+		manager.Add(new HttpClientInfo(sockets[0], handler, new System::IO::Network::Socket(sockets[0])));
+
+		char const request[] = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+		PEOPLEZ_CHECK(write(sockets[1], request, sizeof(request) - 1) == sizeof(request) - 1);
+
+		// Wait for the deferred request
+		HttpCompletion completion;
+		for(int i = 0; i < 500 && !completion.IsValid(); ++i)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			completion = handler.Take();
+		}
+
+		PEOPLEZ_CHECK(completion.IsValid());
+		if(!completion.IsValid()) return;
+
+		std::shared_ptr<ThreadBody> const body = std::make_shared<ThreadBody>();
+		std::thread::id completing;
+
+		std::thread([&]()
+		{
+			completing = std::this_thread::get_id();
+
+			completion.Context().response.SetStream(HttpStatusCode::OK, PeoplezString("text/plain", 10), body);
+			completion.Complete();
+		}).join();
+
+		std::string const response = ReadUntil(sockets[1], "done");
+
+		PEOPLEZ_CHECK(response.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+		PEOPLEZ_CHECK(response.find("done") != std::string::npos);
+		PEOPLEZ_CHECK(body->thread.load() != completing);
+		PEOPLEZ_CHECK(body->scheduler.load() == &manager);
+
+		close(sockets[1]);
+	}
+} // namespace
+
+int main()
+{
+	CompleteFromForeignThread();
+
+	return Test::Result("HttpCompletionTest");
+}
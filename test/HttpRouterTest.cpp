@@ -0,0 +1,154 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Tests of Services::Http::HttpRouter behind an http/1.1 connection
+ */
+
+// Local includes
+#include "Check.hpp"
+#include "Peoplez/Services/Http/HttpClientInfo.hpp"
+#include "Peoplez/Services/Http/HttpContext.hpp"
+#include "Peoplez/Services/Http/HttpRouter.hpp"
+#include "Peoplez/System/IO/Network/Socket.hpp"
+
+// Extern includes
+#include <memory>
+#include <string>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+}
+
+using namespace Peoplez;
+using namespace Peoplez::Services::Http;
+using namespace Peoplez::String;
+
+namespace
+{
+	/**
+	 * Answers with a fixed body
+	 */
+	class TextHandler final : public HttpRequestHandler
+	{
+	public:
+		explicit TextHandler(char const * const text) : text(text) {}
+
+		virtual void ProcessRequest(HttpContext & context) override
+		{
+			context.response.SetWithBody(HttpStatusCode::OK, PeoplezString(text));
+		}
+
+		char const * const text;
+	};
+
+	/**
+	 * Sends one http/1.1 request through a connection and returns everything it answered
+	 */
+	std::string Exchange(HttpRequestHandler & handler, std::string const & request)
+	{
+		int sockets[2];
+		socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+		fcntl(sockets[0], F_SETFL, O_NONBLOCK);
+		fcntl(sockets[1], F_SETFL, O_NONBLOCK);
+
+		std::unique_ptr<System::IO::Network::ClientInfo> const client(new HttpClientInfo(sockets[0], handler, new System::IO::Network::Socket(sockets[0])));
+
+		PEOPLEZ_CHECK(write(sockets[1], request.data(), request.length()) == (ssize_t) request.length());
+		client->MessageReceivableCB();
+
+		std::string response;
+		char buf[4096];
+		ssize_t bytes;
+
+		while((bytes = read(sockets[1], buf, sizeof(buf))) > 0) response.append(buf, bytes);
+
+		close(sockets[1]);
+
+		return response;
+	}
+
+	/**
+	 * Methods other than GET, POST and PUT reach the router; HEAD is answered by the GET handler without body
+	 */
+	void Methods()
+	{
+		HttpRouter router;
+		router.AddRoute(HttpMethods::GET, "/items/:id", std::make_shared<TextHandler>("item"));
+		router.AddRoute(HttpMethods::DELETE, "/items/:id", std::make_shared<TextHandler>("deleted"));
+
+		std::string const head = Exchange(router, "HEAD /items/1 HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		PEOPLEZ_CHECK(head.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+		PEOPLEZ_CHECK(head.find("Content-Length: 4\r\n") != std::string::npos);
+		PEOPLEZ_CHECK(head.length() >= 4 && head.compare(head.length() - 4, 4, "\r\n\r\n") == 0);
+
+		std::string const remove = Exchange(router, "DELETE /items/1 HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		PEOPLEZ_CHECK(remove.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+		PEOPLEZ_CHECK(remove.length() >= 7 && remove.compare(remove.length() - 7, 7, "deleted") == 0);
+
+		std::string const options = Exchange(router, "OPTIONS /items/1 HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		PEOPLEZ_CHECK(options.compare(0, 12, "HTTP/1.1 405") == 0);
+		PEOPLEZ_CHECK(options.find("Allow: GET, HEAD, DELETE\r\n") != std::string::npos);
+
+		std::string const unknown = Exchange(router, "BREW /items/1 HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		PEOPLEZ_CHECK(unknown.compare(0, 12, "HTTP/1.1 501") == 0);
+	}
+
+	/**
+	 * Only HTTP/1.1 clients get a 100 Continue before they send the body (RFC 9110 Section 10.1.1)
+	 */
+	void ExpectContinue()
+	{
+		HttpRouter router;
+		router.AddRoute(HttpMethods::POST, "/items/:id", std::make_shared<TextHandler>("stored"));
+
+		std::string const http11 = Exchange(router, "POST /items/1 HTTP/1.1\r\nHost: localhost\r\nContent-Length: 4\r\nExpect: 100-continue\r\n\r\n");
+		PEOPLEZ_CHECK(http11 == "HTTP/1.1 100 Continue\r\n\r\n");
+
+		std::string const http10 = Exchange(router, "POST /items/1 HTTP/1.0\r\nHost: localhost\r\nContent-Length: 4\r\nExpect: 100-continue\r\n\r\n");
+		PEOPLEZ_CHECK(http10.empty());
+	}
+} // namespace
+
+int main()
+{
+	Methods();
+	ExpectContinue();
+
+	return Test::Result("HttpRouterTest");
+}
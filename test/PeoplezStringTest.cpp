@@ -0,0 +1,111 @@
+/**
+ * Copyright 2026 Christian Geldermann
+ *
+ * This file is part of PeoplezServerLib.
+ *
+ * PeoplezServerLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PeoplezServerLib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PeoplezServerLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Diese Datei ist Teil von PeoplezServerLib.
+ *
+ * PeoplezServerLib ist Freie Software: Sie können es unter den Bedingungen
+ * der GNU General Public License, wie von der Free Software Foundation,
+ * Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+ * veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+ *
+ * PeoplezServerLib wird in der Hoffnung, dass es nützlich sein wird, aber
+ * OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+ * Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+ * Siehe die GNU General Public License für weitere Details.
+ *
+ * Sie sollten eine Kopie der GNU General Public License zusammen mit
+ * PeoplezServerLib erhalten haben. Wenn nicht, siehe
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Tests of String::PeoplezString
+ */
+
+// Local includes
+#include "Check.hpp"
+#include "Peoplez/String/PeoplezString.hpp"
+
+// Extern includes
+#include <cstring>
+#include <malloc.h>
+#include <string>
+
+using namespace Peoplez;
+using namespace Peoplez::String;
+
+namespace
+{
+	/**
+	 * Consuming the front with operator <<= and appending afterwards (input buffers of connections)
+	 *
+	 * The unique buffer has to be reused: the data is moved to the front instead of allocating a new buffer.
+	 */
+	void ConsumeAndAppend()
+	{
+		std::string const block(16384, 'x');
+		PeoplezString buffer;
+
+		// Warm up (the buffer reaches its size)
+		for(int i = 0; i < 10; ++i)
+		{
+			buffer.Append(block.data(), block.length());
+			buffer <<= buffer.Length() - 100;
+			buffer.Append("0123456789", 10);
+		}
+
+		size_t const before = mallinfo2().uordblks;
+
+		for(int i = 0; i < 20000; ++i)
+		{
+			buffer.Append(block.data(), block.length());
+			buffer <<= buffer.Length() - 100;
+			buffer.Append("0123456789", 10);
+		}
+
+		// Leaking the buffer took 16K per round
+		PEOPLEZ_CHECK(mallinfo2().uordblks < before + 1024 * 1024);
+		PEOPLEZ_CHECK(buffer.Unique());
+		PEOPLEZ_CHECK(buffer.Length() == 110);
+		PEOPLEZ_CHECK(!memcmp(buffer.GetData() + 90, "xxxxxxxxxx0123456789", 20));
+	}
+
+	/**
+	 * Appending to a shifted string whose data is shared must not change the other string
+	 */
+	void ConsumeAndAppendShared()
+	{
+		PeoplezString buffer("Hello World", 11);
+		buffer <<= 6;
+
+		PeoplezString const copy(buffer);
+		buffer.Append("!", 1);
+
+		PEOPLEZ_CHECK(buffer == PeoplezString("World!", 6));
+		PEOPLEZ_CHECK(copy == PeoplezString("World", 5));
+		PEOPLEZ_CHECK(buffer.Unique());
+	}
+} // namespace
+
+int main()
+{
+	ConsumeAndAppend();
+	ConsumeAndAppendShared();
+
+	return Test::Result("PeoplezStringTest");
+}